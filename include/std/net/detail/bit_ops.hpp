@@ -0,0 +1,92 @@
+//
+// detail/bit_ops.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_BIT_OPS_HPP
+#define STDNET_DETAIL_BIT_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace bit_ops {
+
+// Returns the number of set bits.
+inline unsigned popcount(unsigned long long value)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_popcountll(value));
+#else // defined(__GNUC__)
+  value = value - ((value >> 1) & 0x5555555555555555ULL);
+  value = (value & 0x3333333333333333ULL)
+    + ((value >> 2) & 0x3333333333333333ULL);
+  value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return static_cast<unsigned>((value * 0x0101010101010101ULL) >> 56);
+#endif // defined(__GNUC__)
+}
+
+// Returns the index of the lowest set bit. The value must not be zero.
+inline unsigned lowest_bit(unsigned long long value)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_ctzll(value));
+#else // defined(__GNUC__)
+  unsigned index = 0;
+  while ((value & 1) == 0)
+    value >>= 1, ++index;
+  return index;
+#endif // defined(__GNUC__)
+}
+
+// Returns the number of leading one bits. Usable in constant expressions.
+inline STDNET_CONSTEXPR unsigned count_leading_ones(unsigned long long value)
+{
+#if defined(__GNUC__)
+  return ~value == 0 ? 64u
+    : static_cast<unsigned>(__builtin_clzll(~value));
+#else // defined(__GNUC__)
+  return (value & 0x8000000000000000ULL) == 0 ? 0u
+    : 1u + count_leading_ones(value << 1);
+#endif // defined(__GNUC__)
+}
+
+// Hashes a 128-bit value, given as its upper and lower 64-bit words. The
+// words are combined with a multiply, and the murmur3 finalizer then carries
+// every input bit into the low bits of the result, which are all that a table
+// with a power-of-two number of buckets uses.
+inline std::size_t hash_128(unsigned long long high,
+    unsigned long long low) STDNET_NOEXCEPT
+{
+  unsigned long long h = high * 0x9e3779b97f4a7c15ULL + low;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<std::size_t>(h);
+}
+
+} // namespace bit_ops
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_BIT_OPS_HPP
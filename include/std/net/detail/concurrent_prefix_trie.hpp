@@ -0,0 +1,299 @@
+//
+// detail/concurrent_prefix_trie.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_CONCURRENT_PREFIX_TRIE_HPP
+#define STDNET_DETAIL_CONCURRENT_PREFIX_TRIE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/epoch_domain.hpp"
+#include "std/net/detail/prefetch.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// A longest-prefix-match trie that one writer updates while any number of
+// readers look up keys. Keys are up to 128 bits, given as two 64-bit words
+// with the most significant first.
+//
+// Each node consumes 6 bits of the key and is immutable once published. It
+// holds a bitmap of its children that are nodes, and a value for each of its
+// 64 children, being that of the longest prefix that ends within the node and
+// contains the child, or no_value. Values are run-length compressed with a
+// second bitmap marking where runs start, and children and values are found
+// by counting the set bits below a position, as in a poptrie. A lookup
+// remembers the last value it passed, so that a prefix is held only in the
+// node where it ends and a change to it affects a single node.
+//
+// The writer copies the nodes on the path from the root to the node that
+// holds a changed prefix, publishes the new root, and retires the replaced
+// nodes to an epoch domain. Readers never wait.
+class concurrent_prefix_trie
+{
+public:
+  typedef std::uint32_t value_type;
+
+  static const value_type no_value = 0xFFFFFFFF;
+
+  // The largest number of keys that a reader looks up together.
+  static const std::size_t group_size = 32;
+
+  // Each node is allocated with its child pointers and then its values
+  // following it.
+  struct node
+  {
+    // Bit i is set if child i is a node.
+    unsigned long long vector;
+
+    // Bit i is set if the value of child i starts a run of equal values.
+    unsigned long long leafvec;
+  };
+
+  // A reader's handle on the trie. Each thread that reads needs its own.
+  class reader
+  {
+  public:
+    explicit reader(const concurrent_prefix_trie& trie)
+      : trie_(trie),
+        slot_(trie.domain_.acquire_slot()),
+        root_(0)
+    {
+    }
+
+    ~reader()
+    {
+      trie_.domain_.release_slot(slot_);
+    }
+
+    // Starts a sequence of lookups, which all see the same version of the
+    // trie.
+    void enter() const STDNET_NOEXCEPT
+    {
+      trie_.domain_.enter(slot_);
+      root_ = trie_.root_.load(std::memory_order_seq_cst);
+    }
+
+    // Ends a sequence of lookups.
+    void leave() const STDNET_NOEXCEPT
+    {
+      root_ = 0;
+      epoch_domain::leave(slot_);
+    }
+
+    // Finds the value of the longest prefix that contains a key. Must be
+    // called between enter() and leave().
+    value_type find(unsigned long long high,
+        unsigned long long low) const STDNET_NOEXCEPT
+    {
+      value_type best = no_value;
+      unsigned int offset = 0;
+      for (const node* n = root_; n; offset += stride)
+      {
+        const unsigned int c = chunk(high, low, offset);
+        const unsigned long long below = (2ULL << c) - 1;
+        const value_type v = node_values(n)[
+          bit_ops::popcount(n->leafvec & below) - 1];
+        if (v != no_value)
+          best = v;
+        if (!(n->vector & (1ULL << c)))
+          break;
+        n = node_children(n)[bit_ops::popcount(n->vector & below) - 1];
+      }
+      return best;
+    }
+
+    // Finds the values of the longest prefixes that contain each of a group
+    // of at most group_size keys. The keys descend the trie together, and the
+    // next node for each is prefetched, so that their memory accesses are in
+    // flight at once. Must be called between enter() and leave().
+    void find(const unsigned long long* high, const unsigned long long* low,
+        std::size_t count, value_type* values) const STDNET_NOEXCEPT
+    {
+      const node* nodes[group_size];
+      std::size_t positions[group_size];
+      std::size_t active = 0;
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        values[i] = no_value;
+        if (root_)
+        {
+          nodes[active] = root_;
+          positions[active++] = i;
+        }
+      }
+
+      for (unsigned int offset = 0; active > 0; offset += stride)
+      {
+        std::size_t remaining = 0;
+        for (std::size_t j = 0; j < active; ++j)
+        {
+          const node* n = nodes[j];
+          const std::size_t i = positions[j];
+          const unsigned int c = chunk(high[i], low[i], offset);
+          const unsigned long long below = (2ULL << c) - 1;
+          const value_type v = node_values(n)[
+            bit_ops::popcount(n->leafvec & below) - 1];
+          if (v != no_value)
+            values[i] = v;
+          if (n->vector & (1ULL << c))
+          {
+            n = node_children(n)[bit_ops::popcount(n->vector & below) - 1];
+            prefetch(n);
+            nodes[remaining] = n;
+            positions[remaining++] = i;
+          }
+        }
+        active = remaining;
+      }
+    }
+
+  private:
+    reader(const reader&) STDNET_DELETED;
+    reader& operator=(const reader&) STDNET_DELETED;
+
+    const concurrent_prefix_trie& trie_;
+    epoch_domain::slot* slot_;
+    mutable const node* root_;
+  };
+
+  // Constructs an empty trie for keys of the given length in bits.
+  STDNET_DECL explicit concurrent_prefix_trie(unsigned int max_length);
+
+  // Frees the trie. There must be no readers.
+  STDNET_DECL ~concurrent_prefix_trie();
+
+  // Adds a prefix, or replaces the value of an existing prefix. Bits of the
+  // key beyond the prefix length are ignored.
+  STDNET_DECL void insert(unsigned long long high, unsigned long long low,
+      unsigned int length, value_type value);
+
+  // Removes a prefix, returning false if it was not in the trie. Bits of the
+  // key beyond the prefix length are ignored.
+  STDNET_DECL bool erase(unsigned long long high, unsigned long long low,
+      unsigned int length);
+
+  // Removes all prefixes.
+  STDNET_DECL void clear();
+
+  // Gets the number of prefixes.
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return prefixes_.size();
+  }
+
+private:
+  concurrent_prefix_trie(const concurrent_prefix_trie&) STDNET_DELETED;
+  concurrent_prefix_trie& operator=(
+      const concurrent_prefix_trie&) STDNET_DELETED;
+
+  // The number of key bits consumed by each node, and the greatest number of
+  // nodes on a path.
+  static const unsigned int stride = 6;
+  static const unsigned int max_depth = 128 / stride + 1;
+
+  struct prefix_key
+  {
+    unsigned long long high;
+    unsigned long long low;
+    unsigned int length;
+
+    friend bool operator<(const prefix_key& a, const prefix_key& b)
+    {
+      if (a.high != b.high)
+        return a.high < b.high;
+      if (a.low != b.low)
+        return a.low < b.low;
+      return a.length < b.length;
+    }
+  };
+
+  typedef std::map<prefix_key, value_type> prefix_map;
+
+  static node* const* node_children(const node* n) STDNET_NOEXCEPT
+  {
+    return reinterpret_cast<node* const*>(n + 1);
+  }
+
+  static const value_type* node_values(const node* n) STDNET_NOEXCEPT
+  {
+    return reinterpret_cast<const value_type*>(
+        node_children(n) + bit_ops::popcount(n->vector));
+  }
+
+  // Gets the 6 bits of a key that start at the given offset.
+  static unsigned int chunk(unsigned long long high,
+      unsigned long long low, unsigned int offset) STDNET_NOEXCEPT
+  {
+    const unsigned long long bits = offset == 0 ? high
+      : offset < 64 ? (high << offset) | (low >> (64 - offset))
+      : low << (offset - 64);
+    return static_cast<unsigned int>(bits >> 58);
+  }
+
+  // Rebuilds the path to the node that holds a prefix, after the prefix has
+  // been added, removed or changed, and publishes it.
+  STDNET_DECL void update(const prefix_key& key);
+
+  // Updates the values of the children of the node that holds a prefix, from
+  // the prefixes that end within the node.
+  STDNET_DECL void find_values(const prefix_key& key, unsigned int offset,
+      value_type* values) const;
+
+  // Allocates a node with the given children and values, or returns null if
+  // it would have neither.
+  STDNET_DECL static node* make_node(node* const* children,
+      const value_type* values);
+
+  // Expands the children and values of a node, which may be null.
+  STDNET_DECL static void expand_node(const node* n,
+      node** children, value_type* values);
+
+  // Frees a node, or a node and every node below it.
+  STDNET_DECL static void destroy_node(void* n);
+  STDNET_DECL static void destroy_trie(const node* n);
+
+  // Retires a node and every node below it.
+  STDNET_DECL void retire_trie(const node* n);
+
+  unsigned int max_length_;
+  std::atomic<const node*> root_;
+  mutable epoch_domain domain_;
+  prefix_map prefixes_;
+};
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/detail/impl/concurrent_prefix_trie.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_DETAIL_CONCURRENT_PREFIX_TRIE_HPP
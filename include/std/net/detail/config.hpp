@@ -254,6 +254,19 @@
 # endif // !defined(STDNET_DISABLE_STD_ATOMIC)
 #endif // !defined(STDNET_HAS_STD_ATOMIC)
 
+// Standard library support for threads.
+#if !defined(STDNET_HAS_STD_THREAD)
+# if !defined(STDNET_DISABLE_STD_THREAD)
+#  if defined(__GNUC__)
+#   if ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 5)) || (__GNUC__ > 4)
+#    if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#     define STDNET_HAS_STD_THREAD 1
+#    endif // defined(__GXX_EXPERIMENTAL_CXX0X__)
+#   endif // ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 5)) || (__GNUC__ > 4)
+#  endif // defined(__GNUC__)
+# endif // !defined(STDNET_DISABLE_STD_THREAD)
+#endif // !defined(STDNET_HAS_STD_THREAD)
+
 // Standard library support for chrono. Some standard libraries (such as the
 // libstdc++ shipped with gcc 4.6) provide monotonic_clock as per early C++0x
 // drafts, rather than the eventually standardised name of steady_clock.
@@ -311,6 +324,28 @@
 # endif // !defined(STDNET_DISABLE_STD_TYPE_TRAITS)
 #endif // !defined(STDNET_HAS_STD_TYPE_TRAITS)
 
+// Standard library support for std::is_trivially_copyable. The trait is missing
+// from libstdc++ before gcc 5, including when it is used by clang.
+#if !defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+# if !defined(STDNET_DISABLE_STD_IS_TRIVIALLY_COPYABLE)
+#  if defined(__GNUC__) && !defined(__clang__)
+#   if (__GNUC__ >= 5)
+#    if defined(__GXX_EXPERIMENTAL_CXX0X__)
+#     define STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE 1
+#    endif // defined(__GXX_EXPERIMENTAL_CXX0X__)
+#   endif // (__GNUC__ >= 5)
+#  endif // defined(__GNUC__) && !defined(__clang__)
+#  if defined(__clang__) && (__cplusplus >= 201402L)
+#   define STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE 1
+#  endif // defined(__clang__) && (__cplusplus >= 201402L)
+#  if defined(STDNET_MSVC)
+#   if (_MSC_VER >= 1900)
+#    define STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE 1
+#   endif // (_MSC_VER >= 1900)
+#  endif // defined(STDNET_MSVC)
+# endif // !defined(STDNET_DISABLE_STD_IS_TRIVIALLY_COPYABLE)
+#endif // !defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+
 // Standard library support for the cstdint header.
 #if !defined(STDNET_HAS_CSTDINT)
 # if !defined(STDNET_DISABLE_CSTDINT)
@@ -324,6 +359,38 @@
 # endif // !defined(STDNET_DISABLE_CSTDINT)
 #endif // !defined(STDNET_HAS_CSTDINT)
 
+// Standard library support for string_view.
+#if !defined(STDNET_HAS_STD_STRING_VIEW)
+# if !defined(STDNET_DISABLE_STD_STRING_VIEW)
+#  if defined(__cplusplus) && (__cplusplus >= 201703L)
+#   if defined(__has_include)
+#    if __has_include(<string_view>)
+#     define STDNET_HAS_STD_STRING_VIEW 1
+#    endif // __has_include(<string_view>)
+#   endif // defined(__has_include)
+#  endif // defined(__cplusplus) && (__cplusplus >= 201703L)
+#  if defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+#   define STDNET_HAS_STD_STRING_VIEW 1
+#  endif // defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L)
+# endif // !defined(STDNET_DISABLE_STD_STRING_VIEW)
+#endif // !defined(STDNET_HAS_STD_STRING_VIEW)
+
+// Standard library support for expected.
+#if !defined(STDNET_HAS_STD_EXPECTED)
+# if !defined(STDNET_DISABLE_STD_EXPECTED)
+#  if defined(__cplusplus) && (__cplusplus > 202002L)
+#   if defined(__has_include)
+#    if __has_include(<expected>)
+#     define STDNET_HAS_STD_EXPECTED 1
+#    endif // __has_include(<expected>)
+#   endif // defined(__has_include)
+#  endif // defined(__cplusplus) && (__cplusplus > 202002L)
+#  if defined(_MSVC_LANG) && (_MSVC_LANG > 202002L)
+#   define STDNET_HAS_STD_EXPECTED 1
+#  endif // defined(_MSVC_LANG) && (_MSVC_LANG > 202002L)
+# endif // !defined(STDNET_DISABLE_STD_EXPECTED)
+#endif // !defined(STDNET_HAS_STD_EXPECTED)
+
 // Windows target.
 #if !defined(STDNET_WINDOWS)
 # if defined(WIN32) || defined(_WIN32) || defined(__WIN32__)
@@ -547,15 +614,33 @@
 # endif // !defined(STDNET_DISABLE_SIGNAL)
 #endif // !defined(STDNET_HAS_SIGNAL)
 
+// Process-wide cache of interface indexes and names, used for IPv6 zone IDs.
+#if !defined(STDNET_HAS_INTERFACE_CACHE)
+# if !defined(STDNET_DISABLE_INTERFACE_CACHE)
+#  if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+#   if defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_CHRONO)
+#    define STDNET_HAS_INTERFACE_CACHE 1
+#   endif // defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_CHRONO)
+#  endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(STDNET_DISABLE_INTERFACE_CACHE)
+#endif // !defined(STDNET_HAS_INTERFACE_CACHE)
+
 // Whether standard iostreams are disabled.
 //#if !defined(STDNET_NO_IOSTREAM)
 //# define STDNET_NO_IOSTREAM 1
 //#endif // !defined(STDNET_NO_IOSTREAM)
 
-// Whether exception handling is disabled.
-//#if !defined(STDNET_NO_EXCEPTIONS)
-//# define STDNET_NO_EXCEPTIONS 1
-//#endif // !defined(STDNET_NO_EXCEPTIONS)
+// Whether exception handling is disabled. This is detected for compilers that
+// report it. When it is, the application must provide a definition of
+// detail::throw_exception, which must not return.
+#if !defined(STDNET_NO_EXCEPTIONS)
+# if defined(__GNUC__) && !defined(__EXCEPTIONS)
+#  define STDNET_NO_EXCEPTIONS 1
+# endif // defined(__GNUC__) && !defined(__EXCEPTIONS)
+# if defined(_MSC_VER) && !defined(_CPPUNWIND)
+#  define STDNET_NO_EXCEPTIONS 1
+# endif // defined(_MSC_VER) && !defined(_CPPUNWIND)
+#endif // !defined(STDNET_NO_EXCEPTIONS)
 
 // Whether the typeid operator is supported.
 //#if !defined(STDNET_NO_TYPEID)
@@ -663,4 +748,59 @@
         //   || (defined(__MACH__) && defined(__APPLE__))
 #endif // !defined(STDNET_DISABLE_SSIZE_T)
 
+// SSE4.1 instructions, used to accelerate address text conversions.
+#if !defined(STDNET_HAS_SSE41)
+# if !defined(STDNET_DISABLE_SSE41)
+#  if defined(__SSE4_1__)
+#   define STDNET_HAS_SSE41 1
+#  endif // defined(__SSE4_1__)
+# endif // !defined(STDNET_DISABLE_SSE41)
+#endif // !defined(STDNET_HAS_SSE41)
+
+// AVX2 instructions, used to find the delimiters in 32 characters of text at a
+// time when parsing addresses in bulk.
+#if !defined(STDNET_HAS_AVX2)
+# if !defined(STDNET_DISABLE_AVX2)
+#  if defined(__AVX2__) && defined(STDNET_HAS_SSE41)
+#   define STDNET_HAS_AVX2 1
+#  endif // defined(__AVX2__) && defined(STDNET_HAS_SSE41)
+# endif // !defined(STDNET_DISABLE_AVX2)
+#endif // !defined(STDNET_HAS_AVX2)
+
+// Compiler support for 128-bit integers, used to compare IPv6 addresses.
+#if !defined(STDNET_HAS_INT128)
+# if !defined(STDNET_DISABLE_INT128)
+#  if defined(__SIZEOF_INT128__)
+#   define STDNET_HAS_INT128 1
+#  endif // defined(__SIZEOF_INT128__)
+# endif // !defined(STDNET_DISABLE_INT128)
+#endif // !defined(STDNET_HAS_INT128)
+
+// Compiler support for software prefetch, used by batched table lookups.
+#if !defined(STDNET_HAS_BUILTIN_PREFETCH)
+# if !defined(STDNET_DISABLE_BUILTIN_PREFETCH)
+#  if defined(__GNUC__) || defined(__clang__)
+#   define STDNET_HAS_BUILTIN_PREFETCH 1
+#  endif // defined(__GNUC__) || defined(__clang__)
+# endif // !defined(STDNET_DISABLE_BUILTIN_PREFETCH)
+#endif // !defined(STDNET_HAS_BUILTIN_PREFETCH)
+
+// Transparent huge pages, used for large lookup tables.
+#if !defined(STDNET_HAS_MADV_HUGEPAGE)
+# if !defined(STDNET_DISABLE_MADV_HUGEPAGE)
+#  if defined(__linux__)
+#   define STDNET_HAS_MADV_HUGEPAGE 1
+#  endif // defined(__linux__)
+# endif // !defined(STDNET_DISABLE_MADV_HUGEPAGE)
+#endif // !defined(STDNET_HAS_MADV_HUGEPAGE)
+
+// Memory-mapped files, used to load files of addresses without copying them.
+#if !defined(STDNET_HAS_MMAP)
+# if !defined(STDNET_DISABLE_MMAP)
+#  if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+#   define STDNET_HAS_MMAP 1
+#  endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+# endif // !defined(STDNET_DISABLE_MMAP)
+#endif // !defined(STDNET_HAS_MMAP)
+
 #endif // STDNET_DETAIL_CONFIG_HPP
@@ -0,0 +1,129 @@
+//
+// detail/epoch_domain.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_EPOCH_DOMAIN_HPP
+#define STDNET_DETAIL_EPOCH_DOMAIN_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// Epoch-based reclamation for a structure with one writer and any number of
+// readers. Each reader owns a slot, in which it records the global epoch for
+// the duration of each read and zero otherwise. The writer publishes a new
+// version of the structure, retires the memory that only old versions use,
+// and then advances the epoch. Retired memory is freed once no slot holds an
+// epoch at or before the one in which it was retired, as any reader that
+// started later must have seen the new version.
+//
+// Entering and leaving a read takes a fixed number of steps and never waits
+// for the writer, so reads are wait-free. Slots are allocated on first use
+// and reused after they are released, and are padded so that readers on
+// different cores do not share cache lines.
+class epoch_domain
+{
+public:
+  class slot
+  {
+  private:
+    friend class epoch_domain;
+
+    char pad0_[64];
+    std::atomic<unsigned long long> epoch_;
+    std::atomic<bool> in_use_;
+    std::atomic<slot*> next_;
+    char pad1_[64];
+  };
+
+  STDNET_DECL epoch_domain();
+
+  // Frees all retired memory and all slots. There must be no readers.
+  STDNET_DECL ~epoch_domain();
+
+  // Claims a slot for a reader. Lock-free.
+  STDNET_DECL slot* acquire_slot();
+
+  // Returns a slot claimed with acquire_slot(). The reader must not be inside
+  // a read.
+  STDNET_DECL void release_slot(slot* s) STDNET_NOEXCEPT;
+
+  // Starts a read. The structure must be loaded after this, with a load that
+  // is sequentially consistent.
+  void enter(slot* s) const STDNET_NOEXCEPT
+  {
+    s->epoch_.store(epoch_.load(std::memory_order_acquire),
+        std::memory_order_seq_cst);
+  }
+
+  // Ends a read.
+  static void leave(slot* s) STDNET_NOEXCEPT
+  {
+    s->epoch_.store(0, std::memory_order_release);
+  }
+
+  // Schedules memory that the current version of the structure no longer
+  // uses to be freed. Called by the writer after the new version has been
+  // published with a store that is sequentially consistent.
+  STDNET_DECL void retire(void* p, void (*destroy)(void*));
+
+  // Advances the epoch and frees the retired memory that no reader can still
+  // be using. Called by the writer.
+  STDNET_DECL void reclaim();
+
+private:
+  epoch_domain(const epoch_domain&) STDNET_DELETED;
+  epoch_domain& operator=(const epoch_domain&) STDNET_DELETED;
+
+  struct retired
+  {
+    void* pointer;
+    void (*destroy)(void*);
+    unsigned long long epoch;
+  };
+
+  // The global epoch. Starts at 1, so that 0 can mark an idle slot.
+  std::atomic<unsigned long long> epoch_;
+
+  // The slots, most recently allocated first.
+  std::atomic<slot*> slots_;
+
+  // The retired memory, oldest first. Only used by the writer.
+  std::vector<retired> retired_;
+};
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/detail/impl/epoch_domain.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_DETAIL_EPOCH_DOMAIN_HPP
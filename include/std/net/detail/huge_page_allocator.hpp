@@ -0,0 +1,118 @@
+//
+// detail/huge_page_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_HUGE_PAGE_ALLOCATOR_HPP
+#define STDNET_DETAIL_HUGE_PAGE_ALLOCATOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "std/net/detail/throw_exception.hpp"
+
+#if defined(STDNET_HAS_MADV_HUGEPAGE)
+# include <stdlib.h>
+# include <sys/mman.h>
+#endif // defined(STDNET_HAS_MADV_HUGEPAGE)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// An allocator for large lookup tables. Allocations of at least one huge page
+// are aligned to a huge page boundary and marked for transparent huge pages,
+// so that random lookups across the table do not each miss the TLB. Smaller
+// allocations, and all allocations where this is not supported, use operator
+// new.
+template <typename T>
+class huge_page_allocator
+{
+public:
+  typedef T value_type;
+
+  static const std::size_t huge_page_size = std::size_t(2) << 20;
+
+  huge_page_allocator() STDNET_NOEXCEPT
+  {
+  }
+
+  template <typename U>
+  huge_page_allocator(const huge_page_allocator<U>&) STDNET_NOEXCEPT
+  {
+  }
+
+  template <typename U>
+  struct rebind
+  {
+    typedef huge_page_allocator<U> other;
+  };
+
+  T* allocate(std::size_t n)
+  {
+#if defined(STDNET_HAS_MADV_HUGEPAGE)
+    const std::size_t size = n * sizeof(T);
+    if (size >= huge_page_size)
+    {
+      void* p = 0;
+      if (::posix_memalign(&p, huge_page_size, size) != 0)
+      {
+        std::bad_alloc ex;
+        std::experimental::net::detail::throw_exception(ex);
+      }
+# if defined(MADV_HUGEPAGE)
+      ::madvise(p, size, MADV_HUGEPAGE);
+# endif // defined(MADV_HUGEPAGE)
+      return static_cast<T*>(p);
+    }
+#endif // defined(STDNET_HAS_MADV_HUGEPAGE)
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) STDNET_NOEXCEPT
+  {
+#if defined(STDNET_HAS_MADV_HUGEPAGE)
+    if (n * sizeof(T) >= huge_page_size)
+    {
+      ::free(p);
+      return;
+    }
+#else // defined(STDNET_HAS_MADV_HUGEPAGE)
+    (void)n;
+#endif // defined(STDNET_HAS_MADV_HUGEPAGE)
+    ::operator delete(p);
+  }
+
+  friend bool operator==(const huge_page_allocator&,
+      const huge_page_allocator&) STDNET_NOEXCEPT
+  {
+    return true;
+  }
+
+  friend bool operator!=(const huge_page_allocator&,
+      const huge_page_allocator&) STDNET_NOEXCEPT
+  {
+    return false;
+  }
+};
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_HUGE_PAGE_ALLOCATOR_HPP
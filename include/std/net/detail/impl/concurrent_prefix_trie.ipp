@@ -0,0 +1,301 @@
+//
+// detail/impl/concurrent_prefix_trie.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_IMPL_CONCURRENT_PREFIX_TRIE_IPP
+#define STDNET_DETAIL_IMPL_CONCURRENT_PREFIX_TRIE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include <algorithm>
+#include <new>
+#include "std/net/detail/concurrent_prefix_trie.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace concurrent_prefix_trie_ops {
+
+// Clear the bits of a key beyond the given length.
+inline void mask(unsigned long long& high, unsigned long long& low,
+    unsigned int length)
+{
+  if (length < 64)
+  {
+    high = length == 0 ? 0 : high & (~0ULL << (64 - length));
+    low = 0;
+  }
+  else if (length < 128)
+  {
+    low = length == 64 ? 0 : low & (~0ULL << (128 - length));
+  }
+}
+
+// Set the 6 bits of a key that start at the given offset, which must be zero.
+inline void set_chunk(unsigned long long& high, unsigned long long& low,
+    unsigned int offset, unsigned int c)
+{
+  const unsigned long long bits = static_cast<unsigned long long>(c) << 58;
+  if (offset == 0)
+  {
+    high |= bits;
+  }
+  else if (offset < 64)
+  {
+    high |= bits >> offset;
+    low |= bits << (64 - offset);
+  }
+  else
+  {
+    low |= bits >> (offset - 64);
+  }
+}
+
+} // namespace concurrent_prefix_trie_ops
+
+concurrent_prefix_trie::concurrent_prefix_trie(unsigned int max_length)
+  : max_length_(max_length),
+    root_(0)
+{
+}
+
+concurrent_prefix_trie::~concurrent_prefix_trie()
+{
+  destroy_trie(root_.load(std::memory_order_relaxed));
+}
+
+void concurrent_prefix_trie::insert(unsigned long long high,
+    unsigned long long low, unsigned int length, value_type value)
+{
+  prefix_key key = { high, low, length };
+  concurrent_prefix_trie_ops::mask(key.high, key.low, length);
+  std::pair<prefix_map::iterator, bool> result =
+    prefixes_.insert(prefix_map::value_type(key, value));
+  if (!result.second)
+  {
+    if (result.first->second == value)
+      return;
+    result.first->second = value;
+  }
+  update(key);
+}
+
+bool concurrent_prefix_trie::erase(unsigned long long high,
+    unsigned long long low, unsigned int length)
+{
+  prefix_key key = { high, low, length };
+  concurrent_prefix_trie_ops::mask(key.high, key.low, length);
+  if (prefixes_.erase(key) == 0)
+    return false;
+  update(key);
+  return true;
+}
+
+void concurrent_prefix_trie::clear()
+{
+  const node* old_root = root_.load(std::memory_order_relaxed);
+  root_.store(0, std::memory_order_seq_cst);
+  prefixes_.clear();
+  retire_trie(old_root);
+  domain_.reclaim();
+}
+
+void concurrent_prefix_trie::update(const prefix_key& key)
+{
+  // Find the existing nodes on the path to the node that holds the prefix.
+  const unsigned int depth = key.length == 0 ? 0 : (key.length - 1) / stride;
+  const node* old_path[max_depth];
+  old_path[0] = root_.load(std::memory_order_relaxed);
+  for (unsigned int i = 0; i < depth; ++i)
+  {
+    const node* n = old_path[i];
+    const unsigned int c = chunk(key.high, key.low, i * stride);
+    old_path[i + 1] = n && (n->vector & (1ULL << c))
+      ? node_children(n)[bit_ops::popcount(
+          n->vector & ((2ULL << c) - 1)) - 1] : 0;
+  }
+
+  // The node that holds the prefix keeps its children and has its values
+  // found again. Each node above it keeps its values and has one child
+  // replaced. A node left with neither is dropped.
+  node* children[64];
+  value_type values[64];
+  expand_node(old_path[depth], children, values);
+  find_values(key, depth * stride, values);
+  node* replacement = make_node(children, values);
+  for (unsigned int i = depth; i > 0; --i)
+  {
+    expand_node(old_path[i - 1], children, values);
+    children[chunk(key.high, key.low, (i - 1) * stride)] = replacement;
+    replacement = make_node(children, values);
+  }
+
+  root_.store(replacement, std::memory_order_seq_cst);
+
+  for (unsigned int i = 0; i <= depth; ++i)
+    if (old_path[i])
+      domain_.retire(const_cast<node*>(old_path[i]), &destroy_node);
+  domain_.reclaim();
+}
+
+void concurrent_prefix_trie::find_values(const prefix_key& key,
+    unsigned int offset, value_type* values) const
+{
+  using concurrent_prefix_trie_ops::mask;
+  using concurrent_prefix_trie_ops::set_chunk;
+
+  // Only the children that the prefix covers can have changed. They take the
+  // value of the longest prefix, no longer than the changed one, that ends
+  // within the node and covers them, except where a longer prefix within the
+  // span applies. A prefix that ends at the node's offset belongs to the node
+  // above, except at the root.
+  const unsigned int first_length = offset == 0 ? 0 : offset + 1;
+  const unsigned int last_length = std::min(offset + stride, max_length_);
+  const unsigned int first = chunk(key.high, key.low, offset);
+  const unsigned int span = 1u << (offset + stride - key.length);
+
+  value_type covering = no_value;
+  for (unsigned int length = key.length + 1; length > first_length; --length)
+  {
+    prefix_key k = { key.high, key.low, length - 1 };
+    mask(k.high, k.low, length - 1);
+    prefix_map::const_iterator iter = prefixes_.find(k);
+    if (iter != prefixes_.end())
+    {
+      covering = iter->second;
+      break;
+    }
+  }
+  std::fill(values + first, values + first + span, covering);
+
+  for (unsigned int length = key.length + 1; length <= last_length; ++length)
+  {
+    const unsigned int sub_span = 1u << (offset + stride - length);
+    for (unsigned int c = first; c < first + span; c += sub_span)
+    {
+      prefix_key k = { key.high, key.low, length };
+      mask(k.high, k.low, offset);
+      set_chunk(k.high, k.low, offset, c);
+      prefix_map::const_iterator iter = prefixes_.find(k);
+      if (iter != prefixes_.end())
+        std::fill(values + c, values + c + sub_span, iter->second);
+    }
+  }
+}
+
+concurrent_prefix_trie::node* concurrent_prefix_trie::make_node(
+    node* const* children, const value_type* values)
+{
+  unsigned long long vector = 0;
+  unsigned long long leafvec = 0;
+  std::size_t child_count = 0;
+  std::size_t value_count = 0;
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    if (children[i])
+    {
+      vector |= 1ULL << i;
+      ++child_count;
+    }
+    if (i == 0 || values[i] != values[i - 1])
+    {
+      leafvec |= 1ULL << i;
+      ++value_count;
+    }
+  }
+
+  if (vector == 0 && value_count == 1 && values[0] == no_value)
+    return 0;
+
+  void* p = ::operator new(sizeof(node)
+      + child_count * sizeof(node*) + value_count * sizeof(value_type));
+  node* n = new (p) node;
+  n->vector = vector;
+  n->leafvec = leafvec;
+
+  node** child_out = reinterpret_cast<node**>(n + 1);
+  value_type* value_out = reinterpret_cast<value_type*>(
+      child_out + child_count);
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    if (children[i])
+      *child_out++ = children[i];
+    if (leafvec & (1ULL << i))
+      *value_out++ = values[i];
+  }
+
+  return n;
+}
+
+void concurrent_prefix_trie::expand_node(const node* n,
+    node** children, value_type* values)
+{
+  if (!n)
+  {
+    std::fill(children, children + 64, static_cast<node*>(0));
+    std::fill(values, values + 64, value_type(no_value));
+    return;
+  }
+
+  node* const* child_in = node_children(n);
+  const value_type* value_in = node_values(n);
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    children[i] = (n->vector & (1ULL << i)) ? *child_in++ : 0;
+    values[i] = *(value_in - 1 + bit_ops::popcount(
+          n->leafvec & ((2ULL << i) - 1)));
+  }
+}
+
+void concurrent_prefix_trie::destroy_node(void* n)
+{
+  ::operator delete(n);
+}
+
+void concurrent_prefix_trie::destroy_trie(const node* n)
+{
+  if (n)
+  {
+    const unsigned int children = bit_ops::popcount(n->vector);
+    for (unsigned int i = 0; i < children; ++i)
+      destroy_trie(node_children(n)[i]);
+    destroy_node(const_cast<node*>(n));
+  }
+}
+
+void concurrent_prefix_trie::retire_trie(const node* n)
+{
+  if (n)
+  {
+    const unsigned int children = bit_ops::popcount(n->vector);
+    for (unsigned int i = 0; i < children; ++i)
+      retire_trie(node_children(n)[i]);
+    domain_.retire(const_cast<node*>(n), &destroy_node);
+  }
+}
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_DETAIL_IMPL_CONCURRENT_PREFIX_TRIE_IPP
@@ -0,0 +1,120 @@
+//
+// detail/impl/epoch_domain.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_IMPL_EPOCH_DOMAIN_IPP
+#define STDNET_DETAIL_IMPL_EPOCH_DOMAIN_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include "std/net/detail/epoch_domain.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+epoch_domain::epoch_domain()
+  : epoch_(1),
+    slots_(0)
+{
+}
+
+epoch_domain::~epoch_domain()
+{
+  for (std::size_t i = 0; i < retired_.size(); ++i)
+    retired_[i].destroy(retired_[i].pointer);
+
+  slot* s = slots_.load(std::memory_order_acquire);
+  while (s)
+  {
+    slot* next = s->next_.load(std::memory_order_relaxed);
+    delete s;
+    s = next;
+  }
+}
+
+epoch_domain::slot* epoch_domain::acquire_slot()
+{
+  for (slot* s = slots_.load(std::memory_order_acquire);
+      s; s = s->next_.load(std::memory_order_relaxed))
+  {
+    bool in_use = false;
+    if (!s->in_use_.load(std::memory_order_relaxed)
+        && s->in_use_.compare_exchange_strong(in_use, true,
+          std::memory_order_acquire))
+      return s;
+  }
+
+  slot* s = new slot;
+  s->epoch_.store(0, std::memory_order_relaxed);
+  s->in_use_.store(true, std::memory_order_relaxed);
+  slot* head = slots_.load(std::memory_order_relaxed);
+  do
+    s->next_.store(head, std::memory_order_relaxed);
+  while (!slots_.compare_exchange_weak(head, s,
+        std::memory_order_release, std::memory_order_relaxed));
+  return s;
+}
+
+void epoch_domain::release_slot(slot* s) STDNET_NOEXCEPT
+{
+  s->in_use_.store(false, std::memory_order_release);
+}
+
+void epoch_domain::retire(void* p, void (*destroy)(void*))
+{
+  retired r = { p, destroy, epoch_.load(std::memory_order_relaxed) };
+  retired_.push_back(r);
+}
+
+void epoch_domain::reclaim()
+{
+  // Readers that enter after the increment see the epoch after it, and must
+  // also see the version of the structure published before it.
+  const unsigned long long current =
+    epoch_.fetch_add(1, std::memory_order_seq_cst);
+
+  unsigned long long oldest = current + 1;
+  for (slot* s = slots_.load(std::memory_order_acquire);
+      s; s = s->next_.load(std::memory_order_relaxed))
+  {
+    const unsigned long long e = s->epoch_.load(std::memory_order_seq_cst);
+    if (e != 0 && e < oldest)
+      oldest = e;
+  }
+
+  // Memory is retired in epoch order.
+  std::size_t freed = 0;
+  while (freed < retired_.size() && retired_[freed].epoch < oldest)
+  {
+    retired_[freed].destroy(retired_[freed].pointer);
+    ++freed;
+  }
+  retired_.erase(retired_.begin(), retired_.begin() + freed);
+}
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_DETAIL_IMPL_EPOCH_DOMAIN_IPP
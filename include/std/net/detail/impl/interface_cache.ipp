@@ -0,0 +1,300 @@
+//
+// detail/impl/interface_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_IMPL_INTERFACE_CACHE_IPP
+#define STDNET_DETAIL_IMPL_INTERFACE_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+#include <cstring>
+#include "std/net/detail/interface_cache.hpp"
+#include "std/net/detail/socket_types.hpp"
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+# include <atomic>
+# include <chrono>
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace interface_cache {
+
+#if defined(__hpux)
+// HP-UX doesn't declare these functions extern "C", so they are declared again
+// here to avoid linker errors about undefined symbols.
+extern "C" char* if_indextoname(unsigned int, char*);
+extern "C" unsigned int if_nametoindex(const char*);
+#endif // defined(__hpux)
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+
+#if defined(STDNET_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+typedef std::chrono::monotonic_clock clock_type;
+#else // defined(STDNET_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+typedef std::chrono::steady_clock clock_type;
+#endif // defined(STDNET_HAS_STD_CHRONO_MONOTONIC_CLOCK)
+
+// Each name is held in two 64-bit words, so that a lookup compares whole words
+// rather than strings. Longer names, and interfaces beyond the size of the
+// table, are left to the system.
+const std::size_t name_words = 2;
+const std::size_t max_cached_name_len = name_words * 8;
+const std::size_t max_entries = 64;
+
+struct entry
+{
+  std::atomic<unsigned long> index;
+  std::atomic<unsigned long long> name[name_words];
+};
+
+// The table is a sequence lock. Its single writer makes the sequence number odd
+// while it updates the entries. Readers do not write to the table at all, and
+// retry if the sequence number was odd or changed while they were reading.
+struct table
+{
+  std::atomic<unsigned> sequence;
+  std::atomic<std::size_t> size;
+  std::atomic<clock_type::rep> expiry;
+  std::atomic<bool> writing;
+  entry entries[max_entries];
+};
+
+// All members are zero initialised, so the table starts out empty and expired.
+inline table& the_table()
+{
+  static table t;
+  return t;
+}
+
+inline void pack_name(const char* name, std::size_t length,
+    unsigned long long* words)
+{
+  char bytes[max_cached_name_len] = { 0 };
+  std::memcpy(bytes, name, length);
+  std::memcpy(words, bytes, max_cached_name_len);
+}
+
+inline unsigned long find_index(const table& t,
+    const unsigned long long* name)
+{
+  for (;;)
+  {
+    const unsigned sequence = t.sequence.load(std::memory_order_acquire);
+    const std::size_t size = t.size.load(std::memory_order_relaxed);
+    unsigned long index = 0;
+    for (std::size_t i = 0; i < size && i < max_entries; ++i)
+    {
+      const entry& e = t.entries[i];
+      if (e.name[0].load(std::memory_order_relaxed) == name[0]
+          && e.name[1].load(std::memory_order_relaxed) == name[1])
+      {
+        index = e.index.load(std::memory_order_relaxed);
+        break;
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((sequence & 1) == 0
+        && t.sequence.load(std::memory_order_relaxed) == sequence)
+      return index;
+  }
+}
+
+inline bool find_name(const table& t, unsigned long index,
+    unsigned long long* name)
+{
+  for (;;)
+  {
+    const unsigned sequence = t.sequence.load(std::memory_order_acquire);
+    const std::size_t size = t.size.load(std::memory_order_relaxed);
+    bool found = false;
+    for (std::size_t i = 0; i < size && i < max_entries; ++i)
+    {
+      const entry& e = t.entries[i];
+      if (e.index.load(std::memory_order_relaxed) == index)
+      {
+        name[0] = e.name[0].load(std::memory_order_relaxed);
+        name[1] = e.name[1].load(std::memory_order_relaxed);
+        found = true;
+        break;
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if ((sequence & 1) == 0
+        && t.sequence.load(std::memory_order_relaxed) == sequence)
+      return found;
+  }
+}
+
+// Reloads the table from the system. Must only be called by the thread that
+// has set the writing flag.
+inline void load_table(table& t)
+{
+  unsigned long indexes[max_entries];
+  unsigned long long names[max_entries][name_words];
+  std::size_t size = 0;
+  if (struct if_nameindex* list = ::if_nameindex())
+  {
+    for (struct if_nameindex* p = list;
+        p->if_index != 0 && size < max_entries; ++p)
+    {
+      const std::size_t length = std::strlen(p->if_name);
+      if (length < IF_NAMESIZE && length <= max_cached_name_len)
+      {
+        indexes[size] = p->if_index;
+        pack_name(p->if_name, length, names[size]);
+        ++size;
+      }
+    }
+    ::if_freenameindex(list);
+  }
+
+  const unsigned sequence = t.sequence.load(std::memory_order_relaxed);
+  t.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    t.entries[i].index.store(indexes[i], std::memory_order_relaxed);
+    t.entries[i].name[0].store(names[i][0], std::memory_order_relaxed);
+    t.entries[i].name[1].store(names[i][1], std::memory_order_relaxed);
+  }
+  t.size.store(size, std::memory_order_relaxed);
+  t.sequence.store(sequence + 2, std::memory_order_release);
+
+  const clock_type::time_point expiry = clock_type::now()
+    + std::chrono::milliseconds(refresh_interval_ms);
+  t.expiry.store(expiry.time_since_epoch().count(),
+      std::memory_order_relaxed);
+}
+
+// Reloads the table if it has expired, unless another thread is already doing
+// so, in which case the current contents are used in the meantime.
+inline void refresh_if_expired(table& t)
+{
+  if (clock_type::now().time_since_epoch().count()
+      < t.expiry.load(std::memory_order_relaxed))
+    return;
+
+  bool expected = false;
+  if (t.writing.compare_exchange_strong(expected, true,
+        std::memory_order_acquire))
+  {
+    load_table(t);
+    t.writing.store(false, std::memory_order_release);
+  }
+}
+
+// Called when the system finds an interface that the table could have held but
+// does not, so that the next lookup reloads the table.
+inline void expire(table& t, std::size_t name_length)
+{
+  if (name_length <= max_cached_name_len
+      && t.size.load(std::memory_order_relaxed) < max_entries)
+    t.expiry.store(0, std::memory_order_relaxed);
+}
+
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+unsigned long name_to_index(const char* name, std::size_t length)
+{
+  if (length == 0 || length >= IF_NAMESIZE)
+    return 0;
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+  table& t = the_table();
+  refresh_if_expired(t);
+  if (length <= max_cached_name_len)
+  {
+    unsigned long long words[name_words];
+    pack_name(name, length, words);
+    if (unsigned long index = find_index(t, words))
+      return index;
+  }
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+  char if_name[IF_NAMESIZE];
+  std::memcpy(if_name, name, length);
+  if_name[length] = 0;
+  unsigned long index = if_nametoindex(if_name);
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+  if (index != 0)
+    expire(t, length);
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+  return index;
+}
+
+std::size_t index_to_name(unsigned long index, char* name)
+{
+  if (index == 0 || static_cast<unsigned>(index) != index)
+    return 0;
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+  table& t = the_table();
+  refresh_if_expired(t);
+  unsigned long long words[name_words];
+  if (find_name(t, index, words))
+  {
+    char bytes[max_cached_name_len];
+    std::memcpy(bytes, words, max_cached_name_len);
+    std::size_t length = 0;
+    while (length < max_cached_name_len && bytes[length] != 0)
+      ++length;
+    std::memcpy(name, bytes, length);
+    return length;
+  }
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+  if (if_indextoname(static_cast<unsigned>(index), name) == 0)
+    return 0;
+
+  const std::size_t length = std::strlen(name);
+
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+  expire(t, length);
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+
+  return length;
+}
+
+void refresh()
+{
+#if defined(STDNET_HAS_INTERFACE_CACHE)
+  table& t = the_table();
+  bool expected = false;
+  while (!t.writing.compare_exchange_weak(expected, true,
+        std::memory_order_acquire))
+    expected = false;
+  load_table(t);
+  t.writing.store(false, std::memory_order_release);
+#endif // defined(STDNET_HAS_INTERFACE_CACHE)
+}
+
+} // namespace interface_cache
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+#endif // STDNET_DETAIL_IMPL_INTERFACE_CACHE_IPP
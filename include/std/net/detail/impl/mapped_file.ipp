@@ -0,0 +1,147 @@
+//
+// detail/impl/mapped_file.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_IMPL_MAPPED_FILE_IPP
+#define STDNET_DETAIL_IMPL_MAPPED_FILE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cerrno>
+#include <cstdio>
+#include "std/net/detail/mapped_file.hpp"
+#include "std/net/detail/system_errors.hpp"
+
+#if defined(STDNET_HAS_MMAP)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif // defined(STDNET_HAS_MMAP)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+mapped_file::mapped_file() STDNET_NOEXCEPT
+  : data_(0),
+    size_(0)
+{
+}
+
+mapped_file::~mapped_file()
+{
+  close();
+}
+
+#if defined(STDNET_HAS_MMAP)
+
+void mapped_file::open(const char* path, std::error_code& ec)
+{
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd == -1)
+  {
+    ec = std::error_code(errno, system_category());
+    return;
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) == -1)
+  {
+    ec = std::error_code(errno, system_category());
+    ::close(fd);
+    return;
+  }
+
+  // An empty file cannot be mapped, and needs no memory.
+  if (st.st_size > 0)
+  {
+    void* p = ::mmap(0, static_cast<std::size_t>(st.st_size),
+        PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+    {
+      ec = std::error_code(errno, system_category());
+      ::close(fd);
+      return;
+    }
+
+    data_ = static_cast<const char*>(p);
+    size_ = static_cast<std::size_t>(st.st_size);
+  }
+
+  ::close(fd);
+  ec = std::error_code();
+}
+
+void mapped_file::close() STDNET_NOEXCEPT
+{
+  if (data_)
+    ::munmap(const_cast<char*>(data_), size_);
+  data_ = 0;
+  size_ = 0;
+}
+
+#else // defined(STDNET_HAS_MMAP)
+
+void mapped_file::open(const char* path, std::error_code& ec)
+{
+  close();
+
+  std::FILE* f = std::fopen(path, "rb");
+  if (!f)
+  {
+    ec = std::error_code(errno, system_category());
+    return;
+  }
+
+  char block[65536];
+  std::size_t n;
+  while ((n = std::fread(block, 1, sizeof(block), f)) > 0)
+    buffer_.insert(buffer_.end(), block, block + n);
+
+  if (std::ferror(f))
+  {
+    ec = std::error_code(EIO, system_category());
+    buffer_.clear();
+  }
+  else
+  {
+    data_ = buffer_.empty() ? 0 : &buffer_[0];
+    size_ = buffer_.size();
+    ec = std::error_code();
+  }
+
+  std::fclose(f);
+}
+
+void mapped_file::close() STDNET_NOEXCEPT
+{
+  std::vector<char>().swap(buffer_);
+  data_ = 0;
+  size_ = 0;
+}
+
+#endif // defined(STDNET_HAS_MMAP)
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_IMPL_MAPPED_FILE_IPP
@@ -22,6 +22,7 @@
 #include <cstring>
 #include <cerrno>
 #include <new>
+#include "std/net/detail/interface_cache.hpp"
 #include "std/net/detail/socket_ops.hpp"
 #include "std/net/detail/system_errors.hpp"
 
@@ -33,13 +34,6 @@ namespace net {
 namespace detail {
 namespace socket_ops {
 
-#if defined(__hpux)
-// HP-UX doesn't declare these functions extern "C", so they are declared again
-// here to avoid linker errors about undefined symbols.
-extern "C" char* if_indextoname(unsigned int, char*);
-extern "C" unsigned int if_nametoindex(const char*);
-#endif // defined(__hpux)
-
 inline void clear_last_error()
 {
 #if defined(STDNET_WINDOWS) || defined(__CYGWIN__)
@@ -55,10 +49,10 @@ inline ReturnType error_wrapper(ReturnType return_value,
 {
 #if defined(STDNET_WINDOWS) || defined(__CYGWIN__)
   ec = std::error_code(WSAGetLastError(),
-      std::experimental::net::detail::syserrc::system_category());
+      std::experimental::net::detail::system_category());
 #else
   ec = std::error_code(errno,
-      std::experimental::net::detail::syserrc::system_category());
+      std::experimental::net::detail::system_category());
 #endif
   return return_value;
 }
@@ -133,9 +127,13 @@ const char* inet_ntop(int af, const void* src, char* dest, size_t length,
     const in6_addr_type* ipv6_address = static_cast<const in6_addr_type*>(src);
     bool is_link_local = ((ipv6_address->s6_addr[0] == 0xfe)
         && ((ipv6_address->s6_addr[1] & 0xc0) == 0x80));
-    if (!is_link_local
-        || if_indextoname(static_cast<unsigned>(scope_id), if_name + 1) == 0)
+    std::size_t name_length = 0;
+    if (is_link_local)
+      name_length = interface_cache::index_to_name(scope_id, if_name + 1);
+    if (name_length == 0)
       sprintf(if_name + 1, "%lu", scope_id);
+    else
+      if_name[name_length + 1] = 0;
     strcat(dest, if_name);
   }
   return result;
@@ -212,7 +210,7 @@ int inet_pton(int af, const char* src, void* dest,
     ec = std::experimental::net::detail::syserrc::invalid_argument;
   if (result > 0 && af == AF_INET6 && scope_id)
   {
-    using namespace std; // For strchr and atoi.
+    using namespace std; // For strchr, strlen and atoi.
     *scope_id = 0;
     if (const char* if_name = strchr(src, '%'))
     {
@@ -220,7 +218,8 @@ int inet_pton(int af, const char* src, void* dest,
       bool is_link_local = ((ipv6_address->s6_addr[0] == 0xfe)
           && ((ipv6_address->s6_addr[1] & 0xc0) == 0x80));
       if (is_link_local)
-        *scope_id = if_nametoindex(if_name + 1);
+        *scope_id = interface_cache::name_to_index(
+            if_name + 1, strlen(if_name + 1));
       if (*scope_id == 0)
         *scope_id = atoi(if_name + 1);
     }
@@ -0,0 +1,894 @@
+//
+// detail/impl/text_ops.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_IMPL_TEXT_OPS_IPP
+#define STDNET_DETAIL_IMPL_TEXT_OPS_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstring>
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/interface_cache.hpp"
+#include "std/net/detail/socket_types.hpp"
+#include "std/net/detail/text_ops.hpp"
+
+#if defined(STDNET_HAS_SSE41)
+# include <smmintrin.h>
+#endif // defined(STDNET_HAS_SSE41)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace text_ops {
+
+// Returns the value of a decimal digit, or a value greater than 9 if the
+// character is not a decimal digit.
+inline unsigned decimal_value(char c)
+{
+  return static_cast<unsigned>(static_cast<unsigned char>(c) - '0');
+}
+
+// Scalar parser. Each octet is decoded with straight-line code, so the only
+// data-dependent branches are those that detect the end of an octet.
+inline bool parse_v4_scalar(const char* p, const char* last,
+    unsigned char* bytes)
+{
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i != 0)
+    {
+      if (p == last || *p != '.')
+        return false;
+      ++p;
+    }
+
+    if (p == last)
+      return false;
+    unsigned value = decimal_value(*p);
+    if (value > 9)
+      return false;
+    ++p;
+
+    // A leading zero must be the only digit in the octet.
+    unsigned digit;
+    if (value != 0 && p != last && (digit = decimal_value(*p)) <= 9)
+    {
+      value = value * 10 + digit;
+      ++p;
+      if (p != last && (digit = decimal_value(*p)) <= 9)
+      {
+        value = value * 10 + digit;
+        ++p;
+        if (value > 255)
+          return false;
+      }
+    }
+
+    bytes[i] = static_cast<unsigned char>(value);
+  }
+
+  return p == last;
+}
+
+#if defined(STDNET_HAS_SSE41)
+
+// Shuffle controls for the SSE4.1 parser, indexed by the lengths of the four
+// octets. Each control moves the digits of octet i into bytes 4i to 4i+2 of
+// the register, right aligned, so that a multiply-add can form the value.
+inline const unsigned char* v4_shuffle_control(unsigned index)
+{
+  static const unsigned char controls[81][16] =
+  {
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 0x80, 6, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 6, 7, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 0x80, 4, 0x80, 6, 7, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 0x80, 7, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 7, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 0x80, 4, 5, 0x80, 7, 8, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 4, 5, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 4, 5, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 0x80, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 5, 0x80, 0x80, 0x80, 7, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 5, 0x80, 0x80, 7, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 0x80, 5, 0x80, 7, 8, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 5, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 5, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 0x80, 5, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 5, 6, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 5, 6, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 0x80, 2, 3, 0x80, 5, 6, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 0x80, 6, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 6, 7, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 6, 7, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0x80, 0x80, 0, 0x80, 2, 3, 4, 0x80, 6, 7, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 0x80, 5, 0x80, 0x80, 0x80, 7, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 0x80, 5, 0x80, 0x80, 7, 8, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 0x80, 5, 0x80, 7, 8, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 5, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 5, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 0x80, 5, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 5, 6, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 5, 6, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 0x80, 3, 0x80, 5, 6, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 0x80, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 0x80, 6, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 6, 7, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 6, 7, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 0x80, 3, 4, 0x80, 6, 7, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 7, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 7, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 0x80, 7, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 7, 8, 9, 0x80, 0x80, 0x80, 11, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 7, 8, 9, 0x80, 0x80, 11, 12, 0x80 },
+    { 0x80, 0, 1, 0x80, 3, 4, 5, 0x80, 7, 8, 9, 0x80, 11, 12, 13, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 0x80, 8, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 0x80, 6, 0x80, 0x80, 8, 9, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 0x80, 6, 0x80, 8, 9, 10, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 6, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 0x80, 6, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 6, 7, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 6, 7, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 0x80, 4, 0x80, 6, 7, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 0x80, 0x80, 9, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 0x80, 9, 10, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 0x80, 7, 0x80, 9, 10, 11, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 7, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 7, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 0x80, 7, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 7, 8, 9, 0x80, 0x80, 0x80, 11, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 7, 8, 9, 0x80, 0x80, 11, 12, 0x80 },
+    { 0, 1, 2, 0x80, 0x80, 4, 5, 0x80, 7, 8, 9, 0x80, 11, 12, 13, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 0x80, 8, 0x80, 0x80, 0x80, 10, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 0x80, 8, 0x80, 0x80, 10, 11, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 0x80, 8, 0x80, 10, 11, 12, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 8, 9, 0x80, 0x80, 0x80, 11, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 8, 9, 0x80, 0x80, 11, 12, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 0x80, 8, 9, 0x80, 11, 12, 13, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 0x80, 0x80, 12, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 0x80, 12, 13, 0x80 },
+    { 0, 1, 2, 0x80, 4, 5, 6, 0x80, 8, 9, 10, 0x80, 12, 13, 14, 0x80 }
+  };
+
+  return controls[index];
+}
+
+// Loads a string of between 7 and 16 characters into a register, with the
+// bytes beyond the end of the string set to zero. Overlapping fixed-size loads
+// are used so that no byte outside the string is read.
+inline __m128i load_v4_text(const char* first, std::size_t length)
+{
+  using namespace std; // For memcpy.
+
+  if (length < 8)
+  {
+    unsigned int head, tail;
+    memcpy(&head, first, 4);
+    memcpy(&tail, first + 3, 4);
+    return _mm_set_epi64x(0, static_cast<long long>(
+          head | (static_cast<unsigned long long>(tail) << 24)));
+  }
+
+  unsigned long long head, tail = 0;
+  memcpy(&head, first, 8);
+  if (length > 8)
+  {
+    memcpy(&tail, first + length - 8, 8);
+    tail >>= 8 * (16 - length);
+  }
+  return _mm_set_epi64x(static_cast<long long>(tail),
+      static_cast<long long>(head));
+}
+
+// Layouts of the valid strings, found by a perfect hash of the positions of
+// their dots and their length. Bits 0 to 15 of each entry hold the key, bits 16
+// to 31 the positions of the first digits of octets with more than one digit,
+// and bits 32 to 38 the index of the shuffle control. Unused entries have a
+// key that no string can have.
+inline unsigned long long v4_layout(unsigned key)
+{
+  static const unsigned long long layouts[256] =
+  {
+    0x0000000000ULL, 0x0000000000ULL, 0x1002240912ULL, 0x0000000000ULL,
+    0x2b04491224ULL, 0x1500440522ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x4608912448ULL, 0x2902491124ULL, 0x3000890a44ULL, 0x020040022aULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x2e02090944ULL,
+    0x010040012aULL, 0x0000000000ULL, 0x4404912248ULL, 0x0000000000ULL,
+    0x4b01111488ULL, 0x0f00240512ULL, 0x0000000000ULL, 0x1d00810454ULL,
+    0x0000000000ULL, 0x2302211114ULL, 0x4f11114888ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x4904111288ULL, 0x0000000000ULL,
+    0x1c00810254ULL, 0x0000000000ULL, 0x2d00090544ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x1b00010154ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x2a00490a24ULL,
+    0x0000000000ULL, 0x4d09114488ULL, 0x38010108a8ULL, 0x2802490924ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x3e04412228ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x2202210914ULL, 0x37010104a8ULL, 0x0000000000ULL, 0x2700490524ULL,
+    0x0000000000ULL, 0x4800110a88ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x36000102a8ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x2100210514ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x4500911448ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x4304911248ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x4102111148ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x4708914448ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x14010408a2ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x1a04442222ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x3d04411228ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0e01240892ULL, 0x3b02411128ULL, 0x4200910a48ULL, 0x13010404a2ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x4002110948ULL,
+    0x080110088aULL, 0x3408892444ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x12000402a2ULL, 0x00000000aaULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x3204892244ULL, 0x0d01240492ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x3f00110548ULL, 0x0000000000ULL,
+    0x070110048aULL, 0x0c00240292ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x3c00410a28ULL,
+    0x0000000000ULL, 0x060010028aULL, 0x0000000000ULL, 0x3a02410928ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x26010908a4ULL, 0x0000000000ULL,
+    0x4e01112888ULL, 0x0000000000ULL, 0x0000000000ULL, 0x2c04492224ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x3900410528ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x2001210894ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x25010904a4ULL, 0x1904441222ULL, 0x4c09112488ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x1702441122ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x24000902a4ULL,
+    0x0000000000ULL, 0x4a04112288ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x1f01210494ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0b00840452ULL, 0x3300891444ULL, 0x1102241112ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x1e00210294ULL,
+    0x0000000000ULL, 0x050090044aULL, 0x0a00840252ULL, 0x3104891244ULL,
+    0x0000000000ULL, 0x5011118888ULL, 0x0000000000ULL, 0x0900040152ULL,
+    0x2f02091144ULL, 0x0000000000ULL, 0x040090024aULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x1800440a22ULL, 0x0000000000ULL, 0x030010014aULL,
+    0x0000000000ULL, 0x1602440922ULL, 0x3508894444ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL,
+    0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL, 0x0000000000ULL
+  };
+
+  return layouts[(key * 0x9efb2d29u) >> 24];
+}
+
+// Checks the characters of a string of between 7 and 15 characters, given as
+// masks of the positions of its digits, dots and zero digits, and finds the
+// index of the shuffle control that aligns its octets. Bits of the masks at
+// or beyond the length of the string are ignored.
+inline bool check_v4_layout(unsigned digit_mask, unsigned dot_mask,
+    unsigned zero_mask, std::size_t length, unsigned& control)
+{
+  // The dots and the length identify the layout, which gives the lengths of
+  // the octets. Every other character must be a digit, and a leading zero
+  // must be the only digit in its octet.
+  const unsigned length_mask = (1u << length) - 1;
+  dot_mask &= length_mask;
+  const unsigned key = dot_mask | (1u << length);
+  const unsigned long long layout = v4_layout(key);
+  control = static_cast<unsigned>(layout >> 32);
+  return ((layout & 0xFFFF) == key)
+    & ((digit_mask & length_mask) == (length_mask ^ dot_mask))
+    & ((zero_mask & (layout >> 16) & 0xFFFF) == 0);
+}
+
+// Vector parser for strings of between 7 and 15 characters. The whole address
+// is classified, converted and range checked in a single register.
+inline bool parse_v4_sse41(const char* first, std::size_t length,
+    unsigned char* bytes)
+{
+  const __m128i text = load_v4_text(first, length);
+  const __m128i digits = _mm_sub_epi8(text, _mm_set1_epi8('0'));
+  const __m128i is_digit = _mm_cmpeq_epi8(
+      _mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+  const __m128i is_dot = _mm_cmpeq_epi8(text, _mm_set1_epi8('.'));
+  const __m128i is_zero = _mm_cmpeq_epi8(digits, _mm_setzero_si128());
+
+  unsigned control;
+  if (!check_v4_layout(static_cast<unsigned>(_mm_movemask_epi8(is_digit)),
+        static_cast<unsigned>(_mm_movemask_epi8(is_dot)),
+        static_cast<unsigned>(_mm_movemask_epi8(is_zero)), length, control))
+    return false;
+
+  const __m128i shuffle = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(v4_shuffle_control(control)));
+  const __m128i aligned = _mm_shuffle_epi8(digits, shuffle);
+  const __m128i weights = _mm_setr_epi8(
+      100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0, 100, 10, 1, 0);
+  const __m128i values = _mm_madd_epi16(
+      _mm_maddubs_epi16(aligned, weights), _mm_set1_epi16(1));
+  if (_mm_movemask_epi8(_mm_cmpgt_epi32(values, _mm_set1_epi32(255))) != 0)
+    return false;
+
+  const __m128i packed = _mm_packus_epi16(
+      _mm_packus_epi32(values, values), _mm_setzero_si128());
+  const int result = _mm_cvtsi128_si32(packed);
+  std::memcpy(bytes, &result, 4);
+  return true;
+}
+
+#endif // defined(STDNET_HAS_SSE41)
+
+bool parse_v4(const char* first, const char* last, unsigned char* bytes)
+{
+  const std::size_t length = static_cast<std::size_t>(last - first);
+  if (length < 7 || length > max_v4_text_len)
+    return false;
+
+#if defined(STDNET_HAS_SSE41)
+  return parse_v4_sse41(first, length, bytes);
+#else // defined(STDNET_HAS_SSE41)
+  return parse_v4_scalar(first, last, bytes);
+#endif // defined(STDNET_HAS_SSE41)
+}
+
+// Returns the digits of an octet followed by a dot, left aligned, so that an
+// octet and its separator may be written with a single four byte store.
+inline const char* v4_octet_text(unsigned char octet)
+{
+  static const char octets[256][4] =
+  {
+    { '0', '.', 0, 0 }, { '1', '.', 0, 0 }, { '2', '.', 0, 0 },
+    { '3', '.', 0, 0 }, { '4', '.', 0, 0 }, { '5', '.', 0, 0 },
+    { '6', '.', 0, 0 }, { '7', '.', 0, 0 }, { '8', '.', 0, 0 },
+    { '9', '.', 0, 0 }, { '1', '0', '.', 0 }, { '1', '1', '.', 0 },
+    { '1', '2', '.', 0 }, { '1', '3', '.', 0 }, { '1', '4', '.', 0 },
+    { '1', '5', '.', 0 }, { '1', '6', '.', 0 }, { '1', '7', '.', 0 },
+    { '1', '8', '.', 0 }, { '1', '9', '.', 0 }, { '2', '0', '.', 0 },
+    { '2', '1', '.', 0 }, { '2', '2', '.', 0 }, { '2', '3', '.', 0 },
+    { '2', '4', '.', 0 }, { '2', '5', '.', 0 }, { '2', '6', '.', 0 },
+    { '2', '7', '.', 0 }, { '2', '8', '.', 0 }, { '2', '9', '.', 0 },
+    { '3', '0', '.', 0 }, { '3', '1', '.', 0 }, { '3', '2', '.', 0 },
+    { '3', '3', '.', 0 }, { '3', '4', '.', 0 }, { '3', '5', '.', 0 },
+    { '3', '6', '.', 0 }, { '3', '7', '.', 0 }, { '3', '8', '.', 0 },
+    { '3', '9', '.', 0 }, { '4', '0', '.', 0 }, { '4', '1', '.', 0 },
+    { '4', '2', '.', 0 }, { '4', '3', '.', 0 }, { '4', '4', '.', 0 },
+    { '4', '5', '.', 0 }, { '4', '6', '.', 0 }, { '4', '7', '.', 0 },
+    { '4', '8', '.', 0 }, { '4', '9', '.', 0 }, { '5', '0', '.', 0 },
+    { '5', '1', '.', 0 }, { '5', '2', '.', 0 }, { '5', '3', '.', 0 },
+    { '5', '4', '.', 0 }, { '5', '5', '.', 0 }, { '5', '6', '.', 0 },
+    { '5', '7', '.', 0 }, { '5', '8', '.', 0 }, { '5', '9', '.', 0 },
+    { '6', '0', '.', 0 }, { '6', '1', '.', 0 }, { '6', '2', '.', 0 },
+    { '6', '3', '.', 0 }, { '6', '4', '.', 0 }, { '6', '5', '.', 0 },
+    { '6', '6', '.', 0 }, { '6', '7', '.', 0 }, { '6', '8', '.', 0 },
+    { '6', '9', '.', 0 }, { '7', '0', '.', 0 }, { '7', '1', '.', 0 },
+    { '7', '2', '.', 0 }, { '7', '3', '.', 0 }, { '7', '4', '.', 0 },
+    { '7', '5', '.', 0 }, { '7', '6', '.', 0 }, { '7', '7', '.', 0 },
+    { '7', '8', '.', 0 }, { '7', '9', '.', 0 }, { '8', '0', '.', 0 },
+    { '8', '1', '.', 0 }, { '8', '2', '.', 0 }, { '8', '3', '.', 0 },
+    { '8', '4', '.', 0 }, { '8', '5', '.', 0 }, { '8', '6', '.', 0 },
+    { '8', '7', '.', 0 }, { '8', '8', '.', 0 }, { '8', '9', '.', 0 },
+    { '9', '0', '.', 0 }, { '9', '1', '.', 0 }, { '9', '2', '.', 0 },
+    { '9', '3', '.', 0 }, { '9', '4', '.', 0 }, { '9', '5', '.', 0 },
+    { '9', '6', '.', 0 }, { '9', '7', '.', 0 }, { '9', '8', '.', 0 },
+    { '9', '9', '.', 0 }, { '1', '0', '0', '.' }, { '1', '0', '1', '.' },
+    { '1', '0', '2', '.' }, { '1', '0', '3', '.' }, { '1', '0', '4', '.' },
+    { '1', '0', '5', '.' }, { '1', '0', '6', '.' }, { '1', '0', '7', '.' },
+    { '1', '0', '8', '.' }, { '1', '0', '9', '.' }, { '1', '1', '0', '.' },
+    { '1', '1', '1', '.' }, { '1', '1', '2', '.' }, { '1', '1', '3', '.' },
+    { '1', '1', '4', '.' }, { '1', '1', '5', '.' }, { '1', '1', '6', '.' },
+    { '1', '1', '7', '.' }, { '1', '1', '8', '.' }, { '1', '1', '9', '.' },
+    { '1', '2', '0', '.' }, { '1', '2', '1', '.' }, { '1', '2', '2', '.' },
+    { '1', '2', '3', '.' }, { '1', '2', '4', '.' }, { '1', '2', '5', '.' },
+    { '1', '2', '6', '.' }, { '1', '2', '7', '.' }, { '1', '2', '8', '.' },
+    { '1', '2', '9', '.' }, { '1', '3', '0', '.' }, { '1', '3', '1', '.' },
+    { '1', '3', '2', '.' }, { '1', '3', '3', '.' }, { '1', '3', '4', '.' },
+    { '1', '3', '5', '.' }, { '1', '3', '6', '.' }, { '1', '3', '7', '.' },
+    { '1', '3', '8', '.' }, { '1', '3', '9', '.' }, { '1', '4', '0', '.' },
+    { '1', '4', '1', '.' }, { '1', '4', '2', '.' }, { '1', '4', '3', '.' },
+    { '1', '4', '4', '.' }, { '1', '4', '5', '.' }, { '1', '4', '6', '.' },
+    { '1', '4', '7', '.' }, { '1', '4', '8', '.' }, { '1', '4', '9', '.' },
+    { '1', '5', '0', '.' }, { '1', '5', '1', '.' }, { '1', '5', '2', '.' },
+    { '1', '5', '3', '.' }, { '1', '5', '4', '.' }, { '1', '5', '5', '.' },
+    { '1', '5', '6', '.' }, { '1', '5', '7', '.' }, { '1', '5', '8', '.' },
+    { '1', '5', '9', '.' }, { '1', '6', '0', '.' }, { '1', '6', '1', '.' },
+    { '1', '6', '2', '.' }, { '1', '6', '3', '.' }, { '1', '6', '4', '.' },
+    { '1', '6', '5', '.' }, { '1', '6', '6', '.' }, { '1', '6', '7', '.' },
+    { '1', '6', '8', '.' }, { '1', '6', '9', '.' }, { '1', '7', '0', '.' },
+    { '1', '7', '1', '.' }, { '1', '7', '2', '.' }, { '1', '7', '3', '.' },
+    { '1', '7', '4', '.' }, { '1', '7', '5', '.' }, { '1', '7', '6', '.' },
+    { '1', '7', '7', '.' }, { '1', '7', '8', '.' }, { '1', '7', '9', '.' },
+    { '1', '8', '0', '.' }, { '1', '8', '1', '.' }, { '1', '8', '2', '.' },
+    { '1', '8', '3', '.' }, { '1', '8', '4', '.' }, { '1', '8', '5', '.' },
+    { '1', '8', '6', '.' }, { '1', '8', '7', '.' }, { '1', '8', '8', '.' },
+    { '1', '8', '9', '.' }, { '1', '9', '0', '.' }, { '1', '9', '1', '.' },
+    { '1', '9', '2', '.' }, { '1', '9', '3', '.' }, { '1', '9', '4', '.' },
+    { '1', '9', '5', '.' }, { '1', '9', '6', '.' }, { '1', '9', '7', '.' },
+    { '1', '9', '8', '.' }, { '1', '9', '9', '.' }, { '2', '0', '0', '.' },
+    { '2', '0', '1', '.' }, { '2', '0', '2', '.' }, { '2', '0', '3', '.' },
+    { '2', '0', '4', '.' }, { '2', '0', '5', '.' }, { '2', '0', '6', '.' },
+    { '2', '0', '7', '.' }, { '2', '0', '8', '.' }, { '2', '0', '9', '.' },
+    { '2', '1', '0', '.' }, { '2', '1', '1', '.' }, { '2', '1', '2', '.' },
+    { '2', '1', '3', '.' }, { '2', '1', '4', '.' }, { '2', '1', '5', '.' },
+    { '2', '1', '6', '.' }, { '2', '1', '7', '.' }, { '2', '1', '8', '.' },
+    { '2', '1', '9', '.' }, { '2', '2', '0', '.' }, { '2', '2', '1', '.' },
+    { '2', '2', '2', '.' }, { '2', '2', '3', '.' }, { '2', '2', '4', '.' },
+    { '2', '2', '5', '.' }, { '2', '2', '6', '.' }, { '2', '2', '7', '.' },
+    { '2', '2', '8', '.' }, { '2', '2', '9', '.' }, { '2', '3', '0', '.' },
+    { '2', '3', '1', '.' }, { '2', '3', '2', '.' }, { '2', '3', '3', '.' },
+    { '2', '3', '4', '.' }, { '2', '3', '5', '.' }, { '2', '3', '6', '.' },
+    { '2', '3', '7', '.' }, { '2', '3', '8', '.' }, { '2', '3', '9', '.' },
+    { '2', '4', '0', '.' }, { '2', '4', '1', '.' }, { '2', '4', '2', '.' },
+    { '2', '4', '3', '.' }, { '2', '4', '4', '.' }, { '2', '4', '5', '.' },
+    { '2', '4', '6', '.' }, { '2', '4', '7', '.' }, { '2', '4', '8', '.' },
+    { '2', '4', '9', '.' }, { '2', '5', '0', '.' }, { '2', '5', '1', '.' },
+    { '2', '5', '2', '.' }, { '2', '5', '3', '.' }, { '2', '5', '4', '.' },
+    { '2', '5', '5', '.' }
+  };
+
+  return octets[octet];
+}
+
+std::size_t format_v4(const unsigned char* bytes, char* out)
+{
+  char* p = out;
+  for (int i = 0; i < 4; ++i)
+  {
+    const unsigned char octet = bytes[i];
+    std::memcpy(p, v4_octet_text(octet), 4);
+    p += 2 + (octet >= 10) + (octet >= 100);
+  }
+
+  // Drop the dot that follows the final octet.
+  return static_cast<std::size_t>(p - out) - 1;
+}
+
+// The classified text of an IPv6 address. Each mask holds one bit per
+// character, and each hexadecimal digit has its value stored in nibbles.
+struct v6_text
+{
+  unsigned long long hex;
+  unsigned long long colon;
+  unsigned long long dot;
+  unsigned char nibbles[64];
+};
+
+// The number of characters that are classified. This is enough to find the end
+// of the longest valid address.
+const std::size_t v6_classify_len = 48;
+
+inline void classify_v6_scalar(const char* first, std::size_t length,
+    v6_text& text)
+{
+  text.hex = text.colon = text.dot = 0;
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    const char c = first[i];
+    unsigned value = decimal_value(c);
+    if (value > 9)
+    {
+      const unsigned alpha = static_cast<unsigned>(
+          static_cast<unsigned char>(c | 0x20) - 'a');
+      value = alpha <= 5 ? alpha + 10 : 16;
+    }
+    if (value < 16)
+      text.hex |= 1ull << i;
+    else if (c == ':')
+      text.colon |= 1ull << i;
+    else if (c == '.')
+      text.dot |= 1ull << i;
+    text.nibbles[i] = static_cast<unsigned char>(value & 0xf);
+  }
+  std::memset(text.nibbles + length, 0, sizeof(text.nibbles) - length);
+}
+
+#if defined(STDNET_HAS_SSE41)
+
+// Classifies the text sixteen characters at a time, computing the value of
+// every hexadecimal digit in the same pass.
+inline void classify_v6_sse41(const char* first, std::size_t length,
+    v6_text& text)
+{
+  char buffer[v6_classify_len] = {};
+  std::memcpy(buffer, first, length);
+
+  text.hex = text.colon = text.dot = 0;
+  for (std::size_t i = 0; i < v6_classify_len; i += 16)
+  {
+    const __m128i c = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(buffer + i));
+    const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(
+        _mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i alpha = _mm_sub_epi8(
+        _mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i is_alpha = _mm_cmpeq_epi8(
+        _mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+    const __m128i nibble = _mm_or_si128(_mm_and_si128(is_digit, digit),
+        _mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(text.nibbles + i), nibble);
+
+    text.hex |= static_cast<unsigned long long>(_mm_movemask_epi8(
+          _mm_or_si128(is_digit, is_alpha))) << i;
+    text.colon |= static_cast<unsigned long long>(_mm_movemask_epi8(
+          _mm_cmpeq_epi8(c, _mm_set1_epi8(':')))) << i;
+    text.dot |= static_cast<unsigned long long>(_mm_movemask_epi8(
+          _mm_cmpeq_epi8(c, _mm_set1_epi8('.')))) << i;
+  }
+  std::memset(text.nibbles + v6_classify_len, 0,
+      sizeof(text.nibbles) - v6_classify_len);
+}
+
+#endif // defined(STDNET_HAS_SSE41)
+
+// Decodes the longest prefix of classified text that is a valid IPv6 address,
+// walking from one group to the next using the character masks. The rules
+// follow inet_pton(AF_INET6). Returns the length of the prefix, or zero if
+// there is no valid prefix.
+inline std::size_t parse_v6_groups(const char* first, const char* last,
+    const v6_text& text, std::size_t length, unsigned char* bytes)
+{
+  std::size_t pos = 0;
+  std::size_t tp = 0;
+  std::size_t colonp = 0;
+  bool compressed = false;
+
+  // The end of the longest valid prefix found so far, along with the number
+  // of bytes decoded and whether a "::" had been seen at that point.
+  std::size_t accept_pos = 0;
+  std::size_t accept_tp = 0;
+  bool accept_compressed = false;
+
+  // A leading colon is only allowed as part of a "::".
+  if (length > 0 && first[0] == ':')
+  {
+    if (length < 2 || first[1] != ':')
+      return 0;
+    pos = 1;
+  }
+
+  while (pos < length)
+  {
+    if ((text.colon >> pos) & 1)
+    {
+      // A "::" stands for one or more groups of zeros, and may appear once.
+      if (compressed || tp == 16)
+        break;
+      compressed = true;
+      colonp = tp;
+      ++pos;
+      accept_pos = pos, accept_tp = tp, accept_compressed = true;
+      continue;
+    }
+
+    const std::size_t digits = bit_ops::lowest_bit(~text.hex >> pos);
+    if (digits == 0)
+      break;
+
+    // A dot means that the token may instead be an embedded IPv4 address,
+    // which must be the last part of the address.
+    if (((text.dot >> (pos + digits)) & 1) && tp <= 12)
+    {
+      if (const char* end = parse_v4_prefix(first + pos, last, bytes + tp))
+      {
+        if (compressed ? tp + 4 < 16 : tp + 4 == 16)
+        {
+          accept_pos = static_cast<std::size_t>(end - first);
+          accept_tp = tp + 4, accept_compressed = compressed;
+          break;
+        }
+      }
+    }
+
+    // Form the group from up to four digits at once, discarding the nibbles
+    // that lie beyond the end of the group.
+    if (tp == 16)
+      break;
+    const std::size_t group_digits = digits < 4 ? digits : 4;
+    const unsigned char* n = text.nibbles + pos;
+    const unsigned value = ((n[0] << 12) | (n[1] << 8) | (n[2] << 4) | n[3])
+      >> (16 - 4 * group_digits);
+    bytes[tp++] = static_cast<unsigned char>(value >> 8);
+    bytes[tp++] = static_cast<unsigned char>(value);
+    pos += group_digits;
+    if (compressed ? tp < 16 : tp == 16)
+      accept_pos = pos, accept_tp = tp, accept_compressed = compressed;
+
+    // A group may be followed only by a colon.
+    if (digits > 4 || pos == length || ((text.colon >> pos) & 1) == 0)
+      break;
+    ++pos;
+  }
+
+  if (accept_pos == 0)
+    return 0;
+
+  if (accept_compressed)
+  {
+    const std::size_t tail = accept_tp - colonp;
+    std::memmove(bytes + 16 - tail, bytes + colonp, tail);
+    std::memset(bytes + colonp, 0, 16 - accept_tp);
+  }
+
+  return accept_pos;
+}
+
+// Decodes a zone ID. Numeric zone IDs are decoded directly, without a system
+// call. Otherwise, for a link-local address, the zone ID may name an interface.
+// The interface name is looked up in the interface cache. Failing that, the
+// leading digits are used, as with atoi.
+inline unsigned long parse_scope_id(const char* first, const char* last,
+    const unsigned char* bytes)
+{
+  unsigned long scope_id = 0;
+  const char* p = first;
+  for (unsigned digit; p != last && (digit = decimal_value(*p)) <= 9; ++p)
+    scope_id = scope_id * 10 + digit;
+  if (p == last)
+    return scope_id;
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+  const bool is_link_local = ((bytes[0] == 0xfe) && ((bytes[1] & 0xc0) == 0x80));
+  if (is_link_local)
+    if (unsigned long index = interface_cache::name_to_index(
+          first, static_cast<std::size_t>(last - first)))
+      return index;
+#else // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+  (void)bytes;
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+  return scope_id;
+}
+
+// Classifies the characters at the start of a string, and returns the length
+// of the longest run that may form part of an IPv6 address.
+inline std::size_t classify_v6(const char* first, const char* last,
+    v6_text& text)
+{
+  std::size_t length = static_cast<std::size_t>(last - first);
+  if (length > v6_classify_len)
+    length = v6_classify_len;
+
+#if defined(STDNET_HAS_SSE41)
+  classify_v6_sse41(first, length, text);
+#else // defined(STDNET_HAS_SSE41)
+  classify_v6_scalar(first, length, text);
+#endif // defined(STDNET_HAS_SSE41)
+
+  const std::size_t run = bit_ops::lowest_bit(~(text.hex | text.colon | text.dot));
+  const unsigned long long run_mask = (1ull << run) - 1;
+  text.hex &= run_mask;
+  text.colon &= run_mask;
+  text.dot &= run_mask;
+  return run;
+}
+
+// Returns whether a character may appear in a zone ID embedded in other text.
+// These are the unreserved characters of RFC 3986, as required by RFC 6874.
+inline bool is_zone_char(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+    || (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' || c == '~';
+}
+
+bool parse_v6(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id)
+{
+  v6_text text;
+  const std::size_t run = classify_v6(first, last, text);
+
+  // The address part ends at the first character that cannot be part of an
+  // address, which must be the start of a zone ID if it is not the end. The
+  // zone ID is then the remainder of the string.
+  if (run > max_v6_text_len)
+    return false;
+  const char* zone = first + run;
+  if (zone != last && *zone != '%')
+    return false;
+  if (run == 0 || parse_v6_groups(first, last, text, run, bytes) != run)
+    return false;
+
+  scope_id = (zone != last) ? parse_scope_id(zone + 1, last, bytes) : 0;
+  return true;
+}
+
+const char* parse_v4_prefix(const char* first, const char* last,
+    unsigned char* bytes)
+{
+  const char* p = first;
+  for (int i = 0; i < 4; ++i)
+  {
+    if (i != 0)
+    {
+      if (p == last || *p != '.')
+        return 0;
+      ++p;
+    }
+
+    if (p == last)
+      return 0;
+    unsigned value = decimal_value(*p);
+    if (value > 9)
+      return 0;
+    ++p;
+
+    // Take as many further digits as keep the octet valid. A leading zero
+    // must be the only digit in the octet.
+    for (unsigned digit, n = 1; value != 0 && n < 3 && p != last
+        && (digit = decimal_value(*p)) <= 9 && value * 10 + digit <= 255; ++n)
+    {
+      value = value * 10 + digit;
+      ++p;
+    }
+
+    bytes[i] = static_cast<unsigned char>(value);
+  }
+
+  return p;
+}
+
+const char* parse_v6_prefix(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id)
+{
+  v6_text text;
+  const std::size_t run = classify_v6(first, last, text);
+  const std::size_t length = parse_v6_groups(first, last, text, run, bytes);
+  if (length == 0)
+    return 0;
+
+  // A zone ID is only taken if it has at least one character.
+  const char* end = first + length;
+  scope_id = 0;
+  if (end != last && *end == '%' && end + 1 != last && is_zone_char(end[1]))
+  {
+    const char* zone = ++end;
+    while (end != last && is_zone_char(*end))
+      ++end;
+    scope_id = parse_scope_id(zone, end, bytes);
+  }
+
+  return end;
+}
+
+// Writes the address in lowercase hexadecimal, four characters per group, so
+// that each group can later be copied out without its leading zeros. The
+// output buffer must have room for 36 characters, the last 4 of which are
+// padding for those copies.
+inline void format_v6_hex(const unsigned char* bytes, char* hex)
+{
+  static const char hex_digits[] = "0123456789abcdef";
+  for (int i = 0; i < 16; ++i)
+  {
+    hex[2 * i] = hex_digits[bytes[i] >> 4];
+    hex[2 * i + 1] = hex_digits[bytes[i] & 0xf];
+  }
+  hex[32] = hex[33] = hex[34] = hex[35] = 0;
+}
+
+// Writes a zone ID, preferring the interface name for a link-local address, as
+// found in the interface cache.
+inline char* format_scope_id(const unsigned char* bytes,
+    unsigned long scope_id, char* out)
+{
+  *out++ = '%';
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+  const bool is_link_local = ((bytes[0] == 0xfe) && ((bytes[1] & 0xc0) == 0x80));
+  char if_name[IF_NAMESIZE];
+  if (is_link_local)
+  {
+    const std::size_t length =
+      interface_cache::index_to_name(scope_id, if_name);
+    if (length != 0 && length <= max_v6_scoped_text_len - max_v6_text_len - 1)
+    {
+      std::memcpy(out, if_name, length);
+      return out + length;
+    }
+  }
+#else // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+  (void)bytes;
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+  char digits[20];
+  int n = 0;
+  do
+    digits[n++] = static_cast<char>('0' + scope_id % 10);
+  while ((scope_id /= 10) != 0);
+  while (n > 0)
+    *out++ = digits[--n];
+  return out;
+}
+
+std::size_t format_v6(const unsigned char* bytes,
+    unsigned long scope_id, char* out)
+{
+  // Find the zero groups, one bit per group.
+  unsigned words[8];
+  unsigned zeros = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    words[i] = (bytes[2 * i] << 8) | bytes[2 * i + 1];
+    zeros |= static_cast<unsigned>(words[i] == 0) << i;
+  }
+
+  // Find the first of the longest runs of zero groups. Each step clears the
+  // last bit of every run, so the bits left before the final step mark where
+  // the longest runs start.
+  unsigned best_len = 0;
+  unsigned starts = 0;
+  for (unsigned runs = zeros; runs != 0; runs &= runs >> 1)
+    starts = runs, ++best_len;
+  const unsigned best_base = (best_len >= 2) ? bit_ops::lowest_bit(starts) : 8;
+  if (best_len < 2)
+    best_len = 0;
+
+  char hex[36];
+  format_v6_hex(bytes, hex);
+
+  char* p = out;
+  for (unsigned i = 0; i < 8; ++i)
+  {
+    if (i == best_base)
+    {
+      *p++ = ':';
+      i += best_len - 1;
+      continue;
+    }
+
+    if (i != 0)
+      *p++ = ':';
+
+    // An IPv4-compatible or IPv4-mapped address ends in dotted decimal form.
+    if (i == 6 && best_base == 0
+        && (best_len == 6 || (best_len == 5 && words[5] == 0xffff)))
+    {
+      p += format_v4(bytes + 12, p);
+      break;
+    }
+
+    // Four characters are always copied, so that there are no data-dependent
+    // branches, but only the significant digits form part of the result.
+    const unsigned digits = 1 + (words[i] > 0xf)
+      + (words[i] > 0xff) + (words[i] > 0xfff);
+    std::memcpy(p, hex + 4 * i + 4 - digits, 4);
+    p += digits;
+  }
+  if (best_len != 0 && best_base + best_len == 8)
+    *p++ = ':';
+
+  if (scope_id != 0)
+    p = format_scope_id(bytes, scope_id, p);
+
+  return static_cast<std::size_t>(p - out);
+}
+
+} // namespace text_ops
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_IMPL_TEXT_OPS_IPP
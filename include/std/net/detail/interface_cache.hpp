@@ -0,0 +1,69 @@
+//
+// detail/interface_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_INTERFACE_CACHE_HPP
+#define STDNET_DETAIL_INTERFACE_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+#include <cstddef>
+#include "std/net/detail/socket_types.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace interface_cache {
+
+// The cache is a process-wide table of interface indexes and names, as
+// reported by if_nameindex. Lookups do not block and do not make system calls
+// when the interface is in the table. The table is refreshed on the first
+// lookup after it expires, by whichever thread gets there first, and when a
+// lookup misses but the system then finds the interface. Without
+// STDNET_HAS_INTERFACE_CACHE these functions go straight to the system.
+
+// How long the table is used before it is refreshed, in milliseconds.
+const long refresh_interval_ms = 1000;
+
+// Find the index of the interface with the given name. Returns 0 if there is no
+// such interface.
+STDNET_DECL unsigned long name_to_index(const char* name, std::size_t length);
+
+// Find the name of the interface with the given index. The output buffer must
+// have room for IF_NAMESIZE characters, and the name is not null terminated.
+// Returns the length of the name, or 0 if there is no such interface.
+STDNET_DECL std::size_t index_to_name(unsigned long index, char* name);
+
+// Reload the table immediately, for use after interfaces are added or removed.
+STDNET_DECL void refresh();
+
+} // namespace interface_cache
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/detail/impl/interface_cache.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+
+#endif // STDNET_DETAIL_INTERFACE_CACHE_HPP
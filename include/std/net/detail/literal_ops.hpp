@@ -0,0 +1,287 @@
+//
+// detail/literal_ops.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_LITERAL_OPS_HPP
+#define STDNET_DETAIL_LITERAL_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace literal_ops {
+
+// Parsers for address literals that may be evaluated at compile time. They
+// accept the same text as text_ops::parse_v4 and text_ops::parse_v6, except
+// that a zone ID must be numeric, since an interface name can only be looked
+// up at run time. Each function is a single return statement, as required
+// for constexpr in C++11, and loops are written as recursion.
+
+// The result of parsing some or all of a string.
+struct v4_result
+{
+  bool ok;
+  unsigned long value;
+  std::size_t end;
+};
+
+struct v6_result
+{
+  bool ok;
+  unsigned long long high;
+  unsigned long long low;
+  unsigned long scope_id;
+};
+
+// The groups of an IPv6 address decoded so far. The head is the part before
+// any "::", with each group placed at its final position from the top of the
+// address. The tail is the part after the "::", and is shifted up as each
+// group is added at the bottom. The count of tail groups is -1 until a "::"
+// has been seen.
+struct v6_groups_state
+{
+  bool ok;
+  unsigned long long head_high;
+  unsigned long long head_low;
+  unsigned long long tail_high;
+  unsigned long long tail_low;
+  int head;
+  int tail;
+};
+
+inline STDNET_CONSTEXPR bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+inline STDNET_CONSTEXPR unsigned hex_value(char c)
+{
+  return (c >= '0' && c <= '9') ? static_cast<unsigned>(c - '0')
+    : (c >= 'a' && c <= 'f') ? static_cast<unsigned>(c - 'a' + 10)
+    : (c >= 'A' && c <= 'F') ? static_cast<unsigned>(c - 'A' + 10) : 16;
+}
+
+// Decodes the remaining digits of an octet, of which n have been taken, with
+// the given value.
+inline STDNET_CONSTEXPR v4_result v4_digits(const char* s, std::size_t end,
+    std::size_t p, std::size_t n, unsigned long value)
+{
+  return (n == 3 || p == end || !is_digit(s[p]))
+    ? v4_result{ true, value, p }
+    : value * 10 + (s[p] - '0') > 255
+    ? v4_result{ false, 0, p }
+    : v4_digits(s, end, p + 1, n + 1, value * 10 + (s[p] - '0'));
+}
+
+// Decodes an octet. A leading zero must be the only digit.
+inline STDNET_CONSTEXPR v4_result v4_octet(const char* s, std::size_t end,
+    std::size_t p)
+{
+  return (p == end || !is_digit(s[p])) ? v4_result{ false, 0, p }
+    : s[p] == '0' ? v4_result{ true, 0, p + 1 }
+    : v4_digits(s, end, p + 1, 1, static_cast<unsigned long>(s[p] - '0'));
+}
+
+// Appends an octet to the address decoded so far.
+inline STDNET_CONSTEXPR v4_result v4_append(const v4_result& r,
+    const v4_result& octet)
+{
+  return octet.ok ? v4_result{ true, (r.value << 8) | octet.value, octet.end }
+    : octet;
+}
+
+// Decodes the octets after the first n, each of which follows a dot.
+inline STDNET_CONSTEXPR v4_result v4_octets(const char* s, std::size_t end,
+    int n, const v4_result& r)
+{
+  return (!r.ok || n == 4) ? r
+    : (r.end == end || s[r.end] != '.') ? v4_result{ false, 0, r.end }
+    : v4_octets(s, end, n + 1, v4_append(r, v4_octet(s, end, r.end + 1)));
+}
+
+// Checks that the address occupies all of [p, end).
+inline STDNET_CONSTEXPR v4_result v4_finish(const v4_result& r,
+    std::size_t end)
+{
+  return r.end == end ? r : v4_result{ false, 0, r.end };
+}
+
+// Parses an IPv4 address that occupies all of [p, end).
+inline STDNET_CONSTEXPR v4_result parse_v4(const char* s, std::size_t end,
+    std::size_t p = 0)
+{
+  return v4_finish(v4_octets(s, end, 1, v4_octet(s, end, p)), end);
+}
+
+// Returns the number of hexadecimal digits starting at p.
+inline STDNET_CONSTEXPR std::size_t hex_run(const char* s, std::size_t end,
+    std::size_t p)
+{
+  return (p == end || hex_value(s[p]) > 15) ? 0 : 1 + hex_run(s, end, p + 1);
+}
+
+// Returns the value of the n hexadecimal digits starting at p.
+inline STDNET_CONSTEXPR unsigned long long hex_group(const char* s,
+    std::size_t p, std::size_t n)
+{
+  return n == 0 ? 0
+    : (hex_group(s, p, n - 1) << 4) | hex_value(s[p + n - 1]);
+}
+
+// Returns the position of the '%' that starts the zone ID, or the end.
+inline STDNET_CONSTEXPR std::size_t zone_start(const char* s, std::size_t len,
+    std::size_t p = 0)
+{
+  return (p == len || s[p] == '%') ? p : zone_start(s, len, p + 1);
+}
+
+// Decodes the digits of a numeric zone ID, which may be empty.
+inline STDNET_CONSTEXPR v6_result v6_zone(const char* s, std::size_t len,
+    std::size_t p, const v6_result& r)
+{
+  return (!r.ok || p == len) ? r
+    : !is_digit(s[p]) ? v6_result{ false, 0, 0, 0 }
+    : v6_zone(s, len, p + 1, v6_result{ true, r.high, r.low,
+        r.scope_id * 10 + static_cast<unsigned long>(s[p] - '0') });
+}
+
+inline STDNET_CONSTEXPR v6_groups_state v6_fail()
+{
+  return v6_groups_state{ false, 0, 0, 0, 0, 0, 0 };
+}
+
+// Adds count groups, holding the given value, to the head or the tail.
+inline STDNET_CONSTEXPR v6_groups_state v6_add(const v6_groups_state& g,
+    unsigned long long value, int count)
+{
+  return g.tail < 0
+    ? (g.head < 4
+        ? v6_groups_state{ true,
+          g.head_high | (value << (16 * (4 - g.head - count))), g.head_low,
+          0, 0, g.head + count, g.tail }
+        : v6_groups_state{ true, g.head_high,
+          g.head_low | (value << (16 * (8 - g.head - count))),
+          0, 0, g.head + count, g.tail })
+    : v6_groups_state{ true, g.head_high, g.head_low,
+      (g.tail_high << (16 * count)) | (g.tail_low >> (64 - 16 * count)),
+      (g.tail_low << (16 * count)) | value, g.head, g.tail + count };
+}
+
+// Notes the "::", after which groups are added to the tail.
+inline STDNET_CONSTEXPR v6_groups_state v6_compress(const v6_groups_state& g)
+{
+  return g.tail < 0 ? v6_groups_state{ true, g.head_high, g.head_low,
+    0, 0, g.head, 0 } : v6_fail();
+}
+
+// Combines the head and tail once all of the groups have been decoded.
+// Without a "::" there must be eight groups. With one, it must stand for at
+// least one group.
+inline STDNET_CONSTEXPR v6_result v6_finish(const v6_groups_state& g)
+{
+  return (g.ok && (g.tail < 0 ? g.head == 8 : g.head + g.tail < 8))
+    ? v6_result{ true, g.head_high | g.tail_high, g.head_low | g.tail_low, 0 }
+    : v6_result{ false, 0, 0, 0 };
+}
+
+inline STDNET_CONSTEXPR v6_result v6_groups(const char* s, std::size_t end,
+    std::size_t p, const v6_groups_state& g);
+
+// Continues after a group that ends at p, which may be followed only by a
+// colon or by a "::".
+inline STDNET_CONSTEXPR v6_result v6_separator(const char* s,
+    std::size_t end, std::size_t p, const v6_groups_state& g)
+{
+  return p == end ? v6_finish(g)
+    : s[p] != ':' ? v6_finish(v6_fail())
+    : (p + 1 != end && s[p + 1] == ':')
+    ? (p + 2 == end ? v6_finish(v6_compress(g))
+        : v6_groups(s, end, p + 2, v6_compress(g)))
+    : p + 1 == end ? v6_finish(v6_fail())
+    : v6_groups(s, end, p + 1, g);
+}
+
+// Adds an embedded IPv4 address, which must be the last part of the address.
+inline STDNET_CONSTEXPR v6_groups_state v6_embedded_v4(
+    const v6_groups_state& g, const v4_result& v4)
+{
+  return (v4.ok && (g.tail < 0 ? g.head == 6 : g.head + g.tail + 2 < 8))
+    ? v6_add(g, v4.value, 2) : v6_fail();
+}
+
+// Decodes the group, or embedded IPv4 address, that starts at p. A group has
+// one to four hexadecimal digits, and a run of them that is followed by a dot
+// starts an IPv4 address instead.
+inline STDNET_CONSTEXPR v6_result v6_group(const char* s, std::size_t end,
+    std::size_t p, std::size_t digits, const v6_groups_state& g)
+{
+  return !g.ok ? v6_finish(g)
+    : (p + digits != end && s[p + digits] == '.')
+    ? v6_finish(v6_embedded_v4(g, parse_v4(s, end, p)))
+    : (digits == 0 || digits > 4 || g.head + (g.tail < 0 ? 0 : g.tail) == 8)
+    ? v6_finish(v6_fail())
+    : v6_separator(s, end, p + digits, v6_add(g, hex_group(s, p, digits), 1));
+}
+
+inline STDNET_CONSTEXPR v6_result v6_groups(const char* s, std::size_t end,
+    std::size_t p, const v6_groups_state& g)
+{
+  return v6_group(s, end, p, hex_run(s, end, p), g);
+}
+
+// Parses the address part of an IPv6 address, which occupies [0, end). A
+// leading colon is only allowed as part of a "::".
+inline STDNET_CONSTEXPR v6_result v6_address(const char* s, std::size_t end)
+{
+  return (end != 0 && s[0] == ':')
+    ? ((end < 2 || s[1] != ':') ? v6_finish(v6_fail())
+        : v6_separator(s, end, 0, v6_groups_state{ true, 0, 0, 0, 0, 0, -1 }))
+    : v6_groups(s, end, 0, v6_groups_state{ true, 0, 0, 0, 0, 0, -1 });
+}
+
+// Parses an IPv6 address with an optional numeric zone ID.
+inline STDNET_CONSTEXPR v6_result parse_v6(const char* s, std::size_t len,
+    std::size_t zone)
+{
+  return zone == len ? v6_address(s, len)
+    : v6_zone(s, len, zone + 1, v6_address(s, zone));
+}
+
+inline STDNET_CONSTEXPR v6_result parse_v6(const char* s, std::size_t len)
+{
+  return parse_v6(s, len, zone_start(s, len));
+}
+
+// Returns whether the text is an IPv6 address rather than an IPv4 one, by the
+// same rule as make_address: a colon within the first five characters.
+inline STDNET_CONSTEXPR bool is_v6(const char* s, std::size_t len,
+    std::size_t p = 0)
+{
+  return (p == 5 || p == len) ? false
+    : s[p] == ':' ? true : is_v6(s, len, p + 1);
+}
+
+} // namespace literal_ops
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_LITERAL_OPS_HPP
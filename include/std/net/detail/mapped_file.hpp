@@ -0,0 +1,80 @@
+//
+// detail/mapped_file.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_MAPPED_FILE_HPP
+#define STDNET_DETAIL_MAPPED_FILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <system_error>
+
+#if !defined(STDNET_HAS_MMAP)
+# include <vector>
+#endif // !defined(STDNET_HAS_MMAP)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// The contents of a file, read-only. Where mmap is available the file is
+// mapped, so that pages are faulted in by whichever thread first touches
+// them. Otherwise the file is read into memory in one go.
+class mapped_file
+{
+public:
+  STDNET_DECL mapped_file() STDNET_NOEXCEPT;
+
+  STDNET_DECL ~mapped_file();
+
+  // Opens and maps the file, replacing any contents already held.
+  STDNET_DECL void open(const char* path, std::error_code& ec);
+
+  const char* data() const STDNET_NOEXCEPT
+  {
+    return data_;
+  }
+
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return size_;
+  }
+
+private:
+  mapped_file(const mapped_file&) STDNET_DELETED;
+  mapped_file& operator=(const mapped_file&) STDNET_DELETED;
+
+  STDNET_DECL void close() STDNET_NOEXCEPT;
+
+  const char* data_;
+  std::size_t size_;
+#if !defined(STDNET_HAS_MMAP)
+  std::vector<char> buffer_;
+#endif // !defined(STDNET_HAS_MMAP)
+};
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/detail/impl/mapped_file.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_DETAIL_MAPPED_FILE_HPP
@@ -0,0 +1,106 @@
+//
+// detail/ostream_ops.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_OSTREAM_OPS_HPP
+#define STDNET_DETAIL_OSTREAM_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if !defined(STDNET_NO_IOSTREAM)
+
+#include <cstddef>
+#include <ios>
+#include <locale>
+#include <ostream>
+#include "std/net/detail/text_ops.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace ostream_ops {
+
+// Write address text to a stream as a single formatted field. The text is
+// widened in one call to the stream's ctype facet and handed to the stream
+// buffer in one call, with padding applied according to the stream's width,
+// fill and adjustment. The text must be no longer than the longest text
+// produced by text_ops::format_v6.
+template <typename Elem, typename Traits>
+void write_text(std::basic_ostream<Elem, Traits>& os,
+    const char* text, std::size_t length)
+{
+  typedef std::basic_ostream<Elem, Traits> ostream_type;
+  typename ostream_type::sentry ok(os);
+  if (!ok)
+    return;
+
+  std::ios_base::iostate state = std::ios_base::goodbit;
+#if !defined(STDNET_NO_EXCEPTIONS)
+  try
+  {
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+    Elem wide_text[text_ops::max_v6_scoped_text_len];
+    std::use_facet<std::ctype<Elem> >(os.getloc()).widen(
+        text, text + length, wide_text);
+
+    const std::streamsize size = static_cast<std::streamsize>(length);
+    const std::streamsize padding = os.width() > size ? os.width() - size : 0;
+    const bool pad_left = (os.flags() & std::ios_base::adjustfield)
+      != std::ios_base::left;
+
+    std::basic_streambuf<Elem, Traits>* buffer = os.rdbuf();
+    for (std::streamsize i = 0; pad_left && i < padding; ++i)
+      if (Traits::eq_int_type(buffer->sputc(os.fill()), Traits::eof()))
+        state |= std::ios_base::badbit;
+    if (buffer->sputn(wide_text, size) != size)
+      state |= std::ios_base::badbit;
+    for (std::streamsize i = 0; !pad_left && i < padding; ++i)
+      if (Traits::eq_int_type(buffer->sputc(os.fill()), Traits::eof()))
+        state |= std::ios_base::badbit;
+
+    os.width(0);
+#if !defined(STDNET_NO_EXCEPTIONS)
+  }
+  catch (...)
+  {
+    try
+    {
+      os.setstate(std::ios_base::badbit);
+    }
+    catch (...)
+    {
+    }
+    if (os.exceptions() & std::ios_base::badbit)
+      throw;
+    return;
+  }
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+
+  if (state != std::ios_base::goodbit)
+    os.setstate(state);
+}
+
+} // namespace ostream_ops
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // !defined(STDNET_NO_IOSTREAM)
+
+#endif // STDNET_DETAIL_OSTREAM_OPS_HPP
@@ -0,0 +1,45 @@
+//
+// detail/prefetch.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_PREFETCH_HPP
+#define STDNET_DETAIL_PREFETCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// Hint that the cache line holding the given address will soon be read. This
+// does nothing where the compiler has no prefetch builtin.
+inline void prefetch(const void* p)
+{
+#if defined(STDNET_HAS_BUILTIN_PREFETCH)
+  __builtin_prefetch(p);
+#else // defined(STDNET_HAS_BUILTIN_PREFETCH)
+  (void)p;
+#endif // defined(STDNET_HAS_BUILTIN_PREFETCH)
+}
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_DETAIL_PREFETCH_HPP
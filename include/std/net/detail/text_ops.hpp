@@ -0,0 +1,97 @@
+//
+// detail/text_ops.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_TEXT_OPS_HPP
+#define STDNET_DETAIL_TEXT_OPS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+namespace text_ops {
+
+// The longest valid IPv4 address in dotted decimal form, "255.255.255.255".
+const std::size_t max_v4_text_len = 15;
+
+// Parse an IPv4 address in dotted decimal form. The whole of the range
+// [first, last) must be consumed, with the same rules as inet_pton(AF_INET):
+// exactly four decimal octets, no leading zeros and no trailing characters. On
+// success the address is stored in network byte order.
+STDNET_DECL bool parse_v4(const char* first, const char* last,
+    unsigned char* bytes);
+
+// Format an IPv4 address, given in network byte order, in dotted decimal form.
+// The output buffer must have room for max_v4_text_len + 1 characters, although
+// no more than max_v4_text_len form part of the result. Returns the number of
+// characters in the result.
+STDNET_DECL std::size_t format_v4(const unsigned char* bytes, char* out);
+
+// The longest valid IPv6 address in text form, excluding any zone ID,
+// "ffff:ffff:ffff:ffff:ffff:ffff:255.255.255.255".
+const std::size_t max_v6_text_len = 45;
+
+// Parse an IPv6 address in the text form described by RFC 4291, optionally
+// followed by a '%' and a zone ID. The whole of the range [first, last) must be
+// consumed. The address part is subject to the same rules as
+// inet_pton(AF_INET6). A numeric zone ID is decoded directly, while the zone ID
+// of a link-local address may also name an interface. On success the address
+// is stored in network byte order.
+STDNET_DECL bool parse_v6(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id);
+
+// The longest IPv6 address text produced by format_v6. This allows for a zone
+// ID given as the largest 64-bit number, which is longer than any interface
+// name that is used in its place.
+const std::size_t max_v6_scoped_text_len = max_v6_text_len + 1 + 20;
+
+// Format an IPv6 address, given in network byte order, in the form produced by
+// inet_ntop(AF_INET6). A non-zero scope ID is appended as a zone ID, using the
+// interface name for a link-local address where one is available. The output
+// buffer must have room for max_v6_scoped_text_len + 3 characters, although no
+// more than max_v6_scoped_text_len form part of the result. Returns the number
+// of characters in the result.
+STDNET_DECL std::size_t format_v6(const unsigned char* bytes,
+    unsigned long scope_id, char* out);
+
+// Parse the longest prefix of [first, last) that is a valid IPv4 address in
+// dotted decimal form. Returns a pointer to the end of the prefix, or 0 if no
+// prefix is valid.
+STDNET_DECL const char* parse_v4_prefix(const char* first, const char* last,
+    unsigned char* bytes);
+
+// Parse the longest prefix of [first, last) that is a valid IPv6 address. A
+// zone ID is included if the address is followed by a '%' and at least one
+// character permitted by RFC 6874. Returns a pointer to the end of the prefix,
+// or 0 if no prefix is valid.
+STDNET_DECL const char* parse_v6_prefix(const char* first, const char* last,
+    unsigned char* bytes, unsigned long& scope_id);
+
+} // namespace text_ops
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/detail/impl/text_ops.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_DETAIL_TEXT_OPS_HPP
@@ -37,6 +37,16 @@ void throw_exception(const Exception& e)
 }
 # endif // !defined(STDNET_NO_EXCEPTIONS)
 
+// Throw an exception where an expression of type T is needed, such as in one
+// arm of a conditional expression in a constexpr function. As with a throw
+// expression, a constant expression that reaches it is ill-formed.
+template <typename T, typename Exception>
+inline T throw_exception_as(const Exception& e)
+{
+  throw_exception(e);
+  return T();
+}
+
 } // namespace detail
 } // namespace net
 } // namespace experimental
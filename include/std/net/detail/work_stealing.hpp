@@ -0,0 +1,205 @@
+//
+// detail/work_stealing.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_DETAIL_WORK_STEALING_HPP
+#define STDNET_DETAIL_WORK_STEALING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// A range of task indexes belonging to one worker. The front and back of the
+// range share a single atomic word, so that the owner taking from the front
+// and a thief taking from the back each need only one compare-and-swap, and
+// can never both take the last task. Ranges are padded so that workers do not
+// share cache lines.
+class work_stealing_range
+{
+public:
+  work_stealing_range() STDNET_NOEXCEPT
+    : range_(0)
+  {
+  }
+
+  void assign(std::size_t first, std::size_t last) STDNET_NOEXCEPT
+  {
+    range_.store(pack(first, last), std::memory_order_relaxed);
+  }
+
+  // Takes the task at the front of the range. Used by the owner.
+  bool pop(std::size_t& task) STDNET_NOEXCEPT
+  {
+    std::uint64_t r = range_.load(std::memory_order_relaxed);
+    while (front(r) < back(r))
+    {
+      if (range_.compare_exchange_weak(r, pack(front(r) + 1, back(r)),
+            std::memory_order_relaxed))
+      {
+        task = front(r);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Takes the task at the back of the range. Used by other workers, so that
+  // they take the work furthest from what the owner is doing.
+  bool steal(std::size_t& task) STDNET_NOEXCEPT
+  {
+    std::uint64_t r = range_.load(std::memory_order_relaxed);
+    while (front(r) < back(r))
+    {
+      if (range_.compare_exchange_weak(r, pack(front(r), back(r) - 1),
+            std::memory_order_relaxed))
+      {
+        task = back(r) - 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  static std::uint64_t pack(std::size_t first, std::size_t last)
+  {
+    return (static_cast<std::uint64_t>(first) << 32) | last;
+  }
+
+  static std::size_t front(std::uint64_t r)
+  {
+    return static_cast<std::size_t>(r >> 32);
+  }
+
+  static std::size_t back(std::uint64_t r)
+  {
+    return static_cast<std::size_t>(r & 0xFFFFFFFF);
+  }
+
+  char pad0_[64];
+  std::atomic<std::uint64_t> range_;
+  char pad1_[64];
+};
+
+// Calls f(task) once for each task in [0, count), on the calling thread and
+// threads - 1 others. Each worker starts with an equal share of the tasks, in
+// order, and once its own are done it steals from the others, so that uneven
+// tasks still keep every worker busy. The count must fit in 32 bits. An
+// exception thrown by f stops the remaining tasks from starting, and is
+// rethrown once all of the threads have finished.
+template <typename Function>
+void run_work_stealing(std::size_t count, std::size_t threads, Function f)
+{
+  if (threads > count)
+    threads = count;
+  if (threads <= 1)
+  {
+    for (std::size_t task = 0; task < count; ++task)
+      f(task);
+    return;
+  }
+
+  std::vector<work_stealing_range> ranges(threads);
+  for (std::size_t i = 0; i < threads; ++i)
+    ranges[i].assign(count * i / threads, count * (i + 1) / threads);
+
+  std::atomic<bool> failed(false);
+  std::vector<std::exception_ptr> errors(threads);
+
+  struct worker
+  {
+    static void run(std::vector<work_stealing_range>& ranges,
+        std::size_t self, Function& f, std::atomic<bool>& failed,
+        std::exception_ptr& error)
+    {
+#if !defined(STDNET_NO_EXCEPTIONS)
+      try
+      {
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+        const std::size_t n = ranges.size();
+        std::size_t task;
+        while (!failed.load(std::memory_order_relaxed)
+            && ranges[self].pop(task))
+          f(task);
+
+        for (std::size_t i = 1; i < n; ++i)
+          while (!failed.load(std::memory_order_relaxed)
+              && ranges[(self + i) % n].steal(task))
+            f(task);
+#if !defined(STDNET_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        error = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+      }
+#else // !defined(STDNET_NO_EXCEPTIONS)
+      (void)error;
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+#if !defined(STDNET_NO_EXCEPTIONS)
+  try
+  {
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+    for (std::size_t i = 1; i < threads; ++i)
+      pool.push_back(std::thread(&worker::run, std::ref(ranges), i,
+            std::ref(f), std::ref(failed), std::ref(errors[i])));
+#if !defined(STDNET_NO_EXCEPTIONS)
+  }
+  catch (...)
+  {
+    // Too few threads could be started. The calling thread steals whatever
+    // the missing workers would have done.
+  }
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+
+  worker::run(ranges, 0, f, failed, errors[0]);
+  for (std::size_t i = 0; i < pool.size(); ++i)
+    pool[i].join();
+
+#if !defined(STDNET_NO_EXCEPTIONS)
+  for (std::size_t i = 0; i < threads; ++i)
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+#endif // !defined(STDNET_NO_EXCEPTIONS)
+}
+
+} // namespace detail
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#endif // STDNET_DETAIL_WORK_STEALING_HPP
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -23,6 +25,10 @@
 #include "std/net/ip/address_v4.hpp"
 #include "std/net/ip/address_v6.hpp"
 
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
 #if !defined(STDNET_NO_IOSTREAM)
 # include <iosfwd>
 #endif // !defined(STDNET_NO_IOSTREAM)
@@ -67,9 +73,9 @@ class address
 public:
   /// Default constructor.
   STDNET_CONSTEXPR address() STDNET_NOEXCEPT
-    : type_(invalid),
-      ipv4_address_(),
-      ipv6_address_()
+    : bytes_(),
+      scope_id_(0),
+      type_(invalid)
   {
   }
 
@@ -113,41 +119,19 @@ public:
 #endif // defined(STDNET_HAS_VARIADIC_TEMPLATES)
 
   /// Copy constructor.
-  STDNET_CONSTEXPR address(const address& other) STDNET_NOEXCEPT
-    : type_(other.type_),
-      ipv4_address_(other.ipv4_address_),
-      ipv6_address_(other.ipv6_address_)
-  {
-  }
+  STDNET_CONSTEXPR address(const address& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move constructor.
-  address(address&& other) STDNET_NOEXCEPT
-    : type_(other.type_),
-      ipv4_address_(other.ipv4_address_),
-      ipv6_address_(other.ipv6_address_)
-  {
-  }
+  STDNET_CONSTEXPR address(address&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// Assign from another address.
-  address& operator=(const address& other) STDNET_NOEXCEPT
-  {
-    type_ = other.type_;
-    ipv4_address_ = other.ipv4_address_;
-    ipv6_address_ = other.ipv6_address_;
-    return *this;
-  }
+  address& operator=(const address& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move-assign from another address.
-  address& operator=(address&& other) STDNET_NOEXCEPT
-  {
-    type_ = other.type_;
-    ipv4_address_ = other.ipv4_address_;
-    ipv6_address_ = other.ipv6_address_;
-    return *this;
-  }
+  address& operator=(address&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// Get whether the address is an IP version 4 address.
@@ -171,22 +155,22 @@ public:
   /// Determine whether the address is a loopback address.
   STDNET_CONSTEXPR bool is_loopback() const STDNET_NOEXCEPT
   {
-    return (type_ == ipv4) ? ipv4_address_.is_loopback() :
-      (type_ == ipv6) ? ipv6_address_.is_loopback() : false;
+    return (type_ == ipv4) ? v4().is_loopback() :
+      (type_ == ipv6) ? v6().is_loopback() : false;
   }
 
   /// Determine whether the address is unspecified.
   STDNET_CONSTEXPR bool is_unspecified() const STDNET_NOEXCEPT
   {
-    return (type_ == ipv4) ? ipv4_address_.is_unspecified() :
-      (type_ == ipv6) ? ipv6_address_.is_unspecified() : false;
+    return (type_ == ipv4) ? v4().is_unspecified() :
+      (type_ == ipv6) ? v6().is_unspecified() : false;
   }
 
   /// Determine whether the address is a multicast address.
   STDNET_CONSTEXPR bool is_multicast() const STDNET_NOEXCEPT
   {
-    return (type_ == ipv4) ? ipv4_address_.is_multicast() :
-      (type_ == ipv6) ? ipv6_address_.is_multicast() : false;
+    return (type_ == ipv4) ? v4().is_multicast() :
+      (type_ == ipv6) ? v6().is_multicast() : false;
   }
 
   /// Compare two addresses for equality.
@@ -196,9 +180,9 @@ public:
     if (a1.type_ != a2.type_)
       return false;
     if (a1.type_ == address::ipv4)
-      return a1.ipv4_address_ == a2.ipv4_address_;
+      return a1.bytes_.v4 == a2.bytes_.v4;
     if (a1.type_ == address::ipv6)
-      return a1.ipv4_address_ == a2.ipv4_address_;
+      return a1.bytes_.v6 == a2.bytes_.v6 && a1.scope_id_ == a2.scope_id_;
     return true;
   }
 
@@ -217,9 +201,9 @@ public:
     if (a1.type_ > a2.type_)
       return false;
     if (a1.type_ == address::ipv4)
-      return a1.ipv4_address_ < a2.ipv4_address_;
+      return a1.v4() < a2.v4();
     if (a1.type_ == address::ipv6)
-      return a1.ipv6_address_ < a2.ipv6_address_;
+      return a1.v6() < a2.v6();
     return false;
   }
 
@@ -246,21 +230,65 @@ private:
   friend class address_v6;
 
   // The type of the address.
-  enum address_type { invalid, ipv4, ipv6 } type_;
+  enum address_type { invalid, ipv4, ipv6 };
+
+  // The address value. Only the member for the type of the address is used, so
+  // the two families share storage. An IPv4 address is held as an address_v4,
+  // in host byte order, and an IPv6 address as bytes in network byte order.
+  union storage_type
+  {
+    STDNET_CONSTEXPR storage_type() STDNET_NOEXCEPT
+      : v6()
+    {
+    }
+
+    STDNET_CONSTEXPR storage_type(const address_v4& addr) STDNET_NOEXCEPT
+      : v4(addr)
+    {
+    }
+
+    STDNET_CONSTEXPR storage_type(
+        const address_v6::bytes_type& bytes) STDNET_NOEXCEPT
+      : v6(bytes)
+    {
+    }
+
+    address_v4 v4;
+    address_v6::bytes_type v6;
+  } bytes_;
+
+  // The scope ID of an IPv6 address. This is held in 32 bits, the width of
+  // sin6_scope_id, so that an address fits in 24 bytes.
+  unsigned int scope_id_;
+
+  // The type of the address, held in a single byte.
+  unsigned char type_;
+
+  // Helper constructors for address_cast.
+  STDNET_CONSTEXPR address(const address_v4& v4, address_type type)
+    : bytes_(v4),
+      scope_id_(0),
+      type_(static_cast<unsigned char>(type))
+  {
+  }
 
-  // The underlying IPv4 address.
-  address_v4 ipv4_address_;
+  STDNET_CONSTEXPR address(const address_v6& v6, address_type type)
+    : bytes_(v6.to_bytes()),
+      scope_id_(static_cast<unsigned int>(v6.scope_id())),
+      type_(static_cast<unsigned char>(type))
+  {
+  }
 
-  // The underlying IPv6 address.
-  address_v6 ipv6_address_;
+  // Helpers to get the family-specific address. The type must already have
+  // been checked.
+  STDNET_CONSTEXPR address_v4 v4() const
+  {
+    return bytes_.v4;
+  }
 
-  // Helper constructor for address_cast.
-  STDNET_CONSTEXPR address(address_type type,
-      const address_v4& v4, const address_v6& v6)
-    : type_(type),
-      ipv4_address_(v4),
-      ipv6_address_(v6)
+  STDNET_CONSTEXPR address_v6 v6() const
   {
+    return address_v6(bytes_.v6, scope_id_);
   }
 
   template <class T> friend STDNET_CONSTEXPR T address_cast(const address&,
@@ -273,6 +301,13 @@ private:
     typename enable_if<is_same<T, address>::value>::type*) STDNET_NOEXCEPT;
 };
 
+#if defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_trivially_copyable<address>::value,
+    "address must be trivially copyable");
+#endif // defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_standard_layout<address>::value,
+    "address must be standard layout");
+
 /// Create an address from an IPv4 address string in dotted decimal form,
 /// or from an IPv6 address in hexadecimal notation.
 STDNET_DECL address make_address(const char* str);
@@ -291,6 +326,103 @@ STDNET_DECL address make_address(const std::string& str);
 STDNET_DECL address make_address(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT;
 
+/// Create an address from an IPv4 address string in dotted decimal form,
+/// or from an IPv6 address in hexadecimal notation.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address make_address(const char* str, std::size_t len);
+
+/// Create an address from an IPv4 address string in dotted decimal form,
+/// or from an IPv6 address in hexadecimal notation.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address make_address(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Create an address from an IPv4 address string in dotted decimal form,
+/// or from an IPv6 address in hexadecimal notation.
+STDNET_DECL address make_address(std::string_view str);
+
+/// Create an address from an IPv4 address string in dotted decimal form,
+/// or from an IPv6 address in hexadecimal notation.
+STDNET_DECL address make_address(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an address from the start of a character sequence.
+/**
+ * Parses the longest prefix of [first, last) that is an IPv4 address in dotted decimal form or an IPv6 address.
+ *
+ * A zone ID is included only if the '%' is followed by at least one character
+ * permitted in a zone ID by RFC 6874.
+ *
+ * @returns On success, @c ptr points to the first character not parsed, @c ec
+ * is value-initialised and @c addr holds the parsed address. Otherwise, @c ptr
+ * is equal to @c first, @c ec is @c std::errc::invalid_argument, and @c addr
+ * is unmodified.
+ */
+STDNET_DECL from_chars_result from_chars(const char* first, const char* last,
+    address& addr) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 or IPv6 address string, without exceptions.
+/**
+ * Accepts the same text as make_address, but reports failure in the result
+ * rather than through an exception or a std::error_code. No memory is
+ * allocated.
+ *
+ * @returns The address, or @c std::errc::invalid_argument if the string is
+ * not a valid address.
+ */
+STDNET_DECL parse_result<address> parse_address(const char* str) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 or IPv6 address string, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address> parse_address(
+    const std::string& str) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 or IPv6 address string, without exceptions.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL parse_result<address> parse_address(const char* str,
+    std::size_t len) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an IPv4 or IPv6 address string, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address> parse_address(
+    std::string_view str) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Write an address to a character buffer.
+/**
+ * The address is written as for the to_chars overload for its family. The
+ * text is not NUL-terminated. No memory is allocated.
+ *
+ * @returns On success, @c ptr points one past the last character written and
+ * @c ec is value-initialised. If the address is of neither family, @c ptr is
+ * equal to @c first and @c ec is @c std::errc::invalid_argument. If the buffer
+ * is too small, @c ptr is equal to @c last, @c ec is
+ * @c std::errc::value_too_large, and the contents of the buffer are
+ * unspecified.
+ */
+STDNET_DECL to_chars_result to_chars(char* first, char* last,
+    const address& addr) STDNET_NOEXCEPT;
+
 #if !defined(STDNET_NO_IOSTREAM)
 
 /// Output an address as a string.
@@ -325,4 +457,38 @@ std::basic_ostream<Elem, Traits>& operator<<(
 
 #include "std/net/ip/address_cast.hpp"
 
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+
+/// Hash support for version-independent IP addresses.
+/**
+ * The hash of an IPv4 or IPv6 address is the same as the hash of the
+ * corresponding address_v4 or address_v6.
+ */
+template <>
+struct hash<std::experimental::net::ip::address>
+{
+  typedef std::experimental::net::ip::address argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(
+      const std::experimental::net::ip::address& addr) const STDNET_NOEXCEPT
+  {
+    using std::experimental::net::ip::address_cast;
+    using std::experimental::net::ip::address_v4;
+    using std::experimental::net::ip::address_v6;
+
+    if (addr.is_v4())
+      return hash<address_v4>()(address_cast<address_v4>(addr));
+    if (addr.is_v6())
+      return hash<address_v6>()(address_cast<address_v6>(addr));
+    return 0;
+  }
+};
+
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
 #endif // STDNET_IP_ADDRESS_HPP
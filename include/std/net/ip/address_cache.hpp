@@ -0,0 +1,322 @@
+//
+// ip/address_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_ADDRESS_CACHE_HPP
+#define STDNET_IP_ADDRESS_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "std/net/ip/address.hpp"
+#include "std/net/ip/fwd.hpp"
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// A bounded cache of parsed address strings.
+/**
+ * The ip::address_cache class sits in front of make_address for workloads in
+ * which the same strings recur, such as logs of traffic through a small
+ * number of gateways. Each string that parses successfully is remembered,
+ * keyed on its characters, so that when it is seen again the address is
+ * copied from the cache and the string is not parsed.
+ *
+ * The cache holds at most capacity() strings. It is two-way set associative:
+ * a string may be held in either of two entries chosen by a hash of its
+ * characters, and when both are in use the less recently used one is
+ * replaced. Strings that are not valid addresses, and strings longer than
+ * @c max_key_length characters, are always parsed and are never cached.
+ *
+ * Results are those of make_address, with one exception. A zone ID that
+ * names an interface, as in "fe80::1%eth0", is resolved to an interface index
+ * when the string is first parsed, and that index is cached with the address.
+ * If interfaces are later renumbered, the cached scope ID may no longer match
+ * what make_address would give; call clear() after such a change. The cache
+ * counts its hits and misses, where a miss is any call that parses the
+ * string.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe, since every lookup updates the cache. Use one
+ * cache for each thread, for example as a @c thread_local object.
+ */
+class address_cache
+{
+public:
+  /// The longest string that is cached.
+  static const std::size_t max_key_length = 35;
+
+  /// The capacity used by the default constructor.
+  static const std::size_t default_capacity = 4096;
+
+  /// Construct an empty cache.
+  /**
+   * The capacity is rounded up to a power of two, and is at least two.
+   */
+  STDNET_DECL explicit address_cache(
+      std::size_t capacity = default_capacity);
+
+  /// Get the maximum number of strings held in the cache.
+  std::size_t capacity() const STDNET_NOEXCEPT
+  {
+    return entries_.size();
+  }
+
+  /// Get the number of lookups that found the string in the cache.
+  std::uint64_t hits() const STDNET_NOEXCEPT
+  {
+    return hits_;
+  }
+
+  /// Get the number of lookups that parsed the string.
+  std::uint64_t misses() const STDNET_NOEXCEPT
+  {
+    return misses_;
+  }
+
+  /// Remove all strings from the cache and reset the counters.
+  STDNET_DECL void clear() STDNET_NOEXCEPT;
+
+  /// Parse an address string, using the cache.
+  /**
+   * As for parse_address. The string need not be NUL-terminated.
+   */
+  parse_result<address> parse(const char* str,
+      std::size_t len) STDNET_NOEXCEPT
+  {
+    if (len != 0 && len <= max_key_length)
+    {
+      const std::uint32_t h = hash(str, len);
+      entry* e = &entries_[(h & set_mask_) * 2];
+      if (matches(e[0], h, str, len))
+      {
+        ++hits_;
+        return e[0].value;
+      }
+      if (matches(e[1], h, str, len))
+      {
+        ++hits_;
+        promote(e);
+        return e[0].value;
+      }
+      return insert(e, h, str, len);
+    }
+
+    ++misses_;
+    return parse_address(str, len);
+  }
+
+  /// Parse an address string, using the cache.
+  /**
+   * As for parse_address.
+   */
+  parse_result<address> parse(const std::string& str) STDNET_NOEXCEPT
+  {
+    return parse(str.data(), str.size());
+  }
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+  /// Parse an address string, using the cache.
+  /**
+   * As for parse_address.
+   */
+  parse_result<address> parse(std::string_view str) STDNET_NOEXCEPT
+  {
+    return parse(str.data(), str.size());
+  }
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const char* str);
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const char* str,
+      std::error_code& ec) STDNET_NOEXCEPT;
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const std::string& str);
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const std::string& str,
+      std::error_code& ec) STDNET_NOEXCEPT;
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const char* str, std::size_t len);
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(const char* str, std::size_t len,
+      std::error_code& ec) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(std::string_view str);
+
+  /// Create an address from a string, using the cache.
+  /**
+   * As for the make_address overload with the same parameters.
+   */
+  STDNET_DECL address make_address(std::string_view str,
+      std::error_code& ec) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+private:
+  // An entry is the size of a cache line. A length of zero marks an unused
+  // entry, since the empty string is never a valid address.
+  struct entry
+  {
+    address value;
+    std::uint32_t hash;
+    unsigned char length;
+    char text[max_key_length];
+  };
+
+  // Hash the characters of a string eight at a time. The first and last eight,
+  // or four for a shorter string, are loaded so that they may overlap, which
+  // covers every IPv4 address without a loop or a copy of variable length.
+  // Only the low bits select a set, and the full value is compared before the
+  // characters are.
+  static std::uint32_t hash(const char* str, std::size_t len) STDNET_NOEXCEPT
+  {
+    std::uint64_t h;
+    if (len >= 8)
+    {
+      h = mix(len, load(str, 8));
+      for (std::size_t i = 8; i + 8 < len; i += 8)
+        h = mix(h, load(str + i, 8));
+      h = mix(h, load(str + len - 8, 8));
+    }
+    else if (len >= 4)
+    {
+      h = mix(len, load(str, 4) | (load(str + len - 4, 4) << 32));
+    }
+    else
+    {
+      h = mix(len, static_cast<unsigned char>(str[0])
+          | (static_cast<std::uint64_t>(static_cast<unsigned char>(
+                str[len / 2])) << 8)
+          | (static_cast<std::uint64_t>(static_cast<unsigned char>(
+                str[len - 1])) << 16));
+    }
+    return static_cast<std::uint32_t>(h >> 32);
+  }
+
+  static std::uint64_t mix(std::uint64_t h, std::uint64_t w) STDNET_NOEXCEPT
+  {
+    h = (h ^ w) * 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 29);
+  }
+
+  // Load n bytes, where n is 4 or 8, in host byte order.
+  static std::uint64_t load(const char* p, std::size_t n) STDNET_NOEXCEPT
+  {
+    if (n == 8)
+    {
+      std::uint64_t w;
+      std::memcpy(&w, p, 8);
+      return w;
+    }
+    std::uint32_t w;
+    std::memcpy(&w, p, 4);
+    return w;
+  }
+
+  static bool matches(const entry& e, std::uint32_t h, const char* str,
+      std::size_t len) STDNET_NOEXCEPT
+  {
+    return e.hash == h && e.length == len && equal(e.text, str, len);
+  }
+
+  // Compare two strings of the same length, which is from 1 to
+  // max_key_length, with the same loads as the hash.
+  static bool equal(const char* a, const char* b,
+      std::size_t len) STDNET_NOEXCEPT
+  {
+    if (len >= 8)
+    {
+      std::uint64_t diff = (load(a, 8) ^ load(b, 8))
+        | (load(a + len - 8, 8) ^ load(b + len - 8, 8));
+      for (std::size_t i = 8; i + 8 < len; i += 8)
+        diff |= load(a + i, 8) ^ load(b + i, 8);
+      return diff == 0;
+    }
+    if (len >= 4)
+      return ((load(a, 4) ^ load(b, 4))
+          | (load(a + len - 4, 4) ^ load(b + len - 4, 4))) == 0;
+    return std::memcmp(a, b, len) == 0;
+  }
+
+  // Swap the two entries of a set, so that the more recently used one is
+  // first.
+  STDNET_DECL static void promote(entry* set) STDNET_NOEXCEPT;
+
+  // Parse a string that is not in the cache and, if it is valid, replace the
+  // second entry of its set with the first and the first with the string.
+  STDNET_DECL parse_result<address> insert(entry* set, std::uint32_t h,
+      const char* str, std::size_t len) STDNET_NOEXCEPT;
+
+  // The entries, in sets of two.
+  std::vector<entry> entries_;
+
+  // The number of sets less one.
+  std::uint32_t set_mask_;
+
+  std::uint64_t hits_;
+  std::uint64_t misses_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/address_cache.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_IP_ADDRESS_CACHE_HPP
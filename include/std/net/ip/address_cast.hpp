@@ -47,8 +47,8 @@ inline STDNET_CONSTEXPR T address_cast(const address& addr,
     typename enable_if<is_same<T, address_v4>::value>::type*)
 {
   return (addr.type_ != address::ipv4)
-    ? throw bad_address_cast()
-    : addr.ipv4_address_;
+    ? std::experimental::net::detail::throw_exception_as<address_v4>(bad_address_cast())
+    : addr.v4();
 }
 
 /// Cast a version-independent address to an IPv6 address.
@@ -60,8 +60,8 @@ inline STDNET_CONSTEXPR T address_cast(const address& addr,
     typename enable_if<is_same<T, address_v6>::value>::type*)
 {
   return (addr.type_ != address::ipv6)
-    ? throw bad_address_cast()
-    : addr.ipv6_address_;
+    ? std::experimental::net::detail::throw_exception_as<address_v6>(bad_address_cast())
+    : addr.v6();
 }
 
 /// Cast an IPv4 address to a version-independent address.
@@ -69,7 +69,7 @@ template <class T>
 inline STDNET_CONSTEXPR T address_cast(const address_v4& addr,
     typename enable_if<is_same<T, address>::value>::type*) STDNET_NOEXCEPT
 {
-  return address(address::ipv4, addr, address_v6());
+  return address(addr, address::ipv4);
 }
 
 /// Cast an IPv4 address to itself.
@@ -85,7 +85,7 @@ template <class T>
 inline STDNET_CONSTEXPR T address_cast(const address_v6& addr,
     typename enable_if<is_same<T, address>::value>::type*) STDNET_NOEXCEPT
 {
-  return address(address::ipv6, address_v4(), addr);
+  return address(addr, address::ipv6);
 }
 
 /// Cast an IPv6 address to itself.
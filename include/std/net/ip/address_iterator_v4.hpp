@@ -0,0 +1,220 @@
+//
+// ip/address_iterator_v4.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_ADDRESS_ITERATOR_V4_HPP
+#define STDNET_IP_ADDRESS_ITERATOR_V4_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "std/net/ip/address_v4.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// An iterator that can be used for traversing IPv4 addresses.
+/**
+ * The iterator is random-access, so that the distance between two iterators
+ * and the address a given number of steps away are found in constant time.
+ * An iterator may point one past 255.255.255.255, so that a range may include
+ * every address.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class address_iterator_v4
+{
+public:
+  /// The type of the elements pointed to by the iterator.
+  typedef address_v4 value_type;
+
+  /// Distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The type of a pointer to an element pointed to by the iterator.
+  typedef const address_v4* pointer;
+
+  /// The type of a reference to an element pointed to by the iterator.
+  typedef const address_v4& reference;
+
+  /// Denotes that the iterator satisfies the random access iterator
+  /// requirements.
+  typedef std::random_access_iterator_tag iterator_category;
+
+  /// Construct an iterator that points to the specified address.
+  explicit address_iterator_v4(const address_v4& addr) STDNET_NOEXCEPT
+    : address_(addr),
+      past_end_(false)
+  {
+  }
+
+  /// Dereference the iterator.
+  const address_v4& operator*() const STDNET_NOEXCEPT
+  {
+    return address_;
+  }
+
+  /// Dereference the iterator.
+  const address_v4* operator->() const STDNET_NOEXCEPT
+  {
+    return &address_;
+  }
+
+  /// Get the address a number of steps away from the iterator.
+  address_v4 operator[](difference_type n) const STDNET_NOEXCEPT
+  {
+    return *(*this + n);
+  }
+
+  /// Pre-increment operator.
+  address_iterator_v4& operator++() STDNET_NOEXCEPT
+  {
+    return *this += 1;
+  }
+
+  /// Post-increment operator.
+  address_iterator_v4 operator++(int) STDNET_NOEXCEPT
+  {
+    address_iterator_v4 tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /// Pre-decrement operator.
+  address_iterator_v4& operator--() STDNET_NOEXCEPT
+  {
+    return *this -= 1;
+  }
+
+  /// Post-decrement operator.
+  address_iterator_v4 operator--(int) STDNET_NOEXCEPT
+  {
+    address_iterator_v4 tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  /// Advance the iterator by a number of steps.
+  address_iterator_v4& operator+=(difference_type n) STDNET_NOEXCEPT
+  {
+    const std::uint64_t p = position() + static_cast<std::uint64_t>(n);
+    address_ = make_address_v4(static_cast<unsigned long>(p & 0xFFFFFFFF));
+    past_end_ = (p >> 32) != 0;
+    return *this;
+  }
+
+  /// Move the iterator back by a number of steps.
+  address_iterator_v4& operator-=(difference_type n) STDNET_NOEXCEPT
+  {
+    return *this += -n;
+  }
+
+  /// Get an iterator a number of steps after another.
+  friend address_iterator_v4 operator+(const address_iterator_v4& i,
+      difference_type n) STDNET_NOEXCEPT
+  {
+    address_iterator_v4 tmp(i);
+    return tmp += n;
+  }
+
+  /// Get an iterator a number of steps after another.
+  friend address_iterator_v4 operator+(difference_type n,
+      const address_iterator_v4& i) STDNET_NOEXCEPT
+  {
+    return i + n;
+  }
+
+  /// Get an iterator a number of steps before another.
+  friend address_iterator_v4 operator-(const address_iterator_v4& i,
+      difference_type n) STDNET_NOEXCEPT
+  {
+    address_iterator_v4 tmp(i);
+    return tmp -= n;
+  }
+
+  /// Get the number of steps from one iterator to another.
+  friend difference_type operator-(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return static_cast<difference_type>(a.position())
+      - static_cast<difference_type>(b.position());
+  }
+
+  /// Compare two iterators for equality.
+  friend bool operator==(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return a.address_ == b.address_ && a.past_end_ == b.past_end_;
+  }
+
+  /// Compare two iterators for inequality.
+  friend bool operator!=(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return !(a == b);
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator<(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return a.position() < b.position();
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator>(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return b < a;
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator<=(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return !(b < a);
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator>=(const address_iterator_v4& a,
+      const address_iterator_v4& b) STDNET_NOEXCEPT
+  {
+    return !(a < b);
+  }
+
+private:
+  // The position in the 33-bit space of addresses and the one past the end.
+  std::uint64_t position() const STDNET_NOEXCEPT
+  {
+    return (static_cast<std::uint64_t>(past_end_) << 32) | address_.to_ulong();
+  }
+
+  address_v4 address_;
+  bool past_end_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_ADDRESS_ITERATOR_V4_HPP
@@ -0,0 +1,262 @@
+//
+// ip/address_iterator_v6.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_ADDRESS_ITERATOR_V6_HPP
+#define STDNET_IP_ADDRESS_ITERATOR_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include "std/net/ip/address_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// An iterator that can be used for traversing IPv6 addresses.
+/**
+ * The iterator is random-access. Steps are taken on the 128-bit value of the
+ * address, with the scope ID carried along unchanged. An iterator may point
+ * one past ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff, so that a range may
+ * include every address.
+ *
+ * Most IPv6 ranges hold more addresses than difference_type can count. Where
+ * the distance between two iterators cannot be represented, subtracting them
+ * gives the largest or smallest value of difference_type, with the sign of
+ * the true distance. Thus for a /64 or larger network, end() - begin() is
+ * std::numeric_limits<difference_type>::max().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class address_iterator_v6
+{
+public:
+  /// The type of the elements pointed to by the iterator.
+  typedef address_v6 value_type;
+
+  /// Distance between two iterators.
+  typedef std::ptrdiff_t difference_type;
+
+  /// The type of a pointer to an element pointed to by the iterator.
+  typedef const address_v6* pointer;
+
+  /// The type of a reference to an element pointed to by the iterator.
+  typedef const address_v6& reference;
+
+  /// Denotes that the iterator satisfies the random access iterator
+  /// requirements.
+  typedef std::random_access_iterator_tag iterator_category;
+
+  /// Construct an iterator that points to the specified address.
+  explicit address_iterator_v6(const address_v6& addr) STDNET_NOEXCEPT
+    : address_(addr),
+      past_end_(false)
+  {
+  }
+
+  /// Dereference the iterator.
+  const address_v6& operator*() const STDNET_NOEXCEPT
+  {
+    return address_;
+  }
+
+  /// Dereference the iterator.
+  const address_v6* operator->() const STDNET_NOEXCEPT
+  {
+    return &address_;
+  }
+
+  /// Get the address a number of steps away from the iterator.
+  address_v6 operator[](difference_type n) const STDNET_NOEXCEPT
+  {
+    return *(*this + n);
+  }
+
+  /// Pre-increment operator.
+  address_iterator_v6& operator++() STDNET_NOEXCEPT
+  {
+    return *this += 1;
+  }
+
+  /// Post-increment operator.
+  address_iterator_v6 operator++(int) STDNET_NOEXCEPT
+  {
+    address_iterator_v6 tmp(*this);
+    ++*this;
+    return tmp;
+  }
+
+  /// Pre-decrement operator.
+  address_iterator_v6& operator--() STDNET_NOEXCEPT
+  {
+    return *this -= 1;
+  }
+
+  /// Post-decrement operator.
+  address_iterator_v6 operator--(int) STDNET_NOEXCEPT
+  {
+    address_iterator_v6 tmp(*this);
+    --*this;
+    return tmp;
+  }
+
+  /// Advance the iterator by a number of steps.
+  address_iterator_v6& operator+=(difference_type n) STDNET_NOEXCEPT
+  {
+    unsigned long long high = address_.word(0);
+    const unsigned long long old_low = address_.word(8);
+    const unsigned long long low = old_low + static_cast<unsigned long long>(n);
+    if (n >= 0)
+    {
+      // Carry into the upper word, and from there past the last address.
+      if (low < old_low && ++high == 0)
+        past_end_ = !past_end_;
+    }
+    else
+    {
+      // Borrow from the upper word, and from there from one past the end.
+      if (low > old_low && high-- == 0)
+        past_end_ = !past_end_;
+    }
+    address_ = address_v6::from_words(high, low, address_.scope_id());
+    return *this;
+  }
+
+  /// Move the iterator back by a number of steps.
+  address_iterator_v6& operator-=(difference_type n) STDNET_NOEXCEPT
+  {
+    return *this += -n;
+  }
+
+  /// Get an iterator a number of steps after another.
+  friend address_iterator_v6 operator+(const address_iterator_v6& i,
+      difference_type n) STDNET_NOEXCEPT
+  {
+    address_iterator_v6 tmp(i);
+    return tmp += n;
+  }
+
+  /// Get an iterator a number of steps after another.
+  friend address_iterator_v6 operator+(difference_type n,
+      const address_iterator_v6& i) STDNET_NOEXCEPT
+  {
+    return i + n;
+  }
+
+  /// Get an iterator a number of steps before another.
+  friend address_iterator_v6 operator-(const address_iterator_v6& i,
+      difference_type n) STDNET_NOEXCEPT
+  {
+    address_iterator_v6 tmp(i);
+    return tmp -= n;
+  }
+
+  /// Get the number of steps from one iterator to another.
+  friend difference_type operator-(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return a.distance_from(b);
+  }
+
+  /// Compare two iterators for equality.
+  friend bool operator==(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return a.address_ == b.address_ && a.past_end_ == b.past_end_;
+  }
+
+  /// Compare two iterators for inequality.
+  friend bool operator!=(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return !(a == b);
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator<(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    if (a.past_end_ != b.past_end_)
+      return b.past_end_;
+    return a.address_ < b.address_;
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator>(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return b < a;
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator<=(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return !(b < a);
+  }
+
+  /// Compare iterators for ordering.
+  friend bool operator>=(const address_iterator_v6& a,
+      const address_iterator_v6& b) STDNET_NOEXCEPT
+  {
+    return !(a < b);
+  }
+
+private:
+  // Subtract the 129-bit values formed by past_end_ and the address, and
+  // saturate where the difference does not fit in difference_type.
+  difference_type distance_from(
+      const address_iterator_v6& other) const STDNET_NOEXCEPT
+  {
+    const unsigned long long high1 = address_.word(0);
+    const unsigned long long high2 = other.address_.word(0);
+    const unsigned long long low1 = address_.word(8);
+    const unsigned long long low2 = other.address_.word(8);
+    const unsigned long long low = low1 - low2;
+    const bool low_borrow = low1 < low2;
+    const unsigned long long high = high1 - high2 - low_borrow;
+    const bool high_borrow = high1 < high2 || (high1 == high2 && low_borrow);
+    const int top = static_cast<int>(past_end_)
+      - static_cast<int>(other.past_end_) - high_borrow;
+
+    const unsigned long long max = static_cast<unsigned long long>(
+        std::numeric_limits<difference_type>::max());
+    if (top == 0 && high == 0 && low <= max)
+      return static_cast<difference_type>(low);
+    if (top == -1 && high == ~0ULL && low > max)
+      return -static_cast<difference_type>(~low) - 1;
+    return top < 0 ? std::numeric_limits<difference_type>::min()
+      : std::numeric_limits<difference_type>::max();
+  }
+
+  address_v6 address_;
+
+  // True if the iterator is one past the last address.
+  bool past_end_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_ADDRESS_ITERATOR_V6_HPP
@@ -0,0 +1,157 @@
+//
+// ip/address_range_v4.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_ADDRESS_RANGE_V4_HPP
+#define STDNET_IP_ADDRESS_RANGE_V4_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include "std/net/ip/address_iterator_v4.hpp"
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/ip/network_v4.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// Represents a range of IPv4 addresses.
+/**
+ * The ip::address_range_v4 class holds every address in a block given by a
+ * network address and a netmask, including the network and broadcast
+ * addresses. It is a random-access range: its size, the address at a given
+ * position, and the position of a given address are all found in constant
+ * time. A range may therefore be divided evenly into chunks, for example one
+ * for each of a number of threads, without visiting its addresses:
+ *
+ * @code address_range_v4 range(network_v4(make_address_v4("10.0.0.0"), 8));
+ * std::size_t chunk = range.size() / threads;
+ * address_range_v4::iterator first = range.begin() + t * chunk;
+ * address_range_v4::iterator last =
+ *   t + 1 == threads ? range.end() : first + chunk; @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class address_range_v4
+{
+public:
+  /// The type of an iterator that points into the range.
+  typedef address_iterator_v4 iterator;
+
+  /// The type of an iterator that points into the range.
+  typedef address_iterator_v4 const_iterator;
+
+  /// Construct an empty range.
+  address_range_v4() STDNET_NOEXCEPT
+    : begin_(address_v4()),
+      end_(address_v4())
+  {
+  }
+
+  /// Construct a range that holds a single address.
+  explicit address_range_v4(const address_v4& addr) STDNET_NOEXCEPT
+    : begin_(addr),
+      end_(++address_iterator_v4(addr))
+  {
+  }
+
+  /// Construct a range that holds every address in a network.
+  /**
+   * @throws std::invalid_argument if the one bits in the mask are not
+   * contiguous and leading.
+   */
+  address_range_v4(const address_v4& addr, const address_v4& mask)
+    : begin_(network_v4(addr, mask).network()),
+      end_(++address_iterator_v4(network_v4(addr, mask).broadcast()))
+  {
+  }
+
+  /// Construct a range that holds every address in a network.
+  explicit address_range_v4(const network_v4& net) STDNET_NOEXCEPT
+    : begin_(net.network()),
+      end_(++address_iterator_v4(net.broadcast()))
+  {
+  }
+
+  /// Get the first address in the range. The range must not be empty.
+  address_v4 network() const STDNET_NOEXCEPT
+  {
+    return *begin_;
+  }
+
+  /// Get the mask that covers the range. The range must not be empty.
+  address_v4 netmask() const STDNET_NOEXCEPT
+  {
+    return make_address_v4(
+        ~(begin_->to_ulong() ^ broadcast().to_ulong()) & 0xFFFFFFFF);
+  }
+
+  /// Get the last address in the range. The range must not be empty.
+  address_v4 broadcast() const STDNET_NOEXCEPT
+  {
+    return end_[-1];
+  }
+
+  /// Get an iterator to the first address in the range.
+  iterator begin() const STDNET_NOEXCEPT
+  {
+    return begin_;
+  }
+
+  /// Get an iterator one past the last address in the range.
+  iterator end() const STDNET_NOEXCEPT
+  {
+    return end_;
+  }
+
+  /// Determine whether the range is empty.
+  bool empty() const STDNET_NOEXCEPT
+  {
+    return begin_ == end_;
+  }
+
+  /// Get the number of addresses in the range.
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return static_cast<std::size_t>(end_ - begin_);
+  }
+
+  /// Find an address in the range.
+  /**
+   * @returns An iterator that points to the address, or end() if the address
+   * is not in the range. Takes constant time.
+   */
+  iterator find(const address_v4& addr) const STDNET_NOEXCEPT
+  {
+    const iterator i(addr);
+    return begin_ <= i && i < end_ ? i : end_;
+  }
+
+private:
+  iterator begin_;
+  iterator end_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_ADDRESS_RANGE_V4_HPP
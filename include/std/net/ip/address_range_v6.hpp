@@ -0,0 +1,209 @@
+//
+// ip/address_range_v6.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_ADDRESS_RANGE_V6_HPP
+#define STDNET_IP_ADDRESS_RANGE_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "std/net/detail/throw_exception.hpp"
+#include "std/net/ip/address_iterator_v6.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/network_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// Represents a range of IPv6 addresses.
+/**
+ * The ip::address_range_v6 class holds every address in a network. As for
+ * address_range_v4, it is a random-access range, and a position within it is
+ * found in constant time. Most IPv6 networks are too large for their size to
+ * be represented. A range is instead divided into parts with split(), which
+ * also takes constant time, so that each thread may be given one part:
+ *
+ * @code address_range_v6 range(make_address_v6("2001:db8::"), 48);
+ * std::pair<address_range_v6::iterator, address_range_v6::iterator> part =
+ *   range.split(thread_count, t); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class address_range_v6
+{
+public:
+  /// The type of an iterator that points into the range.
+  typedef address_iterator_v6 iterator;
+
+  /// The type of an iterator that points into the range.
+  typedef address_iterator_v6 const_iterator;
+
+  /// Construct an empty range.
+  address_range_v6() STDNET_NOEXCEPT
+    : begin_(address_v6()),
+      end_(address_v6()),
+      prefix_length_(128)
+  {
+  }
+
+  /// Construct a range that holds a single address.
+  explicit address_range_v6(const address_v6& addr) STDNET_NOEXCEPT
+    : begin_(addr),
+      end_(++address_iterator_v6(addr)),
+      prefix_length_(128)
+  {
+  }
+
+  /// Construct a range that holds every address in a network.
+  /**
+   * @throws std::out_of_range if the prefix length is greater than 128.
+   */
+  address_range_v6(const address_v6& addr, int prefix_len)
+    : begin_(network_v6(addr, prefix_len).begin()),
+      end_(network_v6(addr, prefix_len).end()),
+      prefix_length_(prefix_len)
+  {
+  }
+
+  /// Construct a range that holds every address in a network.
+  explicit address_range_v6(const network_v6& net) STDNET_NOEXCEPT
+    : begin_(net.begin()),
+      end_(net.end()),
+      prefix_length_(net.prefix_length())
+  {
+  }
+
+  /// Get the first address in the range. The range must not be empty.
+  address_v6 network() const STDNET_NOEXCEPT
+  {
+    return *begin_;
+  }
+
+  /// Get the prefix length of the network that the range holds.
+  int prefix_length() const STDNET_NOEXCEPT
+  {
+    return prefix_length_;
+  }
+
+  /// Get an iterator to the first address in the range.
+  iterator begin() const STDNET_NOEXCEPT
+  {
+    return begin_;
+  }
+
+  /// Get an iterator one past the last address in the range.
+  iterator end() const STDNET_NOEXCEPT
+  {
+    return end_;
+  }
+
+  /// Determine whether the range is empty.
+  bool empty() const STDNET_NOEXCEPT
+  {
+    return begin_ == end_;
+  }
+
+  /// Find an address in the range.
+  /**
+   * @returns An iterator that points to the address, or end() if the address
+   * is not in the range. Takes constant time. An address with a different
+   * scope ID from the range is not in it.
+   */
+  iterator find(const address_v6& addr) const STDNET_NOEXCEPT
+  {
+    const iterator i(addr);
+    return addr.scope_id() == begin_->scope_id()
+      && begin_ <= i && i < end_ ? i : end_;
+  }
+
+  /// Divide the range into parts and get one of them.
+  /**
+   * The range is divided into @c parts consecutive parts, whose sizes differ
+   * by at most one address. Part @c i begins @c i * size / @c parts addresses
+   * into the range, where size is the number of addresses in it, so that the
+   * parts together hold every address exactly once. Takes constant time.
+   *
+   * @returns A pair of iterators giving the first address of the part and one
+   * past its last address.
+   *
+   * @throws std::out_of_range if @c parts is zero or @c i is not less than
+   * @c parts.
+   */
+  std::pair<iterator, iterator> split(std::size_t parts, std::size_t i) const
+  {
+    if (parts == 0 || i >= parts)
+    {
+      std::out_of_range ex("address_range_v6 split");
+      std::experimental::net::detail::throw_exception(ex);
+    }
+
+    return std::pair<iterator, iterator>(
+        part_begin(parts, i), part_begin(parts, i + 1));
+  }
+
+private:
+  // Divide i * 2^(128 - prefix_length_) by the number of parts, one quotient
+  // bit at a time with a remainder that is less than the number of parts, and
+  // add the result to the network address. The host bits of the network
+  // address are zero, so the addition cannot carry.
+  iterator part_begin(std::size_t parts, std::size_t i) const STDNET_NOEXCEPT
+  {
+    if (i == parts || empty())
+      return end_;
+
+    unsigned long long high = 0;
+    unsigned long long low = 0;
+    unsigned long long rem = i;
+    for (int bit = 128 - prefix_length_; bit > 0; --bit)
+    {
+      const bool carry = (rem >> 63) != 0;
+      rem <<= 1;
+      high = (high << 1) | (low >> 63);
+      low <<= 1;
+      if (carry || rem >= parts)
+      {
+        rem -= parts;
+        low |= 1;
+      }
+    }
+
+    address_v6::bytes_type bytes = begin_->to_bytes();
+    for (int b = 0; b < 8; ++b)
+    {
+      bytes[7 - b] |= static_cast<unsigned char>(high >> (8 * b));
+      bytes[15 - b] |= static_cast<unsigned char>(low >> (8 * b));
+    }
+    return iterator(address_v6(bytes, begin_->scope_id()));
+  }
+
+  iterator begin_;
+  iterator end_;
+  int prefix_length_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_ADDRESS_RANGE_V6_HPP
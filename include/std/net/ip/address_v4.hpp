@@ -17,11 +17,20 @@
 
 #include "std/net/detail/config.hpp"
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <system_error>
+#include <type_traits>
 #include "std/net/ip/fwd.hpp"
+#include "std/net/detail/throw_exception.hpp"
 #include "std/net/detail/winsock_init.hpp"
 
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
 #if !defined(STDNET_NO_IOSTREAM)
 # include <iosfwd>
 #endif // !defined(STDNET_NO_IOSTREAM)
@@ -73,18 +82,22 @@ public:
 
   /// Default constructor.
   STDNET_CONSTEXPR address_v4() STDNET_NOEXCEPT
-    : bytes_(0, 0, 0, 0)
+    : value_(0)
   {
   }
 
   /// Implicit construction from bytes, in network byte order.
   STDNET_CONSTEXPR address_v4(const bytes_type& bytes)
-    : bytes_(
+    : value_(
 #if UCHAR_MAX > 0xFF
         (bytes[0] > 0xFF || bytes[1] > 0xFF || bytes[2] > 0xFF || bytes[3] > 0xFF)
-        ? throw std::out_of_range("address_v4 from bytes_type") :
+        ? std::experimental::net::detail::throw_exception_as<std::uint32_t>(
+            std::out_of_range("address_v4 from bytes_type")) :
 #endif // UCHAR_MAX > 0xFF
-        bytes)
+        (static_cast<std::uint32_t>(bytes[0]) << 24)
+        | (static_cast<std::uint32_t>(bytes[1]) << 16)
+        | (static_cast<std::uint32_t>(bytes[2]) << 8)
+        | static_cast<std::uint32_t>(bytes[3]))
   {
   }
 
@@ -102,77 +115,61 @@ public:
   explicit STDNET_CONSTEXPR address_v4(T1& t1,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1&>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1).to_bytes()) {}
+        : value_(make_address_v4(t1).value_) {}
   template <typename T1>
   explicit STDNET_CONSTEXPR address_v4(const T1& t1,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1).to_bytes()) {}
+        : value_(make_address_v4(t1).value_) {}
   template <typename T1, typename T2>
   STDNET_CONSTEXPR address_v4(T1& t1, T2& t2,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1&>(), declval<T2&>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1, t2).to_bytes()) {}
+        : value_(make_address_v4(t1, t2).value_) {}
   template <typename T1, typename T2>
   STDNET_CONSTEXPR address_v4(T1& t1, const T2& t2,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1&>(), declval<T2>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1, t2).to_bytes()) {}
+        : value_(make_address_v4(t1, t2).value_) {}
   template <typename T1, typename T2>
   STDNET_CONSTEXPR address_v4(const T1& t1, T2& t2,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1>(), declval<T2&>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1, t2).to_bytes()) {}
+        : value_(make_address_v4(t1, t2).value_) {}
   template <typename T1, typename T2>
   STDNET_CONSTEXPR address_v4(const T1& t1, const T2& t2,
     typename enable_if<is_same<address_v4,
       decltype(make_address_v4(declval<T1>(), declval<T2>()))>::value>::type* = 0)
-        : bytes_(make_address_v4(t1, t2).to_bytes()) {}
+        : value_(make_address_v4(t1, t2).value_) {}
 #endif // defined(STDNET_HAS_VARIADIC_TEMPLATES)
 
   /// Copy constructor.
-  STDNET_CONSTEXPR address_v4(const address_v4& other) STDNET_NOEXCEPT
-    : bytes_(other.bytes_)
-  {
-  }
+  STDNET_CONSTEXPR address_v4(const address_v4& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move constructor.
-  address_v4(address_v4&& other) STDNET_NOEXCEPT
-    : bytes_(other.bytes_)
-  {
-  }
+  STDNET_CONSTEXPR address_v4(address_v4&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// Assign from another address.
-  address_v4& operator=(const address_v4& other) STDNET_NOEXCEPT
-  {
-    bytes_ = other.bytes_;
-    return *this;
-  }
+  address_v4& operator=(const address_v4& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move-assign from another address.
-  address_v4& operator=(address_v4&& other) STDNET_NOEXCEPT
-  {
-    bytes_ = other.bytes_;
-    return *this;
-  }
+  address_v4& operator=(address_v4&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// Get the address in bytes, in network byte order.
   STDNET_CONSTEXPR bytes_type to_bytes() const STDNET_NOEXCEPT
   {
-    return bytes_;
+    return bytes_type((value_ >> 24) & 0xFF, (value_ >> 16) & 0xFF,
+        (value_ >> 8) & 0xFF, value_ & 0xFF);
   }
 
   /// Get the address as an unsigned long in host byte order
   STDNET_CONSTEXPR unsigned long to_ulong() const STDNET_NOEXCEPT
   {
-    return (static_cast<unsigned long>(bytes_[0]) << 24)
-      | (static_cast<unsigned long>(bytes_[1]) << 16)
-      | (static_cast<unsigned long>(bytes_[2]) << 8)
-      | static_cast<unsigned long>(bytes_[3]);
+    return value_;
   }
 
   /// Get the address as a string in dotted decimal format.
@@ -184,79 +181,79 @@ public:
   /// Determine whether the address is a loopback address.
   STDNET_CONSTEXPR bool is_loopback() const STDNET_NOEXCEPT
   {
-    return (to_ulong() & 0xFF000000) == 0x7F000000;
+    return (value_ & 0xFF000000) == 0x7F000000;
   }
 
   /// Determine whether the address is unspecified.
   STDNET_CONSTEXPR bool is_unspecified() const STDNET_NOEXCEPT
   {
-    return to_ulong() == 0;
+    return value_ == 0;
   }
 
   /// Determine whether the address is a class A address.
   STDNET_CONSTEXPR bool is_class_a() const STDNET_NOEXCEPT
   {
-    return (to_ulong() & 0x80000000) == 0;
+    return (value_ & 0x80000000) == 0;
   }
 
   /// Determine whether the address is a class B address.
   STDNET_CONSTEXPR bool is_class_b() const STDNET_NOEXCEPT
   {
-    return (to_ulong() & 0xC0000000) == 0x80000000;
+    return (value_ & 0xC0000000) == 0x80000000;
   }
 
   /// Determine whether the address is a class C address.
   STDNET_CONSTEXPR bool is_class_c() const STDNET_NOEXCEPT
   {
-    return (to_ulong() & 0xE0000000) == 0xC0000000;
+    return (value_ & 0xE0000000) == 0xC0000000;
   }
 
   /// Determine whether the address is a multicast address.
   STDNET_CONSTEXPR bool is_multicast() const STDNET_NOEXCEPT
   {
-    return (to_ulong() & 0xF0000000) == 0xE0000000;
+    return (value_ & 0xF0000000) == 0xE0000000;
   }
 
   /// Compare two addresses for equality.
   friend bool operator==(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.bytes_ == a2.bytes_;
+    return a1.value_ == a2.value_;
   }
 
   /// Compare two addresses for inequality.
   friend bool operator!=(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.bytes_ == a2.bytes_;
+    return a1.value_ != a2.value_;
   }
 
   /// Compare addresses for ordering.
   friend bool operator<(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.to_ulong() < a2.to_ulong();
+    return a1.value_ < a2.value_;
   }
 
   /// Compare addresses for ordering.
   friend bool operator>(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.to_ulong() > a2.to_ulong();
+    return a1.value_ > a2.value_;
   }
 
   /// Compare addresses for ordering.
   friend bool operator<=(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.to_ulong() <= a2.to_ulong();
+    return a1.value_ <= a2.value_;
   }
 
   /// Compare addresses for ordering.
   friend bool operator>=(const address_v4& a1,
       const address_v4& a2) STDNET_NOEXCEPT
   {
-    return a1.to_ulong() >= a2.to_ulong();
+    return a1.value_ >= a2.value_;
   }
 
   /// Obtain an address object that represents any address.
@@ -282,14 +279,30 @@ public:
   static STDNET_CONSTEXPR address_v4 broadcast(const address_v4& addr,
       const address_v4& mask) STDNET_NOEXCEPT
   {
-    return address_v4(addr.to_ulong() | (mask.to_ulong() ^ 0xFFFFFFFF));
+    return address_v4(addr.value_ | (mask.value_ ^ 0xFFFFFFFF), 0);
   }
 
 private:
-  // The underlying IPv4 address.
-  bytes_type bytes_;
+  friend STDNET_CONSTEXPR address_v4 make_address_v4(unsigned long);
+
+  // Construct from a value in host byte order.
+  STDNET_CONSTEXPR address_v4(std::uint32_t value, int) STDNET_NOEXCEPT
+    : value_(value)
+  {
+  }
+
+  // The underlying IPv4 address, in host byte order.
+  std::uint32_t value_;
 };
 
+// Addresses may be copied with memcpy and placed in shared or mapped memory.
+#if defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_trivially_copyable<address_v4>::value,
+    "address_v4 must be trivially copyable");
+#endif // defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_standard_layout<address_v4>::value,
+    "address_v4 must be standard layout");
+
 /// Construct an address_v4 from raw bytes.
 inline STDNET_CONSTEXPR address_v4 make_address_v4(const address_v4::bytes_type& bytes)
 {
@@ -302,10 +315,10 @@ inline STDNET_CONSTEXPR address_v4 make_address_v4(unsigned long addr)
   return
 #if ULONG_MAX > 0xFFFFFFFF
     (addr > 0xFFFFFFFF)
-    ? throw std::out_of_range("address_v4 from unsigned long") :
+    ? std::experimental::net::detail::throw_exception_as<address_v4>(
+        std::out_of_range("address_v4 from unsigned long")) :
 #endif // ULONG_MAX > 0xFFFFFFFF
-    address_v4::bytes_type((addr >> 24) & 0xFF,
-      (addr >> 16) & 0xFF, (addr >> 8) & 0xFF, addr & 0xFF);
+    address_v4(static_cast<std::uint32_t>(addr), 0);
 }
 
 /// Create an address_v4 from an IPv4 address string in dotted decimal form.
@@ -322,6 +335,93 @@ STDNET_DECL address_v4 make_address_v4(const std::string& str);
 STDNET_DECL address_v4 make_address_v4(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT;
 
+/// Create an address_v4 from an IPv4 address string in dotted decimal form.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address_v4 make_address_v4(const char* str, std::size_t len);
+
+/// Create an address_v4 from an IPv4 address string in dotted decimal form.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address_v4 make_address_v4(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Create an address_v4 from an IPv4 address string in dotted decimal form.
+STDNET_DECL address_v4 make_address_v4(std::string_view str);
+
+/// Create an address_v4 from an IPv4 address string in dotted decimal form.
+STDNET_DECL address_v4 make_address_v4(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an address_v4 from the start of a character sequence.
+/**
+ * Parses the longest prefix of [first, last) that is an IPv4 address in dotted decimal form.
+ *
+ * @returns On success, @c ptr points to the first character not parsed, @c ec
+ * is value-initialised and @c addr holds the parsed address. Otherwise, @c ptr
+ * is equal to @c first, @c ec is @c std::errc::invalid_argument, and @c addr
+ * is unmodified.
+ */
+STDNET_DECL from_chars_result from_chars(const char* first, const char* last,
+    address_v4& addr) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 address string in dotted decimal form, without exceptions.
+/**
+ * Accepts the same text as make_address_v4, but reports failure in the result
+ * rather than through an exception or a std::error_code. No memory is
+ * allocated.
+ *
+ * @returns The address, or @c std::errc::invalid_argument if the string is
+ * not a valid IPv4 address.
+ */
+STDNET_DECL parse_result<address_v4> parse_address_v4(const char* str) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 address string in dotted decimal form, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address_v4> parse_address_v4(
+    const std::string& str) STDNET_NOEXCEPT;
+
+/// Parse an IPv4 address string in dotted decimal form, without exceptions.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL parse_result<address_v4> parse_address_v4(const char* str,
+    std::size_t len) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an IPv4 address string in dotted decimal form, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address_v4> parse_address_v4(
+    std::string_view str) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Write an address_v4 to a character buffer in dotted decimal form.
+/**
+ * The text is not NUL-terminated. No memory is allocated.
+ *
+ * @returns On success, @c ptr points one past the last character written and
+ * @c ec is value-initialised. If the buffer is too small, @c ptr is equal to
+ * @c last, @c ec is @c std::errc::value_too_large, and the contents of the
+ * buffer are unspecified.
+ */
+STDNET_DECL to_chars_result to_chars(char* first, char* last,
+    const address_v4& addr) STDNET_NOEXCEPT;
+
 #if defined(STDNET_HAS_CONSTEXPR)
 
 /// The IPv4 unspecified address.
@@ -364,6 +464,25 @@ std::basic_ostream<Elem, Traits>& operator<<(
 } // namespace ip
 } // namespace net
 } // namespace experimental
+
+/// Hash support for IPv4 addresses.
+template <>
+struct hash<std::experimental::net::ip::address_v4>
+{
+  typedef std::experimental::net::ip::address_v4 argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(
+      const std::experimental::net::ip::address_v4& addr) const STDNET_NOEXCEPT
+  {
+    // A single multiply spreads the address across the upper half of the
+    // product, and the shift folds it back into the lower half.
+    const unsigned long long h =
+      static_cast<unsigned long long>(addr.to_ulong()) * 0x9e3779b97f4a7c15ULL;
+    return static_cast<std::size_t>(h ^ (h >> 32));
+  }
+};
+
 } // namespace std
 
 #include "std/net/detail/pop_options.hpp"
@@ -17,13 +17,23 @@
 
 #include "std/net/detail/config.hpp"
 #include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
 #include <string>
 #include <system_error>
+#include <type_traits>
 #include "std/net/ip/fwd.hpp"
 #include "std/net/ip/address_v4.hpp"
 #include "std/net/ip/bad_address_cast.hpp"
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/throw_exception.hpp"
 #include "std/net/detail/winsock_init.hpp"
 
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
 #if !defined(STDNET_NO_IOSTREAM)
 # include <iosfwd>
 #endif // !defined(STDNET_NO_IOSTREAM)
@@ -99,7 +109,8 @@ public:
         || bytes[4] > 0xFF || bytes[5] > 0xFF || bytes[6] > 0xFF || bytes[7] > 0xFF
         || bytes[8] > 0xFF || bytes[9] > 0xFF || bytes[10] > 0xFF || bytes[11] > 0xFF
         || bytes[12] > 0xFF || bytes[13] > 0xFF || bytes[14] > 0xFF || bytes[15] > 0xFF)
-        ? throw std::out_of_range("address_v6 from bytes_type") :
+        ? std::experimental::net::detail::throw_exception_as<bytes_type>(
+            std::out_of_range("address_v6 from bytes_type")) :
 #endif // UCHAR_MAX > 0xFF
         bytes),
       scope_id_(scope)
@@ -149,35 +160,19 @@ public:
 #endif // defined(STDNET_HAS_VARIADIC_TEMPLATES)
 
   /// Copy constructor.
-  STDNET_CONSTEXPR address_v6(const address_v6& other) STDNET_NOEXCEPT
-    : bytes_(other.bytes_), scope_id_(other.scope_id_)
-  {
-  }
+  STDNET_CONSTEXPR address_v6(const address_v6& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move constructor.
-  address_v6(address_v6&& other) STDNET_NOEXCEPT
-    : bytes_(other.bytes_), scope_id_(other.scope_id_)
-  {
-  }
+  STDNET_CONSTEXPR address_v6(address_v6&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// Assign from another address.
-  address_v6& operator=(const address_v6& other) STDNET_NOEXCEPT
-  {
-    bytes_ = other.bytes_;
-    scope_id_ = other.scope_id_;
-    return *this;
-  }
+  address_v6& operator=(const address_v6& other) STDNET_NOEXCEPT = default;
 
 #if defined(STDNET_HAS_MOVE)
   /// Move-assign from another address.
-  address_v6& operator=(address_v6&& other) STDNET_NOEXCEPT
-  {
-    bytes_ = other.bytes_;
-    scope_id_ = other.scope_id_;
-    return *this;
-  }
+  address_v6& operator=(address_v6&& other) STDNET_NOEXCEPT = default;
 #endif // defined(STDNET_HAS_MOVE)
 
   /// The scope ID of the address.
@@ -299,7 +294,8 @@ public:
   friend bool operator==(const address_v6& a1,
       const address_v6& a2) STDNET_NOEXCEPT
   {
-    return a1.bytes_ == a2.bytes_ && a1.scope_id_ == a2.scope_id_;
+    return a1.word(0) == a2.word(0) && a1.word(8) == a2.word(8)
+      && a1.scope_id_ == a2.scope_id_;
   }
 
   /// Compare two addresses for inequality.
@@ -313,11 +309,21 @@ public:
   friend bool operator<(const address_v6& a1,
       const address_v6& a2) STDNET_NOEXCEPT
   {
-    if (a1.bytes_ < a2.bytes_)
-      return true;
-    if (a1.bytes_ > a2.bytes_)
-      return false;
+#if defined(STDNET_HAS_INT128)
+    const uint128_type v1 = (static_cast<uint128_type>(a1.word(0)) << 64)
+      | a1.word(8);
+    const uint128_type v2 = (static_cast<uint128_type>(a2.word(0)) << 64)
+      | a2.word(8);
+    return v1 < v2 || (v1 == v2 && a1.scope_id_ < a2.scope_id_);
+#else // defined(STDNET_HAS_INT128)
+    const unsigned long long high1 = a1.word(0), high2 = a2.word(0);
+    if (high1 != high2)
+      return high1 < high2;
+    const unsigned long long low1 = a1.word(8), low2 = a2.word(8);
+    if (low1 != low2)
+      return low1 < low2;
     return a1.scope_id_ < a2.scope_id_;
+#endif // defined(STDNET_HAS_INT128)
   }
 
   /// Compare addresses for ordering.
@@ -356,6 +362,38 @@ public:
 private:
   friend STDNET_CONSTEXPR address_v4 make_address_v4(
       v4_mapped_t, const address_v6&);
+  friend class compact_address_v6;
+  friend class address_iterator_v6;
+  friend class network_v6;
+  friend struct std::hash<address_v6>;
+
+#if defined(STDNET_HAS_INT128)
+  __extension__ typedef unsigned __int128 uint128_type;
+#endif // defined(STDNET_HAS_INT128)
+
+  // Get eight bytes of the address, starting at the given offset, as a big
+  // endian 64-bit value. Compilers turn this into a load and a byte swap.
+  STDNET_CONSTEXPR unsigned long long word(std::size_t offset) const
+  {
+    return (static_cast<unsigned long long>(bytes_[offset]) << 56)
+      | (static_cast<unsigned long long>(bytes_[offset + 1]) << 48)
+      | (static_cast<unsigned long long>(bytes_[offset + 2]) << 40)
+      | (static_cast<unsigned long long>(bytes_[offset + 3]) << 32)
+      | (static_cast<unsigned long long>(bytes_[offset + 4]) << 24)
+      | (static_cast<unsigned long long>(bytes_[offset + 5]) << 16)
+      | (static_cast<unsigned long long>(bytes_[offset + 6]) << 8)
+      | static_cast<unsigned long long>(bytes_[offset + 7]);
+  }
+
+  // Make an address from its upper and lower 64 bits, in host byte order.
+  static STDNET_CONSTEXPR address_v6 from_words(unsigned long long high,
+      unsigned long long low, unsigned long scope) STDNET_NOEXCEPT
+  {
+    return address_v6(bytes_type(high >> 56, high >> 48, high >> 40,
+          high >> 32, high >> 24, high >> 16, high >> 8, high,
+          low >> 56, low >> 48, low >> 40, low >> 32,
+          low >> 24, low >> 16, low >> 8, low), scope);
+  }
 
   // The underlying IPv6 address.
   bytes_type bytes_;
@@ -364,6 +402,13 @@ private:
   unsigned long scope_id_;
 };
 
+#if defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_trivially_copyable<address_v6>::value,
+    "address_v6 must be trivially copyable");
+#endif // defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_standard_layout<address_v6>::value,
+    "address_v6 must be standard layout");
+
 /// Construct an address_v6 from raw bytes.
 inline STDNET_CONSTEXPR address_v6 make_address_v6(
     const address_v6::bytes_type& bytes, unsigned long scope_id = 0)
@@ -385,6 +430,98 @@ STDNET_DECL address_v6 make_address_v6(const std::string& str);
 STDNET_DECL address_v6 make_address_v6(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT;
 
+/// Create an address_v6 from an IPv6 address string.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address_v6 make_address_v6(const char* str, std::size_t len);
+
+/// Create an address_v6 from an IPv6 address string.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL address_v6 make_address_v6(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Create an address_v6 from an IPv6 address string.
+STDNET_DECL address_v6 make_address_v6(std::string_view str);
+
+/// Create an address_v6 from an IPv6 address string.
+STDNET_DECL address_v6 make_address_v6(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an address_v6 from the start of a character sequence.
+/**
+ * Parses the longest prefix of [first, last) that is an IPv6 address, optionally followed by a zone ID.
+ *
+ * A zone ID is included only if the '%' is followed by at least one character
+ * permitted in a zone ID by RFC 6874.
+ *
+ * @returns On success, @c ptr points to the first character not parsed, @c ec
+ * is value-initialised and @c addr holds the parsed address. Otherwise, @c ptr
+ * is equal to @c first, @c ec is @c std::errc::invalid_argument, and @c addr
+ * is unmodified.
+ */
+STDNET_DECL from_chars_result from_chars(const char* first, const char* last,
+    address_v6& addr) STDNET_NOEXCEPT;
+
+/// Parse an IPv6 address string, without exceptions.
+/**
+ * Accepts the same text as make_address_v6, but reports failure in the result
+ * rather than through an exception or a std::error_code. No memory is
+ * allocated.
+ *
+ * @returns The address, or @c std::errc::invalid_argument if the string is
+ * not a valid IPv6 address.
+ */
+STDNET_DECL parse_result<address_v6> parse_address_v6(const char* str) STDNET_NOEXCEPT;
+
+/// Parse an IPv6 address string, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address_v6> parse_address_v6(
+    const std::string& str) STDNET_NOEXCEPT;
+
+/// Parse an IPv6 address string, without exceptions.
+/**
+ * The string is given by a pointer and a length. It need not be
+ * NUL-terminated, and is parsed in place.
+ */
+STDNET_DECL parse_result<address_v6> parse_address_v6(const char* str,
+    std::size_t len) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Parse an IPv6 address string, without exceptions.
+/**
+ * As for the overload that takes a NUL-terminated string.
+ */
+STDNET_DECL parse_result<address_v6> parse_address_v6(
+    std::string_view str) STDNET_NOEXCEPT;
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+/// Write an address_v6 to a character buffer.
+/**
+ * The address is written in the recommended text form of RFC 5952, followed
+ * by the zone ID if the scope ID is non-zero. The text is not NUL-terminated.
+ * No memory is allocated.
+ *
+ * @returns On success, @c ptr points one past the last character written and
+ * @c ec is value-initialised. If the buffer is too small, @c ptr is equal to
+ * @c last, @c ec is @c std::errc::value_too_large, and the contents of the
+ * buffer are unspecified.
+ */
+STDNET_DECL to_chars_result to_chars(char* first, char* last,
+    const address_v6& addr) STDNET_NOEXCEPT;
+
 /// Create an IPv4-mapped address_v6 from an IPv4 address.
 inline STDNET_CONSTEXPR address_v6 make_address_v6(
     v4_mapped_t, const address_v4& addr) STDNET_NOEXCEPT
@@ -400,7 +537,9 @@ inline STDNET_CONSTEXPR address_v6 make_address_v6(
 inline STDNET_CONSTEXPR address_v4 make_address_v4(
     v4_mapped_t, const address_v6& addr)
 {
-  return !addr.is_v4_mapped() ? throw bad_address_cast() :
+  return !addr.is_v4_mapped()
+    ? std::experimental::net::detail::throw_exception_as<address_v4>(
+        bad_address_cast()) :
     address_v4::bytes_type(addr.bytes_[12], addr.bytes_[13],
         addr.bytes_[14], addr.bytes_[15]);
 }
@@ -428,6 +567,25 @@ std::basic_ostream<Elem, Traits>& operator<<(
 } // namespace ip
 } // namespace net
 } // namespace experimental
+
+/// Hash support for IPv6 addresses.
+template <>
+struct hash<std::experimental::net::ip::address_v6>
+{
+  typedef std::experimental::net::ip::address_v6 argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(
+      const std::experimental::net::ip::address_v6& addr) const STDNET_NOEXCEPT
+  {
+    // The address is taken as two big-endian words, so that the bytes that
+    // vary most within a subnet are in the low bits of the lower word, and
+    // the scope ID is mixed into the same bits.
+    return std::experimental::net::detail::bit_ops::hash_128(
+        addr.word(0), addr.word(8) ^ addr.scope_id());
+  }
+};
+
 } // namespace std
 
 #include "std/net/detail/pop_options.hpp"
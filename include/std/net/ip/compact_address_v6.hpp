@@ -0,0 +1,223 @@
+//
+// ip/compact_address_v6.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_COMPACT_ADDRESS_V6_HPP
+#define STDNET_IP_COMPACT_ADDRESS_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include "std/net/ip/fwd.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/bad_address_cast.hpp"
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/throw_exception.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// Implements a 16-byte IP version 6 address without a scope ID.
+/**
+ * The ip::compact_address_v6 class holds an IP version 6 address in exactly
+ * 16 bytes, as two 64-bit words in host byte order. It is intended for bulk
+ * storage, such as the keys of flow tables, where almost every address has a
+ * scope ID of zero and the 8 bytes of scope ID and padding in an address_v6
+ * would be wasted. Where the platform supports 128-bit integers, objects are
+ * also 16-byte aligned so that each address occupies a single aligned slot.
+ *
+ * A compact_address_v6 is converted to an address_v6, with a scope ID of zero,
+ * for formatting and classification.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class compact_address_v6
+{
+public:
+  /// The type used to represent an address as an array of bytes.
+  typedef address_v6::bytes_type bytes_type;
+
+  /// Default constructor.
+  STDNET_CONSTEXPR compact_address_v6() STDNET_NOEXCEPT
+    : high_(0),
+      low_(0)
+  {
+  }
+
+  /// Implicit construction from bytes, in network byte order.
+  STDNET_CONSTEXPR compact_address_v6(const bytes_type& bytes)
+    : high_(address_v6(bytes).word(0)),
+      low_(address_v6(bytes).word(8))
+  {
+  }
+
+  /// Explicit construction from an address_v6.
+  /**
+   * @throws bad_address_cast if the address has a non-zero scope ID.
+   */
+  explicit STDNET_CONSTEXPR compact_address_v6(const address_v6& addr)
+    : high_(addr.scope_id() != 0
+        ? std::experimental::net::detail::throw_exception_as<unsigned long long>(
+          bad_address_cast())
+        : addr.word(0)),
+      low_(addr.word(8))
+  {
+  }
+
+  /// Copy constructor.
+  STDNET_CONSTEXPR compact_address_v6(
+      const compact_address_v6& other) STDNET_NOEXCEPT = default;
+
+#if defined(STDNET_HAS_MOVE)
+  /// Move constructor.
+  STDNET_CONSTEXPR compact_address_v6(
+      compact_address_v6&& other) STDNET_NOEXCEPT = default;
+#endif // defined(STDNET_HAS_MOVE)
+
+  /// Assign from another address.
+  compact_address_v6& operator=(
+      const compact_address_v6& other) STDNET_NOEXCEPT = default;
+
+#if defined(STDNET_HAS_MOVE)
+  /// Move-assign from another address.
+  compact_address_v6& operator=(
+      compact_address_v6&& other) STDNET_NOEXCEPT = default;
+#endif // defined(STDNET_HAS_MOVE)
+
+  /// Get the address in bytes, in network byte order.
+  STDNET_CONSTEXPR bytes_type to_bytes() const STDNET_NOEXCEPT
+  {
+    return bytes_type(high_ >> 56, high_ >> 48, high_ >> 40, high_ >> 32,
+        high_ >> 24, high_ >> 16, high_ >> 8, high_,
+        low_ >> 56, low_ >> 48, low_ >> 40, low_ >> 32,
+        low_ >> 24, low_ >> 16, low_ >> 8, low_);
+  }
+
+  /// Get the address as an address_v6 with a scope ID of zero.
+  STDNET_CONSTEXPR address_v6 to_address_v6() const STDNET_NOEXCEPT
+  {
+    return address_v6(to_bytes());
+  }
+
+  /// Implicit conversion to an address_v6 with a scope ID of zero.
+  STDNET_CONSTEXPR operator address_v6() const STDNET_NOEXCEPT
+  {
+    return to_address_v6();
+  }
+
+  /// Get the upper 64 bits of the address, in host byte order.
+  STDNET_CONSTEXPR unsigned long long high() const STDNET_NOEXCEPT
+  {
+    return high_;
+  }
+
+  /// Get the lower 64 bits of the address, in host byte order.
+  STDNET_CONSTEXPR unsigned long long low() const STDNET_NOEXCEPT
+  {
+    return low_;
+  }
+
+  /// Compare two addresses for equality.
+  friend bool operator==(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return a1.high_ == a2.high_ && a1.low_ == a2.low_;
+  }
+
+  /// Compare two addresses for inequality.
+  friend bool operator!=(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return !(a1 == a2);
+  }
+
+  /// Compare addresses for ordering.
+  friend bool operator<(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return a1.high_ < a2.high_ || (a1.high_ == a2.high_ && a1.low_ < a2.low_);
+  }
+
+  /// Compare addresses for ordering.
+  friend bool operator>(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return a2 < a1;
+  }
+
+  /// Compare addresses for ordering.
+  friend bool operator<=(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return !(a2 < a1);
+  }
+
+  /// Compare addresses for ordering.
+  friend bool operator>=(const compact_address_v6& a1,
+      const compact_address_v6& a2) STDNET_NOEXCEPT
+  {
+    return !(a1 < a2);
+  }
+
+private:
+  // The upper and lower halves of the address, in host byte order, so that
+  // comparisons are made on whole words.
+#if defined(STDNET_HAS_INT128)
+  alignas(16)
+#endif // defined(STDNET_HAS_INT128)
+  unsigned long long high_;
+  unsigned long long low_;
+};
+
+static_assert(sizeof(compact_address_v6) == 16,
+    "compact_address_v6 must be 16 bytes");
+#if defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_trivially_copyable<compact_address_v6>::value,
+    "compact_address_v6 must be trivially copyable");
+#endif // defined(STDNET_HAS_STD_IS_TRIVIALLY_COPYABLE)
+static_assert(std::is_standard_layout<compact_address_v6>::value,
+    "compact_address_v6 must be standard layout");
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+
+/// Hash support for compact IPv6 addresses.
+template <>
+struct hash<std::experimental::net::ip::compact_address_v6>
+{
+  typedef std::experimental::net::ip::compact_address_v6 argument_type;
+  typedef std::size_t result_type;
+
+  std::size_t operator()(const std::experimental::net::ip::compact_address_v6&
+      addr) const STDNET_NOEXCEPT
+  {
+    // As for address_v6, but the words are already loaded, so that an
+    // address has the same hash in either form.
+    return std::experimental::net::detail::bit_ops::hash_128(
+        addr.high(), addr.low());
+  }
+};
+
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_COMPACT_ADDRESS_V6_HPP
@@ -0,0 +1,221 @@
+//
+// ip/concurrent_prefix_table_v6.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_CONCURRENT_PREFIX_TABLE_V6_HPP
+#define STDNET_IP_CONCURRENT_PREFIX_TABLE_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include <cstddef>
+#include <cstdint>
+#include "std/net/detail/concurrent_prefix_trie.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/compact_address_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// A longest-prefix-match table keyed on IPv6 addresses, for lookups that run
+/// concurrently with updates.
+/**
+ * The ip::concurrent_prefix_table_v6 class maps IPv6 prefixes, each given as
+ * an address and a prefix length, to integer values, and finds the value of
+ * the longest prefix that contains a given address. Scope IDs are ignored.
+ *
+ * Lookups are made through a reader, and never wait, even while the table is
+ * being modified. Each modification copies the trie nodes on the path to the
+ * changed prefix and publishes the new path atomically, so that a lookup sees
+ * the table either before or after the change. Replaced nodes are freed once
+ * no reader can still be using them, which is when every reader has finished
+ * the lookups it had started before the change.
+ *
+ * Values must be no greater than @c max_value.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for lookups through distinct readers while one
+ * thread modifies the table. Unsafe if more than one thread modifies the
+ * table.
+ */
+class concurrent_prefix_table_v6
+{
+public:
+  /// The type of the values held in the table.
+  typedef std::uint32_t value_type;
+
+  /// The largest value that may be held in the table.
+  static const value_type max_value = 0xFFFFFF;
+
+  /// The value returned by a lookup that matches no prefix.
+  static const value_type no_value = 0xFFFFFFFF;
+
+  /// A handle through which a thread looks up addresses in the table.
+  /**
+   * A reader registers with the table when it is constructed, which may
+   * allocate, and must be destroyed before the table.
+   *
+   * @par Thread Safety
+   * @e Distinct @e objects: Safe.@n
+   * @e Shared @e objects: Unsafe.
+   */
+  class reader
+  {
+  public:
+    /// Register a reader with a table.
+    explicit reader(const concurrent_prefix_table_v6& table)
+      : reader_(table.trie_)
+    {
+    }
+
+    /// Find the value of the longest prefix that contains an address.
+    /**
+     * @returns The value, or @c no_value if no prefix contains the address.
+     */
+    value_type lookup(const address_v6& addr) const STDNET_NOEXCEPT
+    {
+      const address_v6::bytes_type bytes = addr.to_bytes();
+      reader_.enter();
+      const value_type value = reader_.find(
+          load_word(bytes.data()), load_word(bytes.data() + 8));
+      reader_.leave();
+      return value;
+    }
+
+    /// Find the value of the longest prefix that contains an address.
+    /**
+     * @returns The value, or @c no_value if no prefix contains the address.
+     */
+    value_type lookup(const compact_address_v6& addr) const STDNET_NOEXCEPT
+    {
+      reader_.enter();
+      const value_type value = reader_.find(addr.high(), addr.low());
+      reader_.leave();
+      return value;
+    }
+
+    /// Find the values of the longest prefixes that contain a sequence of
+    /// addresses.
+    /**
+     * Equivalent to calling lookup() for each address in turn, except that
+     * all of the lookups see the same version of the table.
+     */
+    void lookup(const compact_address_v6* addrs, std::size_t count,
+        value_type* values) const STDNET_NOEXCEPT
+    {
+      const std::size_t group_size =
+        std::experimental::net::detail::concurrent_prefix_trie::group_size;
+      unsigned long long high[group_size];
+      unsigned long long low[group_size];
+      reader_.enter();
+      for (std::size_t i = 0; i < count; i += group_size)
+      {
+        const std::size_t n = count - i < group_size ? count - i : group_size;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          high[j] = addrs[i + j].high();
+          low[j] = addrs[i + j].low();
+        }
+        reader_.find(high, low, n, values + i);
+      }
+      reader_.leave();
+    }
+
+  private:
+    std::experimental::net::detail::concurrent_prefix_trie::reader reader_;
+  };
+
+  /// Construct an empty table.
+  concurrent_prefix_table_v6()
+    : trie_(128)
+  {
+  }
+
+  /// Destroy the table. All readers must have been destroyed.
+  ~concurrent_prefix_table_v6()
+  {
+  }
+
+  /// Add a prefix to the table, or replace the value of an existing prefix.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 128 or
+   * @c value is greater than @c max_value.
+   */
+  STDNET_DECL void insert(const address_v6& addr, unsigned int prefix_length,
+      value_type value);
+
+  /// Remove a prefix from the table.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @returns @c true if the prefix was in the table.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 128.
+   */
+  STDNET_DECL bool erase(const address_v6& addr, unsigned int prefix_length);
+
+  /// Remove all prefixes from the table.
+  void clear()
+  {
+    trie_.clear();
+  }
+
+  /// Get the number of prefixes in the table.
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return trie_.size();
+  }
+
+private:
+  concurrent_prefix_table_v6(const concurrent_prefix_table_v6&) STDNET_DELETED;
+  concurrent_prefix_table_v6& operator=(
+      const concurrent_prefix_table_v6&) STDNET_DELETED;
+
+  // Load eight bytes, in network byte order, as a 64-bit value.
+  static unsigned long long load_word(const unsigned char* p) STDNET_NOEXCEPT
+  {
+    return (static_cast<unsigned long long>(p[0]) << 56)
+      | (static_cast<unsigned long long>(p[1]) << 48)
+      | (static_cast<unsigned long long>(p[2]) << 40)
+      | (static_cast<unsigned long long>(p[3]) << 32)
+      | (static_cast<unsigned long long>(p[4]) << 24)
+      | (static_cast<unsigned long long>(p[5]) << 16)
+      | (static_cast<unsigned long long>(p[6]) << 8)
+      | static_cast<unsigned long long>(p[7]);
+  }
+
+  std::experimental::net::detail::concurrent_prefix_trie trie_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/concurrent_prefix_table_v6.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_IP_CONCURRENT_PREFIX_TABLE_V6_HPP
@@ -17,10 +17,20 @@
 
 #include "std/net/detail/config.hpp"
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <system_error>
 #include <type_traits>
 
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+#if defined(STDNET_HAS_STD_EXPECTED)
+# include <expected>
+#endif // defined(STDNET_HAS_STD_EXPECTED)
+
 #if !defined(STDNET_NO_IOSTREAM)
 # include <iosfwd>
 #endif // !defined(STDNET_NO_IOSTREAM)
@@ -42,6 +52,120 @@ enum v4_mapped_t { v4_mapped };
 class address;
 class address_v4;
 class address_v6;
+class compact_address_v6;
+class address_iterator_v4;
+class address_iterator_v6;
+class address_range_v4;
+class address_range_v6;
+class network_v4;
+class network_v6;
+
+struct from_chars_result
+{
+  const char* ptr;
+  std::errc ec;
+};
+
+struct to_chars_result
+{
+  char* ptr;
+  std::errc ec;
+};
+
+struct parse_addresses_result
+{
+  std::size_t count;
+  std::size_t valid;
+  const char* ptr;
+};
+
+#if defined(STDNET_HAS_STD_EXPECTED)
+
+template <class T>
+using parse_result = std::expected<T, std::errc>;
+
+#else // defined(STDNET_HAS_STD_EXPECTED)
+
+/// The result of parsing an address: either the address or an error.
+/**
+ * Where std::expected is available, parse_result<T> is
+ * std::expected<T, std::errc>. This class provides the part of its interface
+ * that never throws, so that code written against it works with either.
+ */
+template <class T>
+class parse_result
+{
+public:
+  typedef T value_type;
+  typedef std::errc error_type;
+
+  /// Construct a result that holds a value.
+  STDNET_CONSTEXPR parse_result(const T& value) STDNET_NOEXCEPT
+    : value_(value),
+      error_()
+  {
+  }
+
+  /// Construct a result that holds an error.
+  explicit STDNET_CONSTEXPR parse_result(std::errc error) STDNET_NOEXCEPT
+    : value_(),
+      error_(error)
+  {
+  }
+
+  /// Determine whether the result holds a value.
+  STDNET_CONSTEXPR bool has_value() const STDNET_NOEXCEPT
+  {
+    return error_ == std::errc();
+  }
+
+  /// Determine whether the result holds a value.
+  explicit STDNET_CONSTEXPR operator bool() const STDNET_NOEXCEPT
+  {
+    return error_ == std::errc();
+  }
+
+  /// Get the value. The result must hold one.
+  STDNET_CONSTEXPR const T& operator*() const STDNET_NOEXCEPT
+  {
+    return value_;
+  }
+
+  /// Get the value. The result must hold one.
+  STDNET_CONSTEXPR const T* operator->() const STDNET_NOEXCEPT
+  {
+    return &value_;
+  }
+
+  /// Get the error. The result must hold one.
+  STDNET_CONSTEXPR std::errc error() const STDNET_NOEXCEPT
+  {
+    return error_;
+  }
+
+  /// Get the value if there is one, and otherwise the given default.
+  STDNET_CONSTEXPR T value_or(const T& other) const STDNET_NOEXCEPT
+  {
+    return error_ == std::errc() ? value_ : other;
+  }
+
+private:
+  T value_;
+  std::errc error_;
+};
+
+#endif // defined(STDNET_HAS_STD_EXPECTED)
+
+/// Make a parse_result that holds an error.
+template <class T>
+inline parse_result<T> make_parse_error(std::errc error) STDNET_NOEXCEPT
+{
+#if defined(STDNET_HAS_STD_EXPECTED)
+  return std::unexpected<std::errc>(error);
+#else // defined(STDNET_HAS_STD_EXPECTED)
+  return parse_result<T>(error);
+#endif // defined(STDNET_HAS_STD_EXPECTED)
+}
 
 // address comparisons:
 bool operator==(const address&, const address&) STDNET_NOEXCEPT;
@@ -56,6 +180,22 @@ address make_address(const char*);
 address make_address(const char*, std::error_code&) STDNET_NOEXCEPT;
 address make_address(const std::string&);
 address make_address(const std::string&, std::error_code&) STDNET_NOEXCEPT;
+address make_address(const char*, std::size_t);
+address make_address(const char*, std::size_t, std::error_code&) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+address make_address(std::string_view);
+address make_address(std::string_view, std::error_code&) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+from_chars_result from_chars(const char*, const char*, address&) STDNET_NOEXCEPT;
+parse_result<address> parse_address(const char*) STDNET_NOEXCEPT;
+parse_result<address> parse_address(const std::string&) STDNET_NOEXCEPT;
+parse_result<address> parse_address(const char*, std::size_t) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+parse_result<address> parse_address(std::string_view) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+// address conversion to text:
+to_chars_result to_chars(char*, char*, const address&) STDNET_NOEXCEPT;
 
 #if !defined(STDNET_NO_IOSTREAM)
 
@@ -82,6 +222,22 @@ address_v4 make_address_v4(const char*);
 address_v4 make_address_v4(const char*, error_code&) STDNET_NOEXCEPT;
 address_v4 make_address_v4(const std::string&);
 address_v4 make_address_v4(const std::string&, std::error_code&) STDNET_NOEXCEPT;
+address_v4 make_address_v4(const char*, std::size_t);
+address_v4 make_address_v4(const char*, std::size_t, std::error_code&) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+address_v4 make_address_v4(std::string_view);
+address_v4 make_address_v4(std::string_view, std::error_code&) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+from_chars_result from_chars(const char*, const char*, address_v4&) STDNET_NOEXCEPT;
+parse_result<address_v4> parse_address_v4(const char*) STDNET_NOEXCEPT;
+parse_result<address_v4> parse_address_v4(const std::string&) STDNET_NOEXCEPT;
+parse_result<address_v4> parse_address_v4(const char*, std::size_t) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+parse_result<address_v4> parse_address_v4(std::string_view) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+// address_v4 conversion to text:
+to_chars_result to_chars(char*, char*, const address_v4&) STDNET_NOEXCEPT;
 
 #if !defined(STDNET_NO_IOSTREAM)
 
@@ -107,6 +263,22 @@ address_v6 make_address_v6(const char*);
 address_v6 make_address_v6(const char*, error_code&) STDNET_NOEXCEPT;
 address_v6 make_address_v6(const std::string&);
 address_v6 make_address_v6(const std::string&, error_code&) STDNET_NOEXCEPT;
+address_v6 make_address_v6(const char*, std::size_t);
+address_v6 make_address_v6(const char*, std::size_t, std::error_code&) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+address_v6 make_address_v6(std::string_view);
+address_v6 make_address_v6(std::string_view, std::error_code&) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+from_chars_result from_chars(const char*, const char*, address_v6&) STDNET_NOEXCEPT;
+parse_result<address_v6> parse_address_v6(const char*) STDNET_NOEXCEPT;
+parse_result<address_v6> parse_address_v6(const std::string&) STDNET_NOEXCEPT;
+parse_result<address_v6> parse_address_v6(const char*, std::size_t) STDNET_NOEXCEPT;
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+parse_result<address_v6> parse_address_v6(std::string_view) STDNET_NOEXCEPT;
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+// address_v6 conversion to text:
+to_chars_result to_chars(char*, char*, const address_v6&) STDNET_NOEXCEPT;
 
 #if !defined(STDNET_NO_IOSTREAM)
 
@@ -117,6 +289,43 @@ template<class CharT, class Traits>
 
 #endif // !defined(STDNET_NO_IOSTREAM)
 
+// compact_address_v6 comparisons:
+bool operator==(const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+bool operator!=(const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+bool operator< (const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+bool operator> (const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+bool operator<=(const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+bool operator>=(const compact_address_v6&, const compact_address_v6&) STDNET_NOEXCEPT;
+
+// bulk address creation:
+template <class String, class Address>
+  parse_addresses_result parse_addresses(const String*, std::size_t,
+    Address*, std::uint64_t*) STDNET_NOEXCEPT;
+parse_addresses_result parse_addresses(const char*, const char*, char,
+  address_v4*, std::size_t, std::uint64_t*) STDNET_NOEXCEPT;
+parse_addresses_result parse_addresses(const char*, const char*, char,
+  address_v6*, std::size_t, std::uint64_t*) STDNET_NOEXCEPT;
+parse_addresses_result parse_addresses(const char*, const char*, char,
+  address*, std::size_t, std::uint64_t*) STDNET_NOEXCEPT;
+
+#if defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+// bulk address loading:
+template <class Address> struct load_addresses_result;
+load_addresses_result<address> load_addresses(const char*, std::size_t);
+load_addresses_result<address> load_addresses(const char*, std::size_t,
+  std::error_code&);
+load_addresses_result<address_v4> load_addresses_v4(const char*,
+  std::size_t);
+load_addresses_result<address_v4> load_addresses_v4(const char*, std::size_t,
+  std::error_code&);
+load_addresses_result<address_v6> load_addresses_v6(const char*,
+  std::size_t);
+load_addresses_result<address_v6> load_addresses_v6(const char*, std::size_t,
+  std::error_code&);
+
+#endif // defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
 class bad_address_cast;
 
 // address conversion:
@@ -15,7 +15,6 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include "std/net/detail/throw_error.hpp"
 #include "std/net/ip/address_cast.hpp"
 
 #include "std/net/detail/push_options.hpp"
@@ -47,19 +46,10 @@ template <typename Elem, typename Traits>
 std::basic_ostream<Elem, Traits>& operator<<(
     std::basic_ostream<Elem, Traits>& os, const address& addr)
 {
-  std::error_code ec;
-  std::string s = addr.to_string(ec);
-  if (ec)
-  {
-    if (os.exceptions() & std::basic_ostream<Elem, Traits>::failbit)
-      std::experimental::net::detail::throw_error(ec);
-    else
-      os.setstate(std::basic_ostream<Elem, Traits>::failbit);
-  }
-  else
-    for (std::string::iterator i = s.begin(); i != s.end(); ++i)
-      os << os.widen(*i);
-  return os;
+  // An address that is neither IPv4 nor IPv6 throws bad_address_cast.
+  if (addr.is_v6())
+    return os << address_cast<address_v6>(addr);
+  return os << address_cast<address_v4>(addr);
 }
 
 #endif // !defined(STDNET_NO_IOSTREAM)
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstring>
 #include <system_error>
 #include <typeinfo>
 #include "std/net/detail/throw_error.hpp"
@@ -33,19 +35,21 @@ namespace ip {
 std::string address::to_string() const
 {
   if (type_ == ipv4)
-    return ipv4_address_.to_string();
+    return v4().to_string();
   if (type_ == ipv6)
-    return ipv6_address_.to_string();
-  throw bad_address_cast();
+    return v6().to_string();
+  std::experimental::net::detail::throw_exception(bad_address_cast());
+  return std::string();
 }
 
 std::string address::to_string(std::error_code& ec) const
 {
   if (type_ == ipv4)
-    return ipv4_address_.to_string(ec);
+    return v4().to_string(ec);
   if (type_ == ipv6)
-    return ipv6_address_.to_string(ec);
-  throw bad_address_cast();
+    return v6().to_string(ec);
+  std::experimental::net::detail::throw_exception(bad_address_cast());
+  return std::string();
 }
 
 address make_address(const char* str)
@@ -59,26 +63,134 @@ address make_address(const char* str)
 address make_address(const char* str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  address_v6 ipv6_address = make_address_v6(str, ec);
-  if (!ec)
-    return ipv6_address;
-
-  address_v4 ipv4_address = make_address_v4(str, ec);
-  if (!ec)
-    return ipv4_address;
-
-  return address();
+  using namespace std; // For strlen.
+  return make_address(str, strlen(str), ec);
 }
 
 address make_address(const std::string& str)
 {
-  return make_address(str.c_str());
+  return make_address(str.data(), str.size());
 }
 
 address make_address(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  return make_address(str.c_str(), ec);
+  return make_address(str.data(), str.size(), ec);
+}
+
+address make_address(const char* str, std::size_t len)
+{
+  std::error_code ec;
+  address addr = make_address(str, len, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return addr;
+}
+
+address make_address(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  parse_result<address> result = parse_address(str, len);
+  if (!result)
+  {
+    ec = std::experimental::net::detail::syserrc::invalid_argument;
+    return address();
+  }
+
+  ec = std::error_code();
+  return *result;
+}
+
+from_chars_result from_chars(const char* first, const char* last,
+    address& addr) STDNET_NOEXCEPT
+{
+  // As for make_address, a colon within the first five characters decides
+  // the family. This also holds for the prefix of a longer string.
+  for (std::size_t i = 0; i < 5 && first + i != last; ++i)
+  {
+    if (first[i] == ':')
+    {
+      address_v6 ipv6_address;
+      from_chars_result result = from_chars(first, last, ipv6_address);
+      if (result.ec == std::errc())
+        addr = ipv6_address;
+      return result;
+    }
+  }
+
+  address_v4 ipv4_address;
+  from_chars_result result = from_chars(first, last, ipv4_address);
+  if (result.ec == std::errc())
+    addr = ipv4_address;
+  return result;
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+address make_address(std::string_view str)
+{
+  return make_address(str.data(), str.size());
+}
+
+address make_address(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  return make_address(str.data(), str.size(), ec);
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address> parse_address(const char* str) STDNET_NOEXCEPT
+{
+  using namespace std; // For strlen.
+  return parse_address(str, strlen(str));
+}
+
+parse_result<address> parse_address(const std::string& str) STDNET_NOEXCEPT
+{
+  return parse_address(str.data(), str.size());
+}
+
+parse_result<address> parse_address(const char* str,
+    std::size_t len) STDNET_NOEXCEPT
+{
+  // Every valid IPv6 address has a colon within its first five characters,
+  // and no valid IPv4 address has one, so only one parser need be tried.
+  for (std::size_t i = 0; i < 5 && i < len; ++i)
+  {
+    if (str[i] == ':')
+    {
+      parse_result<address_v6> result = parse_address_v6(str, len);
+      if (!result)
+        return make_parse_error<address>(result.error());
+      return address(*result);
+    }
+  }
+
+  parse_result<address_v4> result = parse_address_v4(str, len);
+  if (!result)
+    return make_parse_error<address>(result.error());
+  return address(*result);
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address> parse_address(std::string_view str) STDNET_NOEXCEPT
+{
+  return parse_address(str.data(), str.size());
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+to_chars_result to_chars(char* first, char* last,
+    const address& addr) STDNET_NOEXCEPT
+{
+  if (addr.is_v4())
+    return to_chars(first, last, address_cast<address_v4>(addr));
+  if (addr.is_v6())
+    return to_chars(first, last, address_cast<address_v6>(addr));
+
+  to_chars_result result = { first, std::errc::invalid_argument };
+  return result;
 }
 
 } // namespace ip
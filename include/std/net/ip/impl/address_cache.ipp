@@ -0,0 +1,147 @@
+//
+// ip/impl/address_cache.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_ADDRESS_CACHE_IPP
+#define STDNET_IP_IMPL_ADDRESS_CACHE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstring>
+#include "std/net/detail/system_errors.hpp"
+#include "std/net/detail/throw_error.hpp"
+#include "std/net/ip/address_cache.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+address_cache::address_cache(std::size_t capacity)
+  : set_mask_(0),
+    hits_(0),
+    misses_(0)
+{
+  std::size_t sets = 1;
+  while (sets * 2 < capacity)
+    sets *= 2;
+
+  entries_.resize(sets * 2);
+  set_mask_ = static_cast<std::uint32_t>(sets - 1);
+  clear();
+}
+
+void address_cache::clear() STDNET_NOEXCEPT
+{
+  for (std::size_t i = 0; i < entries_.size(); ++i)
+    entries_[i].length = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+address address_cache::make_address(const char* str)
+{
+  std::error_code ec;
+  address addr = make_address(str, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return addr;
+}
+
+address address_cache::make_address(const char* str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  using namespace std; // For strlen.
+  return make_address(str, strlen(str), ec);
+}
+
+address address_cache::make_address(const std::string& str)
+{
+  return make_address(str.data(), str.size());
+}
+
+address address_cache::make_address(const std::string& str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  return make_address(str.data(), str.size(), ec);
+}
+
+address address_cache::make_address(const char* str, std::size_t len)
+{
+  std::error_code ec;
+  address addr = make_address(str, len, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return addr;
+}
+
+address address_cache::make_address(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  parse_result<address> result = parse(str, len);
+  if (!result)
+  {
+    ec = std::experimental::net::detail::syserrc::invalid_argument;
+    return address();
+  }
+
+  ec = std::error_code();
+  return *result;
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+address address_cache::make_address(std::string_view str)
+{
+  return make_address(str.data(), str.size());
+}
+
+address address_cache::make_address(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  return make_address(str.data(), str.size(), ec);
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+void address_cache::promote(entry* set) STDNET_NOEXCEPT
+{
+  entry tmp = set[0];
+  set[0] = set[1];
+  set[1] = tmp;
+}
+
+parse_result<address> address_cache::insert(entry* set, std::uint32_t h,
+    const char* str, std::size_t len) STDNET_NOEXCEPT
+{
+  ++misses_;
+  parse_result<address> result = parse_address(str, len);
+  if (result)
+  {
+    set[1] = set[0];
+    set[0].value = *result;
+    set[0].hash = h;
+    set[0].length = static_cast<unsigned char>(len);
+    std::memcpy(set[0].text, str, len);
+  }
+
+  return result;
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_IMPL_ADDRESS_CACHE_IPP
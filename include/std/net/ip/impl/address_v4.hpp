@@ -17,6 +17,9 @@
 
 #if !defined(STDNET_NO_IOSTREAM)
 
+#include <cstddef>
+#include "std/net/detail/ostream_ops.hpp"
+#include "std/net/detail/text_ops.hpp"
 #include "std/net/detail/throw_error.hpp"
 
 #include "std/net/detail/push_options.hpp"
@@ -30,18 +33,19 @@ template <typename Elem, typename Traits>
 std::basic_ostream<Elem, Traits>& operator<<(
     std::basic_ostream<Elem, Traits>& os, const address_v4& addr)
 {
-  std::error_code ec;
-  std::string s = addr.to_string(ec);
-  if (ec)
+  char text[std::experimental::net::detail::text_ops::max_v4_text_len + 1];
+  const to_chars_result result = to_chars(text, text + sizeof(text), addr);
+  if (result.ec != std::errc())
   {
     if (os.exceptions() & std::basic_ostream<Elem, Traits>::failbit)
-      std::experimental::net::detail::throw_error(ec);
+      std::experimental::net::detail::throw_error(
+          std::make_error_code(result.ec));
     else
       os.setstate(std::basic_ostream<Elem, Traits>::failbit);
   }
   else
-    for (std::string::iterator i = s.begin(); i != s.end(); ++i)
-      os << os.widen(*i);
+    std::experimental::net::detail::ostream_ops::write_text(
+        os, text, static_cast<std::size_t>(result.ptr - text));
   return os;
 }
 
@@ -17,9 +17,11 @@
 
 #include "std/net/detail/config.hpp"
 #include <climits>
+#include <cstring>
 #include <stdexcept>
 #include "std/net/detail/socket_ops.hpp"
 #include "std/net/detail/system_errors.hpp"
+#include "std/net/detail/text_ops.hpp"
 #include "std/net/detail/throw_error.hpp"
 #include "std/net/detail/throw_exception.hpp"
 #include "std/net/ip/address_v4.hpp"
@@ -41,14 +43,13 @@ std::string address_v4::to_string() const
 
 std::string address_v4::to_string(std::error_code& ec) const
 {
-  char addr_str[std::experimental::net::detail::max_addr_v4_str_len];
-  const char* addr =
-    std::experimental::net::detail::socket_ops::inet_ntop(
-        AF_INET, bytes_.data(), addr_str,
-        std::experimental::net::detail::max_addr_v4_str_len, 0, ec);
-  if (addr == 0)
-    return std::string();
-  return addr;
+  char addr_str[std::experimental::net::detail::text_ops::max_v4_text_len + 1];
+  const bytes_type bytes = to_bytes();
+  const std::size_t length =
+    std::experimental::net::detail::text_ops::format_v4(
+        bytes.data(), addr_str);
+  ec = std::error_code();
+  return std::string(addr_str, length);
 }
 
 address_v4 make_address_v4(const char* str)
@@ -62,22 +63,149 @@ address_v4 make_address_v4(const char* str)
 address_v4 make_address_v4(const char* str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  address_v4::bytes_type bytes;
-  if (std::experimental::net::detail::socket_ops::inet_pton(
-        AF_INET, str, bytes.data(), 0, ec) <= 0)
-    return address_v4();
-  return address_v4(bytes);
+  // Find the end of the string, giving up as soon as it is too long to be a
+  // valid address.
+  std::size_t len = 0;
+  while (len <= std::experimental::net::detail::text_ops::max_v4_text_len
+      && str[len] != 0)
+    ++len;
+
+  return make_address_v4(str, len, ec);
 }
 
 address_v4 make_address_v4(const std::string& str)
 {
-  return make_address_v4(str.c_str());
+  return make_address_v4(str.data(), str.size());
 }
 
 address_v4 make_address_v4(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  return make_address_v4(str.c_str(), ec);
+  return make_address_v4(str.data(), str.size(), ec);
+}
+
+address_v4 make_address_v4(const char* str, std::size_t len)
+{
+  std::error_code ec;
+  address_v4 addr = make_address_v4(str, len, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return addr;
+}
+
+address_v4 make_address_v4(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  parse_result<address_v4> result = parse_address_v4(str, len);
+  if (!result)
+  {
+    ec = std::experimental::net::detail::syserrc::invalid_argument;
+    return address_v4();
+  }
+
+  ec = std::error_code();
+  return *result;
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+address_v4 make_address_v4(std::string_view str)
+{
+  return make_address_v4(str.data(), str.size());
+}
+
+address_v4 make_address_v4(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  return make_address_v4(str.data(), str.size(), ec);
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address_v4> parse_address_v4(const char* str) STDNET_NOEXCEPT
+{
+  // As for make_address_v4, give up as soon as the string is too long.
+  std::size_t len = 0;
+  while (len <= std::experimental::net::detail::text_ops::max_v4_text_len
+      && str[len] != 0)
+    ++len;
+
+  return parse_address_v4(str, len);
+}
+
+parse_result<address_v4> parse_address_v4(
+    const std::string& str) STDNET_NOEXCEPT
+{
+  return parse_address_v4(str.data(), str.size());
+}
+
+parse_result<address_v4> parse_address_v4(const char* str,
+    std::size_t len) STDNET_NOEXCEPT
+{
+  address_v4::bytes_type bytes;
+  if (!std::experimental::net::detail::text_ops::parse_v4(
+        str, str + len, bytes.data()))
+    return make_parse_error<address_v4>(std::errc::invalid_argument);
+
+  return address_v4(bytes);
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address_v4> parse_address_v4(
+    std::string_view str) STDNET_NOEXCEPT
+{
+  return parse_address_v4(str.data(), str.size());
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+to_chars_result to_chars(char* first, char* last,
+    const address_v4& addr) STDNET_NOEXCEPT
+{
+  using namespace std; // For memcpy.
+
+  const address_v4::bytes_type bytes = addr.to_bytes();
+  const std::size_t space = static_cast<std::size_t>(last - first);
+
+  // Format directly into the caller's buffer when it has room for the
+  // formatter's overrun.
+  if (space > std::experimental::net::detail::text_ops::max_v4_text_len)
+  {
+    to_chars_result result = { first +
+      std::experimental::net::detail::text_ops::format_v4(
+          bytes.data(), first), std::errc() };
+    return result;
+  }
+
+  char buffer[std::experimental::net::detail::text_ops::max_v4_text_len + 1];
+  const std::size_t length =
+    std::experimental::net::detail::text_ops::format_v4(bytes.data(), buffer);
+  if (length > space)
+  {
+    to_chars_result result = { last, std::errc::value_too_large };
+    return result;
+  }
+
+  memcpy(first, buffer, length);
+  to_chars_result result = { first + length, std::errc() };
+  return result;
+}
+
+from_chars_result from_chars(const char* first, const char* last,
+    address_v4& addr) STDNET_NOEXCEPT
+{
+  address_v4::bytes_type bytes;
+  const char* end = std::experimental::net::detail::text_ops::parse_v4_prefix(
+      first, last, bytes.data());
+  if (end == 0)
+  {
+    from_chars_result result = { first, std::errc::invalid_argument };
+    return result;
+  }
+
+  addr = address_v4(bytes);
+  from_chars_result result = { end, std::errc() };
+  return result;
 }
 
 } // namespace ip
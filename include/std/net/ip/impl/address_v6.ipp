@@ -16,8 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "std/net/detail/config.hpp"
+#include <cstring>
 #include "std/net/detail/socket_ops.hpp"
 #include "std/net/detail/system_errors.hpp"
+#include "std/net/detail/text_ops.hpp"
 #include "std/net/detail/throw_error.hpp"
 #include "std/net/detail/throw_exception.hpp"
 #include "std/net/ip/address_v6.hpp"
@@ -39,15 +41,13 @@ std::string address_v6::to_string() const
 
 std::string address_v6::to_string(std::error_code& ec) const
 {
-  char addr_str[std::experimental::net::detail::max_addr_v6_str_len];
-  const char* addr =
-    std::experimental::net::detail::socket_ops::inet_ntop(
-        AF_INET6, bytes_.data(), addr_str,
-        std::experimental::net::detail::max_addr_v6_str_len,
-        scope_id_, ec);
-  if (addr == 0)
-    return std::string();
-  return addr;
+  char addr_str[
+    std::experimental::net::detail::text_ops::max_v6_scoped_text_len + 3];
+  const std::size_t length =
+    std::experimental::net::detail::text_ops::format_v6(
+        bytes_.data(), scope_id_, addr_str);
+  ec = std::error_code();
+  return std::string(addr_str, length);
 }
 
 address_v6 make_address_v6(const char* str)
@@ -61,23 +61,143 @@ address_v6 make_address_v6(const char* str)
 address_v6 make_address_v6(const char* str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  address_v6::bytes_type bytes;
-  unsigned long scope_id = 0;
-  if (std::experimental::net::detail::socket_ops::inet_pton(
-        AF_INET6, str, bytes.data(), &scope_id, ec) <= 0)
-    return address_v6();
-  return address_v6(bytes, scope_id);
+  using namespace std; // For strlen.
+  return make_address_v6(str, strlen(str), ec);
 }
 
 address_v6 make_address_v6(const std::string& str)
 {
-  return make_address_v6(str.c_str());
+  return make_address_v6(str.data(), str.size());
 }
 
 address_v6 make_address_v6(const std::string& str,
     std::error_code& ec) STDNET_NOEXCEPT
 {
-  return make_address_v6(str.c_str(), ec);
+  return make_address_v6(str.data(), str.size(), ec);
+}
+
+address_v6 make_address_v6(const char* str, std::size_t len)
+{
+  std::error_code ec;
+  address_v6 addr = make_address_v6(str, len, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return addr;
+}
+
+address_v6 make_address_v6(const char* str, std::size_t len,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  parse_result<address_v6> result = parse_address_v6(str, len);
+  if (!result)
+  {
+    ec = std::experimental::net::detail::syserrc::invalid_argument;
+    return address_v6();
+  }
+
+  ec = std::error_code();
+  return *result;
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+address_v6 make_address_v6(std::string_view str)
+{
+  return make_address_v6(str.data(), str.size());
+}
+
+address_v6 make_address_v6(std::string_view str,
+    std::error_code& ec) STDNET_NOEXCEPT
+{
+  return make_address_v6(str.data(), str.size(), ec);
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address_v6> parse_address_v6(const char* str) STDNET_NOEXCEPT
+{
+  using namespace std; // For strlen.
+  return parse_address_v6(str, strlen(str));
+}
+
+parse_result<address_v6> parse_address_v6(
+    const std::string& str) STDNET_NOEXCEPT
+{
+  return parse_address_v6(str.data(), str.size());
+}
+
+parse_result<address_v6> parse_address_v6(const char* str,
+    std::size_t len) STDNET_NOEXCEPT
+{
+  address_v6::bytes_type bytes;
+  unsigned long scope_id = 0;
+  if (!std::experimental::net::detail::text_ops::parse_v6(
+        str, str + len, bytes.data(), scope_id))
+    return make_parse_error<address_v6>(std::errc::invalid_argument);
+
+  return address_v6(bytes, scope_id);
+}
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+
+parse_result<address_v6> parse_address_v6(
+    std::string_view str) STDNET_NOEXCEPT
+{
+  return parse_address_v6(str.data(), str.size());
+}
+
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+to_chars_result to_chars(char* first, char* last,
+    const address_v6& addr) STDNET_NOEXCEPT
+{
+  using namespace std; // For memcpy.
+
+  const address_v6::bytes_type bytes = addr.to_bytes();
+  const std::size_t space = static_cast<std::size_t>(last - first);
+
+  // Format directly into the caller's buffer when it has room for the
+  // formatter's overrun.
+  if (space >=
+      std::experimental::net::detail::text_ops::max_v6_scoped_text_len + 3)
+  {
+    to_chars_result result = { first +
+      std::experimental::net::detail::text_ops::format_v6(
+          bytes.data(), addr.scope_id(), first), std::errc() };
+    return result;
+  }
+
+  char buffer[
+    std::experimental::net::detail::text_ops::max_v6_scoped_text_len + 3];
+  const std::size_t length =
+    std::experimental::net::detail::text_ops::format_v6(
+        bytes.data(), addr.scope_id(), buffer);
+  if (length > space)
+  {
+    to_chars_result result = { last, std::errc::value_too_large };
+    return result;
+  }
+
+  memcpy(first, buffer, length);
+  to_chars_result result = { first + length, std::errc() };
+  return result;
+}
+
+from_chars_result from_chars(const char* first, const char* last,
+    address_v6& addr) STDNET_NOEXCEPT
+{
+  address_v6::bytes_type bytes;
+  unsigned long scope_id = 0;
+  const char* end = std::experimental::net::detail::text_ops::parse_v6_prefix(
+      first, last, bytes.data(), scope_id);
+  if (end == 0)
+  {
+    from_chars_result result = { first, std::errc::invalid_argument };
+    return result;
+  }
+
+  addr = address_v6(bytes, scope_id);
+  from_chars_result result = { end, std::errc() };
+  return result;
 }
 
 } // namespace ip
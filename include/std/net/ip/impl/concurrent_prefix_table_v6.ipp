@@ -0,0 +1,76 @@
+//
+// ip/impl/concurrent_prefix_table_v6.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_CONCURRENT_PREFIX_TABLE_V6_IPP
+#define STDNET_IP_IMPL_CONCURRENT_PREFIX_TABLE_V6_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC)
+
+#include <stdexcept>
+#include "std/net/detail/throw_exception.hpp"
+#include "std/net/ip/concurrent_prefix_table_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+void concurrent_prefix_table_v6::insert(const address_v6& addr,
+    unsigned int prefix_length, value_type value)
+{
+  if (prefix_length > 128)
+  {
+    std::out_of_range ex("concurrent_prefix_table_v6 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  if (value > max_value)
+  {
+    std::out_of_range ex("concurrent_prefix_table_v6 value");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const address_v6::bytes_type bytes = addr.to_bytes();
+  trie_.insert(load_word(bytes.data()), load_word(bytes.data() + 8),
+      prefix_length, value);
+}
+
+bool concurrent_prefix_table_v6::erase(const address_v6& addr,
+    unsigned int prefix_length)
+{
+  if (prefix_length > 128)
+  {
+    std::out_of_range ex("concurrent_prefix_table_v6 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const address_v6::bytes_type bytes = addr.to_bytes();
+  return trie_.erase(load_word(bytes.data()), load_word(bytes.data() + 8),
+      prefix_length);
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // defined(STDNET_HAS_STD_ATOMIC)
+
+#endif // STDNET_IP_IMPL_CONCURRENT_PREFIX_TABLE_V6_IPP
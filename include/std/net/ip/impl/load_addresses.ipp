@@ -0,0 +1,262 @@
+//
+// ip/impl/load_addresses.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_LOAD_ADDRESSES_IPP
+#define STDNET_IP_IMPL_LOAD_ADDRESSES_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include "std/net/detail/mapped_file.hpp"
+#include "std/net/detail/throw_error.hpp"
+#include "std/net/detail/work_stealing.hpp"
+#include "std/net/ip/load_addresses.hpp"
+#include "std/net/ip/parse_addresses.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// The bounds on the size of the chunks that a file is split into. There are
+// enough chunks for each thread to have several to steal from, but not so
+// many that the cost of each is noticeable.
+const std::size_t min_load_chunk_size = std::size_t(64) << 10;
+const std::size_t max_load_chunk_size = std::size_t(16) << 20;
+const std::size_t load_chunks_per_thread = 16;
+
+// The typical length of a line, used to size the vector for each chunk.
+const std::size_t load_chunk_bytes_per_line = 14;
+
+// The addresses and failures from one chunk, with line numbers that count from
+// zero at the start of the chunk.
+template <class Address>
+struct load_chunk
+{
+  const char* first;
+  const char* last;
+  std::size_t lines;
+  std::vector<Address> addresses;
+  std::vector<std::size_t> failed_lines;
+};
+
+// Parses the lines of a chunk in batches, directly into the chunk's vector.
+// Only a batch that contains an invalid line needs to be compacted.
+template <class Address>
+void parse_load_chunk(load_chunk<Address>& chunk)
+{
+  const std::size_t batch_size = 4 * parse_group_size;
+  const std::size_t status_size = batch_size / parse_group_size;
+  std::uint64_t status[status_size];
+
+  std::vector<Address>& addrs = chunk.addresses;
+  addrs.reserve((chunk.last - chunk.first) / load_chunk_bytes_per_line);
+
+  chunk.lines = 0;
+  const char* p = chunk.first;
+  while (p != chunk.last)
+  {
+    const std::size_t n = addrs.size();
+    addrs.resize(n + batch_size);
+    const ip::parse_addresses_result r =
+      ip::parse_addresses(p, chunk.last, '\n', &addrs[n], batch_size, status);
+
+    std::size_t valid = r.count;
+    if (r.valid != r.count)
+    {
+      valid = 0;
+      for (std::size_t i = 0; i < r.count; ++i)
+      {
+        if ((status[i / parse_group_size] >> (i % parse_group_size)) & 1)
+          addrs[n + valid++] = addrs[n + i];
+        else
+          chunk.failed_lines.push_back(chunk.lines + i);
+      }
+    }
+
+    addrs.resize(n + valid);
+    chunk.lines += r.count;
+    p = r.ptr;
+  }
+}
+
+template <class Address>
+struct parse_load_chunks
+{
+  std::vector<load_chunk<Address> >* chunks;
+
+  void operator()(std::size_t i) const
+  {
+    parse_load_chunk((*chunks)[i]);
+  }
+};
+
+template <class Address>
+struct copy_load_chunks
+{
+  std::vector<load_chunk<Address> >* chunks;
+  const std::size_t* offsets;
+  Address* addresses;
+
+  void operator()(std::size_t i) const
+  {
+    std::vector<Address>& chunk_addresses = (*chunks)[i].addresses;
+    std::copy(chunk_addresses.begin(), chunk_addresses.end(),
+        addresses + offsets[i]);
+    std::vector<Address>().swap(chunk_addresses);
+  }
+};
+
+template <class Address>
+ip::load_addresses_result<Address> load_addresses(
+    const char* path, std::size_t threads, std::error_code& ec)
+{
+  ip::load_addresses_result<Address> result;
+
+  mapped_file file;
+  file.open(path, ec);
+  if (ec)
+    return result;
+
+  if (threads == 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads == 0)
+    threads = 1;
+
+  // Split the file into chunks that each end just after a newline.
+  const char* data = file.data();
+  const std::size_t size = file.size();
+  const std::size_t chunk_size = (std::min)((std::max)(
+        size / (threads * load_chunks_per_thread), min_load_chunk_size),
+      max_load_chunk_size);
+  std::vector<load_chunk<Address> > chunks;
+  for (std::size_t offset = 0; offset != size; )
+  {
+    std::size_t next = size;
+    if (size - offset > chunk_size)
+    {
+      const void* newline = std::memchr(data + offset + chunk_size - 1,
+          '\n', size - offset - chunk_size + 1);
+      if (newline)
+        next = static_cast<const char*>(newline) - data + 1;
+    }
+
+    chunks.push_back(load_chunk<Address>());
+    chunks.back().first = data + offset;
+    chunks.back().last = data + next;
+    offset = next;
+  }
+
+  parse_load_chunks<Address> parse = { &chunks };
+  run_work_stealing(chunks.size(), threads, parse);
+
+  // Place each chunk's results after those of the chunks before it. The
+  // failures are few and are renumbered here, while the addresses are copied
+  // in parallel.
+  std::vector<std::size_t> offsets(chunks.size());
+  std::size_t total = 0, line = 1;
+  for (std::size_t i = 0; i < chunks.size(); ++i)
+  {
+    offsets[i] = total;
+    total += chunks[i].addresses.size();
+    for (std::size_t j = 0; j < chunks[i].failed_lines.size(); ++j)
+      result.failed_lines.push_back(line + chunks[i].failed_lines[j]);
+    line += chunks[i].lines;
+  }
+
+  result.addresses.resize(total);
+  if (total > 0)
+  {
+    copy_load_chunks<Address> copy = { &chunks, &offsets[0],
+      &result.addresses[0] };
+    run_work_stealing(chunks.size(), threads, copy);
+  }
+
+  return result;
+}
+
+} // namespace detail
+
+namespace ip {
+
+load_addresses_result<address> load_addresses(
+    const char* path, std::size_t threads)
+{
+  std::error_code ec;
+  load_addresses_result<address> result =
+    std::experimental::net::detail::load_addresses<address>(path, threads, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return result;
+}
+
+load_addresses_result<address> load_addresses(
+    const char* path, std::size_t threads, std::error_code& ec)
+{
+  return std::experimental::net::detail::load_addresses<address>(
+      path, threads, ec);
+}
+
+load_addresses_result<address_v4> load_addresses_v4(
+    const char* path, std::size_t threads)
+{
+  std::error_code ec;
+  load_addresses_result<address_v4> result =
+    std::experimental::net::detail::load_addresses<address_v4>(
+        path, threads, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return result;
+}
+
+load_addresses_result<address_v4> load_addresses_v4(
+    const char* path, std::size_t threads, std::error_code& ec)
+{
+  return std::experimental::net::detail::load_addresses<address_v4>(
+      path, threads, ec);
+}
+
+load_addresses_result<address_v6> load_addresses_v6(
+    const char* path, std::size_t threads)
+{
+  std::error_code ec;
+  load_addresses_result<address_v6> result =
+    std::experimental::net::detail::load_addresses<address_v6>(
+        path, threads, ec);
+  std::experimental::net::detail::throw_error(ec);
+  return result;
+}
+
+load_addresses_result<address_v6> load_addresses_v6(
+    const char* path, std::size_t threads, std::error_code& ec)
+{
+  return std::experimental::net::detail::load_addresses<address_v6>(
+      path, threads, ec);
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#endif // STDNET_IP_IMPL_LOAD_ADDRESSES_IPP
@@ -0,0 +1,263 @@
+//
+// ip/impl/parse_addresses.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_PARSE_ADDRESSES_IPP
+#define STDNET_IP_IMPL_PARSE_ADDRESSES_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstring>
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/text_ops.hpp"
+#include "std/net/ip/parse_addresses.hpp"
+
+#if defined(STDNET_HAS_AVX2)
+# include <immintrin.h>
+#elif defined(STDNET_HAS_SSE41)
+# include <smmintrin.h>
+#endif // defined(STDNET_HAS_SSE41)
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address_v4* addrs) STDNET_NOEXCEPT
+{
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ip::address_v4::bytes_type bytes;
+    const bool valid = text_ops::parse_v4(
+        strs[i], strs[i] + lengths[i], bytes.data());
+    addrs[i] = valid ? ip::address_v4(bytes) : ip::address_v4();
+    bits |= static_cast<std::uint64_t>(valid) << i;
+  }
+
+  return bits;
+}
+
+std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address_v6* addrs) STDNET_NOEXCEPT
+{
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ip::address_v6::bytes_type bytes;
+    unsigned long scope_id = 0;
+    const bool valid = text_ops::parse_v6(
+        strs[i], strs[i] + lengths[i], bytes.data(), scope_id);
+    addrs[i] = valid ? ip::address_v6(bytes, scope_id) : ip::address_v6();
+    bits |= static_cast<std::uint64_t>(valid) << i;
+  }
+
+  return bits;
+}
+
+std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address* addrs) STDNET_NOEXCEPT
+{
+  // As for make_address, a colon within the first five characters selects the
+  // IPv6 parser.
+  std::uint64_t bits = 0;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const std::size_t prefix = lengths[i] < 5 ? lengths[i] : 5;
+    std::uint64_t valid;
+    if (std::memchr(strs[i], ':', prefix))
+    {
+      ip::address_v6 addr;
+      valid = parse_address_group(strs + i, lengths + i, 1, &addr);
+      addrs[i] = valid ? ip::address(addr) : ip::address();
+    }
+    else
+    {
+      ip::address_v4 addr;
+      valid = parse_address_group(strs + i, lengths + i, 1, &addr);
+      addrs[i] = valid ? ip::address(addr) : ip::address();
+    }
+    bits |= valid << i;
+  }
+
+  return bits;
+}
+
+#if defined(STDNET_HAS_AVX2)
+
+// The number of characters searched for delimiters at a time.
+const std::size_t delimiter_block_size = 32;
+
+inline unsigned delimiter_mask(const char* block, char delimiter)
+{
+  const __m256i text = _mm256_loadu_si256(
+      reinterpret_cast<const __m256i*>(block));
+  return static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(text, _mm256_set1_epi8(delimiter))));
+}
+
+#elif defined(STDNET_HAS_SSE41)
+
+// The number of characters searched for delimiters at a time.
+const std::size_t delimiter_block_size = 16;
+
+inline unsigned delimiter_mask(const char* block, char delimiter)
+{
+  const __m128i text = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(block));
+  return static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(text, _mm_set1_epi8(delimiter))));
+}
+
+#else // defined(STDNET_HAS_SSE41)
+
+// The number of characters searched for delimiters at a time.
+const std::size_t delimiter_block_size = 8;
+
+inline unsigned delimiter_mask(const char* block, char delimiter)
+{
+  unsigned mask = 0;
+  for (std::size_t i = 0; i < delimiter_block_size; ++i)
+    mask |= static_cast<unsigned>(block[i] == delimiter) << i;
+  return mask;
+}
+
+#endif // defined(STDNET_HAS_SSE41)
+
+// Splits off at most max_count strings from the start of [p, last), advancing
+// p past them. Each block of characters is compared with the delimiter once,
+// and the ends of all of the strings within it are taken from the resulting
+// mask, so that short strings cost less than a search each.
+inline std::size_t split_group(const char*& p, const char* last,
+    char delimiter, const char** strs, std::size_t* lengths,
+    std::size_t max_count) STDNET_NOEXCEPT
+{
+  std::size_t n = 0;
+  const char* block = p;
+  while (n < max_count && p != last)
+  {
+    const std::size_t remaining = static_cast<std::size_t>(last - block);
+    unsigned mask;
+    if (remaining >= delimiter_block_size)
+    {
+      mask = delimiter_mask(block, delimiter);
+    }
+    else
+    {
+      mask = 0;
+      for (std::size_t i = 0; i < remaining; ++i)
+        mask |= static_cast<unsigned>(block[i] == delimiter) << i;
+    }
+
+    for (; mask != 0 && n < max_count; mask &= mask - 1)
+    {
+      const char* end = block + bit_ops::lowest_bit(mask);
+      const char* next = end + 1;
+      if (delimiter == '\n' && end != p && end[-1] == '\r')
+        --end;
+      strs[n] = p;
+      lengths[n++] = static_cast<std::size_t>(end - p);
+      p = next;
+    }
+
+    if (remaining <= delimiter_block_size)
+    {
+      // The last string need not be followed by a delimiter, and a carriage
+      // return at its end is ignored as if it were.
+      if (n < max_count && p != last)
+      {
+        const char* end = last;
+        if (delimiter == '\n' && end[-1] == '\r')
+          --end;
+        strs[n] = p;
+        lengths[n++] = static_cast<std::size_t>(end - p);
+        p = last;
+      }
+      break;
+    }
+
+    block += delimiter_block_size;
+  }
+
+  return n;
+}
+
+// Splits a buffer into groups of strings and parses each group in turn.
+template <class Address>
+ip::parse_addresses_result parse_delimited(const char* first,
+    const char* last, char delimiter, Address* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT
+{
+  const char* strs[parse_group_size];
+  std::size_t lengths[parse_group_size];
+
+  ip::parse_addresses_result result = { 0, 0, first };
+  const char* p = first;
+  while (p != last && result.count < max_count)
+  {
+    const std::size_t n = split_group(p, last, delimiter, strs, lengths,
+        max_count - result.count < parse_group_size
+        ? max_count - result.count : parse_group_size);
+
+    const std::uint64_t bits = parse_address_group(
+        strs, lengths, n, addrs + result.count);
+    status[result.count / parse_group_size] = bits;
+    result.valid += bit_ops::popcount(bits);
+    result.count += n;
+  }
+
+  result.ptr = p;
+  return result;
+}
+
+} // namespace detail
+
+namespace ip {
+
+parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address_v4* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT
+{
+  return std::experimental::net::detail::parse_delimited(
+      first, last, delimiter, addrs, max_count, status);
+}
+
+parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address_v6* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT
+{
+  return std::experimental::net::detail::parse_delimited(
+      first, last, delimiter, addrs, max_count, status);
+}
+
+parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT
+{
+  return std::experimental::net::detail::parse_delimited(
+      first, last, delimiter, addrs, max_count, status);
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_IMPL_PARSE_ADDRESSES_IPP
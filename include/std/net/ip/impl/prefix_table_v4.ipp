@@ -0,0 +1,204 @@
+//
+// ip/impl/prefix_table_v4.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_PREFIX_TABLE_V4_IPP
+#define STDNET_IP_IMPL_PREFIX_TABLE_V4_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "std/net/detail/throw_exception.hpp"
+#include "std/net/ip/prefix_table_v4.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+prefix_table_v4::prefix_table_v4()
+  : tbl24_(std::size_t(1) << 24),
+    size_(0)
+{
+}
+
+void prefix_table_v4::insert(const address_v4& addr,
+    unsigned int prefix_length, value_type value)
+{
+  if (prefix_length > 32)
+  {
+    std::out_of_range ex("prefix_table_v4 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  if (value > max_value)
+  {
+    std::out_of_range ex("prefix_table_v4 value");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const std::uint32_t prefix = mask(
+      static_cast<std::uint32_t>(addr.to_ulong()), prefix_length);
+  std::pair<std::unordered_map<std::uint32_t, value_type>::iterator, bool>
+    result = prefixes_[prefix_length].insert(std::make_pair(prefix, value));
+  if (result.second)
+    ++size_;
+  else
+    result.first->second = value;
+
+  update(prefix, prefix_length, make_entry(value, prefix_length), true);
+}
+
+bool prefix_table_v4::erase(const address_v4& addr, unsigned int prefix_length)
+{
+  if (prefix_length > 32)
+  {
+    std::out_of_range ex("prefix_table_v4 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const std::uint32_t prefix = mask(
+      static_cast<std::uint32_t>(addr.to_ulong()), prefix_length);
+  if (prefixes_[prefix_length].erase(prefix) == 0)
+    return false;
+  --size_;
+
+  // The entries set by the removed prefix revert to the longest remaining
+  // prefix that contains it, if there is one.
+  std::uint32_t entry = 0;
+  for (unsigned int length = prefix_length; length > 0; --length)
+  {
+    std::unordered_map<std::uint32_t, value_type>::const_iterator iter =
+      prefixes_[length - 1].find(mask(prefix, length - 1));
+    if (iter != prefixes_[length - 1].end())
+    {
+      entry = make_entry(iter->second, length - 1);
+      break;
+    }
+  }
+
+  update(prefix, prefix_length, entry, false);
+  return true;
+}
+
+void prefix_table_v4::clear()
+{
+  std::fill(tbl24_.begin(), tbl24_.end(), 0);
+  tbl8_.clear();
+  free_groups_.clear();
+  for (std::size_t i = 0; i < 33; ++i)
+    prefixes_[i].clear();
+  size_ = 0;
+}
+
+void prefix_table_v4::update(std::uint32_t prefix, unsigned int length,
+    std::uint32_t entry, bool adding)
+{
+  if (length <= 24)
+  {
+    const std::size_t first = prefix >> 8;
+    const std::size_t last = first + (std::size_t(1) << (24 - length));
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const std::uint32_t e = tbl24_[i];
+      if (e & extended_flag)
+      {
+        update_group(e & value_mask, 0, 256, length, entry, adding);
+        collapse_group(i);
+      }
+      else if (adding ? (!(e & valid_flag) || entry_length(e) <= length)
+          : ((e & valid_flag) && entry_length(e) == length))
+      {
+        tbl24_[i] = entry;
+      }
+    }
+  }
+  else
+  {
+    const std::size_t i = prefix >> 8;
+    if (!(tbl24_[i] & extended_flag))
+    {
+      if (!adding)
+        return;
+      tbl24_[i] = extended_flag | allocate_group(tbl24_[i]);
+    }
+
+    update_group(tbl24_[i] & value_mask, prefix & 0xFF,
+        std::size_t(1) << (32 - length), length, entry, adding);
+    collapse_group(i);
+  }
+}
+
+void prefix_table_v4::update_group(std::uint32_t group, std::size_t first,
+    std::size_t count, unsigned int length, std::uint32_t entry, bool adding)
+{
+  std::uint32_t* entries = &tbl8_[static_cast<std::size_t>(group) << 8];
+  for (std::size_t i = first; i < first + count; ++i)
+  {
+    const std::uint32_t e = entries[i];
+    if (adding ? (!(e & valid_flag) || entry_length(e) <= length)
+        : ((e & valid_flag) && entry_length(e) == length))
+      entries[i] = entry;
+  }
+}
+
+std::uint32_t prefix_table_v4::allocate_group(std::uint32_t entry)
+{
+  std::uint32_t group;
+  if (!free_groups_.empty())
+  {
+    group = free_groups_.back();
+    free_groups_.pop_back();
+  }
+  else
+  {
+    if ((tbl8_.size() >> 8) > value_mask)
+    {
+      std::length_error ex("prefix_table_v4 too many groups");
+      std::experimental::net::detail::throw_exception(ex);
+    }
+    group = static_cast<std::uint32_t>(tbl8_.size() >> 8);
+    tbl8_.resize(tbl8_.size() + 256);
+  }
+
+  std::uint32_t* entries = &tbl8_[static_cast<std::size_t>(group) << 8];
+  std::fill(entries, entries + 256, entry);
+  return group;
+}
+
+void prefix_table_v4::collapse_group(std::size_t index)
+{
+  const std::uint32_t group = tbl24_[index] & value_mask;
+  const std::uint32_t* entries = &tbl8_[static_cast<std::size_t>(group) << 8];
+  const std::uint32_t e = entries[0];
+  if ((e & valid_flag) && entry_length(e) > 24)
+    return;
+  for (std::size_t i = 1; i < 256; ++i)
+    if (entries[i] != e)
+      return;
+
+  tbl24_[index] = e;
+  free_groups_.push_back(group);
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_IMPL_PREFIX_TABLE_V4_IPP
@@ -0,0 +1,497 @@
+//
+// ip/impl/prefix_table_v6.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_IMPL_PREFIX_TABLE_V6_IPP
+#define STDNET_IP_IMPL_PREFIX_TABLE_V6_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "std/net/detail/prefetch.hpp"
+#include "std/net/detail/throw_exception.hpp"
+#include "std/net/ip/prefix_table_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+namespace detail {
+namespace prefix_table_v6_ops {
+
+// Clear the bits of a prefix beyond its length.
+inline void mask(unsigned long long& high, unsigned long long& low,
+    unsigned int length)
+{
+  if (length < 64)
+  {
+    high = length == 0 ? 0 : high & (~0ULL << (64 - length));
+    low = 0;
+  }
+  else if (length < 128)
+  {
+    low = length == 64 ? 0 : low & (~0ULL << (128 - length));
+  }
+}
+
+// Get the 6 bits of a prefix that start at the given offset.
+inline unsigned int chunk(unsigned long long high, unsigned long long low,
+    unsigned int offset)
+{
+  const unsigned long long bits = offset == 0 ? high
+    : offset < 64 ? (high << offset) | (low >> (64 - offset))
+    : low << (offset - 64);
+  return static_cast<unsigned int>(bits >> 58);
+}
+
+} // namespace prefix_table_v6_ops
+} // namespace detail
+
+prefix_table_v6::prefix_table_v6()
+  : direct_(std::size_t(1) << direct_bits, value_type(no_value)),
+    garbage_(0)
+{
+}
+
+void prefix_table_v6::insert(const address_v6& addr,
+    unsigned int prefix_length, value_type value)
+{
+  if (prefix_length > 128)
+  {
+    std::out_of_range ex("prefix_table_v6 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  if (value > max_value)
+  {
+    std::out_of_range ex("prefix_table_v6 value");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const address_v6::bytes_type bytes = addr.to_bytes();
+  prefix_key key = { load_word(bytes.data()),
+    load_word(bytes.data() + 8), prefix_length };
+  detail::prefix_table_v6_ops::mask(key.high, key.low, prefix_length);
+  prefixes_[key] = value;
+  update(key);
+}
+
+bool prefix_table_v6::erase(const address_v6& addr,
+    unsigned int prefix_length)
+{
+  if (prefix_length > 128)
+  {
+    std::out_of_range ex("prefix_table_v6 prefix length");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const address_v6::bytes_type bytes = addr.to_bytes();
+  prefix_key key = { load_word(bytes.data()),
+    load_word(bytes.data() + 8), prefix_length };
+  detail::prefix_table_v6_ops::mask(key.high, key.low, prefix_length);
+  if (prefixes_.erase(key) == 0)
+    return false;
+
+  update(key);
+  return true;
+}
+
+void prefix_table_v6::clear()
+{
+  std::fill(direct_.begin(), direct_.end(), value_type(no_value));
+  nodes_.clear();
+  values_.clear();
+  garbage_ = 0;
+  prefixes_.clear();
+}
+
+void prefix_table_v6::lookup(const compact_address_v6* addrs,
+    std::size_t count, value_type* values) const STDNET_NOEXCEPT
+{
+  namespace net_detail = std::experimental::net::detail;
+  using net_detail::bit_ops::popcount;
+
+  // Each pass over a group takes every unfinished lookup down one level and
+  // prefetches the node it reaches, so that a pass waits for about one memory
+  // access however many lookups it advances. The direct array entries of the
+  // next group are prefetched while the current group is being looked up.
+  const std::size_t group_size = 64;
+  const node* nodes[group_size];
+  unsigned long long bits[group_size];
+  unsigned long long low[group_size];
+  std::size_t positions[group_size];
+
+  for (std::size_t i = 0; i < count && i < group_size; ++i)
+    net_detail::prefetch(&direct_[addrs[i].high() >> 48]);
+
+  for (std::size_t first = 0; first < count; first += group_size)
+  {
+    const std::size_t last = std::min(first + group_size, count);
+    for (std::size_t i = last; i < count && i < last + group_size; ++i)
+      net_detail::prefetch(&direct_[addrs[i].high() >> 48]);
+
+    std::size_t active = 0;
+    for (std::size_t i = first; i < last; ++i)
+    {
+      const std::uint32_t d = direct_[addrs[i].high() >> 48];
+      if (d & leaf_flag)
+      {
+        values[i] = d == no_value ? no_value : (d & ~leaf_flag);
+      }
+      else
+      {
+        nodes[active] = &nodes_[d];
+        bits[active] = (addrs[i].high() << 16) | (addrs[i].low() >> 48);
+        low[active] = addrs[i].low() << 16;
+        positions[active] = i;
+        net_detail::prefetch(nodes[active]);
+        ++active;
+      }
+    }
+
+    while (active > 0)
+    {
+      std::size_t remaining = 0;
+      for (std::size_t j = 0; j < active; ++j)
+      {
+        const node* n = nodes[j];
+        const unsigned int v = static_cast<unsigned int>(bits[j] >> 58);
+        const unsigned long long below = (2ULL << v) - 1;
+        if (n->vector & (1ULL << v))
+        {
+          nodes[remaining] = &nodes_[n->base1 + popcount(n->vector & below) - 1];
+          bits[remaining] = (bits[j] << stride) | (low[j] >> 58);
+          low[remaining] = low[j] << stride;
+          positions[remaining] = positions[j];
+          net_detail::prefetch(nodes[remaining]);
+          ++remaining;
+        }
+        else
+        {
+          values[positions[j]] =
+            values_[n->base0 + popcount(n->leafvec & below) - 1];
+        }
+      }
+      active = remaining;
+    }
+  }
+}
+
+void prefix_table_v6::update(const prefix_key& key)
+{
+  namespace bit_ops = std::experimental::net::detail::bit_ops;
+  using detail::prefix_table_v6_ops::chunk;
+
+  const std::size_t index = static_cast<std::size_t>(key.high >> 48);
+  if (key.length <= direct_bits)
+  {
+    rebuild(index, index + (std::size_t(1) << (direct_bits - key.length)));
+    return;
+  }
+
+  // Find the deepest node whose children include the one that holds the
+  // prefix's value, or would if the prefix were in the table.
+  std::uint32_t path[(128 - direct_bits) / stride + 1];
+  std::size_t depth = 0;
+  unsigned int offset = direct_bits;
+  path[0] = direct_[index];
+  if (!(path[0] & leaf_flag))
+  {
+    while (key.length > offset + stride)
+    {
+      const node& n = nodes_[path[depth]];
+      const unsigned int c = chunk(key.high, key.low, offset);
+      if (!(n.vector & (1ULL << c)))
+        break;
+      path[++depth] = n.base1
+        + bit_ops::popcount(n.vector & ((2ULL << c) - 1)) - 1;
+      offset += stride;
+    }
+  }
+
+  // Rebuild that node in place. Only the children that the prefix covers can
+  // have changed, and the others keep their subtries. A node with no prefixes
+  // longer than its offset left below it is no longer needed, and its parent
+  // is rebuilt instead. A root node that is no longer needed is replaced by a
+  // value in the direct array.
+  for (;; --depth, offset -= stride)
+  {
+    unsigned long long high = key.high, low = key.low;
+    detail::prefix_table_v6_ops::mask(high, low, offset);
+    prefix_map::const_iterator first, last;
+    find_prefixes(high, low, offset, first, last);
+    const std::uint32_t value = covering_value(high, low, offset);
+
+    if ((path[0] & leaf_flag) || (depth == 0 && first == last))
+    {
+      if (!(path[0] & leaf_flag))
+        garbage_ += count_trie(path[0]);
+      direct_[index] = build_direct(index, value);
+      break;
+    }
+
+    if (first != last)
+    {
+      const unsigned int c = chunk(key.high, key.low, offset);
+      const unsigned int changed = key.length > offset + stride
+        ? 1 : 1u << (offset + stride - key.length);
+
+      const node old = nodes_[path[depth]];
+      garbage_ += bit_ops::popcount(old.vector)
+        + bit_ops::popcount(old.leafvec);
+      for (unsigned int i = c; i < c + changed; ++i)
+        if (old.vector & (1ULL << i))
+          garbage_ += count_trie(old.base1
+              + bit_ops::popcount(old.vector & ((2ULL << i) - 1)) - 1) - 1;
+
+      build_node(path[depth], offset, first, last, value,
+          &old, c, c + changed);
+      break;
+    }
+  }
+
+  if (garbage_ > (nodes_.size() + values_.size()) / 2)
+    rebuild_all();
+}
+
+void prefix_table_v6::rebuild(std::size_t first, std::size_t last)
+{
+  // A short prefix touches many entries, and it is as quick to start again.
+  if (last - first > direct_.size() / 16)
+  {
+    rebuild_all();
+    return;
+  }
+
+  for (std::size_t i = first; i < last; ++i)
+  {
+    const unsigned long long high = static_cast<unsigned long long>(i) << 48;
+    if (!(direct_[i] & leaf_flag))
+      garbage_ += count_trie(direct_[i]);
+    direct_[i] = build_direct(i, covering_value(high, 0, direct_bits));
+  }
+
+  if (garbage_ > (nodes_.size() + values_.size()) / 2)
+    rebuild_all();
+}
+
+void prefix_table_v6::rebuild_all()
+{
+  // Find the value of each direct array entry by applying the prefixes that
+  // are no longer than the index, shortest first.
+  std::vector<std::uint32_t> direct_values(direct_.size(),
+      value_type(no_value));
+  for (unsigned int length = 0; length <= direct_bits; ++length)
+  {
+    for (prefix_map::const_iterator iter = prefixes_.begin();
+        iter != prefixes_.end(); ++iter)
+    {
+      if (iter->first.length == length)
+      {
+        const std::size_t first = static_cast<std::size_t>(
+            iter->first.high >> 48);
+        const std::size_t last =
+          first + (std::size_t(1) << (direct_bits - length));
+        std::fill(direct_values.begin() + first,
+            direct_values.begin() + last, iter->second);
+      }
+    }
+  }
+
+  nodes_.clear();
+  values_.clear();
+  garbage_ = 0;
+  for (std::size_t i = 0; i < direct_.size(); ++i)
+    direct_[i] = build_direct(i, direct_values[i]);
+}
+
+std::uint32_t prefix_table_v6::covering_value(unsigned long long high,
+    unsigned long long low, unsigned int length) const
+{
+  for (unsigned int l = length + 1; l > 0; --l)
+  {
+    prefix_key key = { high, low, l - 1 };
+    detail::prefix_table_v6_ops::mask(key.high, key.low, l - 1);
+    prefix_map::const_iterator iter = prefixes_.find(key);
+    if (iter != prefixes_.end())
+      return iter->second;
+  }
+  return no_value;
+}
+
+void prefix_table_v6::find_prefixes(unsigned long long high,
+    unsigned long long low, unsigned int length,
+    prefix_map::const_iterator& first, prefix_map::const_iterator& last) const
+{
+  // The prefixes that start with the given bits sort after the bits alone and
+  // before the first address that does not start with them.
+  const prefix_key first_key = { high, low, length + 1 };
+  first = prefixes_.lower_bound(first_key);
+
+  unsigned long long next_high, next_low;
+  if (length <= 64)
+  {
+    next_high = high + (1ULL << (64 - length));
+    next_low = 0;
+  }
+  else
+  {
+    next_low = low + (1ULL << (128 - length));
+    next_high = next_low == 0 ? high + 1 : high;
+  }
+
+  if (next_high == 0 && next_low == 0)
+  {
+    last = prefixes_.end();
+  }
+  else
+  {
+    const prefix_key last_key = { next_high, next_low, 0 };
+    last = prefixes_.lower_bound(last_key);
+  }
+}
+
+std::uint32_t prefix_table_v6::build_direct(std::size_t index,
+    std::uint32_t value)
+{
+  prefix_map::const_iterator first, last;
+  find_prefixes(static_cast<unsigned long long>(index) << 48, 0,
+      direct_bits, first, last);
+
+  if (first == last)
+    return leaf_flag | value;
+
+  if (nodes_.size() >= leaf_flag)
+  {
+    std::length_error ex("prefix_table_v6 too many nodes");
+    std::experimental::net::detail::throw_exception(ex);
+  }
+
+  const std::size_t root = nodes_.size();
+  nodes_.push_back(node());
+  build_node(root, direct_bits, first, last, value);
+  return static_cast<std::uint32_t>(root);
+}
+
+void prefix_table_v6::build_node(std::size_t index, unsigned int offset,
+    prefix_map::const_iterator first, prefix_map::const_iterator last,
+    std::uint32_t value, const node* old, unsigned int first_changed,
+    unsigned int last_changed)
+{
+  namespace bit_ops = std::experimental::net::detail::bit_ops;
+  using detail::prefix_table_v6_ops::chunk;
+
+  // Work out which children are nodes, and the value of each child that is
+  // not, from the prefixes that end within the node.
+  value_type child_values[64];
+  unsigned int child_lengths[64];
+  std::fill(child_values, child_values + 64, value);
+  std::fill(child_lengths, child_lengths + 64, 0);
+  unsigned long long vector = 0;
+  for (prefix_map::const_iterator iter = first; iter != last; ++iter)
+  {
+    const unsigned int length = iter->first.length;
+    if (length <= offset)
+      continue;
+
+    const unsigned int c = chunk(iter->first.high, iter->first.low, offset);
+    if (length <= offset + stride)
+    {
+      const unsigned int end = c + (1u << (offset + stride - length));
+      for (unsigned int i = c; i < end; ++i)
+      {
+        if (length > child_lengths[i])
+        {
+          child_values[i] = iter->second;
+          child_lengths[i] = length;
+        }
+      }
+    }
+    else
+    {
+      vector |= 1ULL << c;
+    }
+  }
+
+  // Store the values of the other children, once for each run.
+  unsigned long long leafvec = 0;
+  const std::size_t base0 = values_.size();
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    if (!(vector & (1ULL << i)))
+    {
+      if (values_.size() == base0 || values_.back() != child_values[i])
+      {
+        leafvec |= 1ULL << i;
+        values_.push_back(child_values[i]);
+      }
+    }
+  }
+
+  const std::size_t base1 = nodes_.size();
+  nodes_.resize(base1 + bit_ops::popcount(vector));
+
+  node& n = nodes_[index];
+  n.vector = vector;
+  n.leafvec = leafvec;
+  n.base0 = static_cast<std::uint32_t>(base0);
+  n.base1 = static_cast<std::uint32_t>(base1);
+
+  // The prefixes below the node are ordered by their bits at the offset, so
+  // those for each child node are contiguous.
+  prefix_map::const_iterator iter = first;
+  std::size_t child = base1;
+  for (unsigned int i = 0; i < 64; ++i)
+  {
+    if (vector & (1ULL << i))
+    {
+      while (chunk(iter->first.high, iter->first.low, offset) < i)
+        ++iter;
+      const prefix_map::const_iterator child_first = iter;
+      while (iter != last
+          && chunk(iter->first.high, iter->first.low, offset) == i)
+        ++iter;
+      if (old && (old->vector & (1ULL << i))
+          && (i < first_changed || i >= last_changed))
+        nodes_[child] = nodes_[old->base1
+          + bit_ops::popcount(old->vector & ((2ULL << i) - 1)) - 1];
+      else
+        build_node(child, offset + stride, child_first, iter,
+            child_values[i]);
+      ++child;
+    }
+  }
+}
+
+std::size_t prefix_table_v6::count_trie(std::uint32_t index) const
+{
+  namespace bit_ops = std::experimental::net::detail::bit_ops;
+
+  const node& n = nodes_[index];
+  std::size_t count = 1 + bit_ops::popcount(n.leafvec);
+  const unsigned int children = bit_ops::popcount(n.vector);
+  for (unsigned int i = 0; i < children; ++i)
+    count += count_trie(n.base1 + i);
+  return count;
+}
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_IMPL_PREFIX_TABLE_V6_IPP
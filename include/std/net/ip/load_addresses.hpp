@@ -0,0 +1,114 @@
+//
+// ip/load_addresses.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_LOAD_ADDRESSES_HPP
+#define STDNET_IP_LOAD_ADDRESSES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+
+#if defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#include <cstddef>
+#include <system_error>
+#include <vector>
+#include "std/net/ip/address.hpp"
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/fwd.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// The addresses read from a file, one per line.
+template <class Address>
+struct load_addresses_result
+{
+  /// The valid addresses, in the order of their lines in the file.
+  std::vector<Address> addresses;
+
+  /// The numbers of the lines that are not valid addresses, counting from 1,
+  /// in ascending order.
+  std::vector<std::size_t> failed_lines;
+};
+
+/// Load a file of addresses, one per line.
+/**
+ * The file is mapped into memory and split at line boundaries into chunks,
+ * which are parsed in parallel by @c threads threads, including the calling
+ * thread. Idle threads steal chunks from busy ones. If @c threads is zero,
+ * one thread is used for each hardware thread.
+ *
+ * Lines end with a newline, optionally preceded by a carriage return, and the
+ * last line need not end with one. A line that is not a valid address, which
+ * includes an empty line, is recorded in the failed lines of the result.
+ *
+ * @throws std::system_error if the file cannot be read.
+ */
+STDNET_DECL load_addresses_result<address> load_addresses(
+    const char* path, std::size_t threads = 0);
+
+/// Load a file of addresses, one per line.
+/**
+ * As for the overload that throws. If the file cannot be read, @c ec is set
+ * and the result is empty.
+ */
+STDNET_DECL load_addresses_result<address> load_addresses(
+    const char* path, std::size_t threads, std::error_code& ec);
+
+/// Load a file of IPv4 addresses, one per line.
+/**
+ * As for load_addresses.
+ */
+STDNET_DECL load_addresses_result<address_v4> load_addresses_v4(
+    const char* path, std::size_t threads = 0);
+
+/// Load a file of IPv4 addresses, one per line.
+/**
+ * As for load_addresses.
+ */
+STDNET_DECL load_addresses_result<address_v4> load_addresses_v4(
+    const char* path, std::size_t threads, std::error_code& ec);
+
+/// Load a file of IPv6 addresses, one per line.
+/**
+ * As for load_addresses.
+ */
+STDNET_DECL load_addresses_result<address_v6> load_addresses_v6(
+    const char* path, std::size_t threads = 0);
+
+/// Load a file of IPv6 addresses, one per line.
+/**
+ * As for load_addresses.
+ */
+STDNET_DECL load_addresses_result<address_v6> load_addresses_v6(
+    const char* path, std::size_t threads, std::error_code& ec);
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/load_addresses.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // defined(STDNET_HAS_STD_ATOMIC) && defined(STDNET_HAS_STD_THREAD)
+
+#endif // STDNET_IP_LOAD_ADDRESSES_HPP
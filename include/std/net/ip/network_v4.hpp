@@ -0,0 +1,241 @@
+//
+// ip/network_v4.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_NETWORK_V4_HPP
+#define STDNET_IP_NETWORK_V4_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include "std/net/ip/address_iterator_v4.hpp"
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/throw_exception.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// Represents an IPv4 network, as an address and a prefix length.
+/**
+ * The ip::network_v4 class holds an address and the number of leading bits
+ * of it that identify the network, as in 192.168.1.10/24. The address need
+ * not be the network address itself; canonical() clears the host bits.
+ *
+ * All functions other than the iteration functions may be used in constant
+ * expressions, so that networks in static tables are built at compile time.
+ *
+ * A network_v4 is also a range of its host addresses, which are every
+ * address in the network except the network and broadcast addresses. A /31
+ * or /32 network has no such addresses reserved, and all of its addresses
+ * are hosts.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class network_v4
+{
+public:
+  /// The type of an iterator over the host addresses.
+  typedef address_iterator_v4 iterator;
+
+  /// The type of an iterator over the host addresses.
+  typedef address_iterator_v4 const_iterator;
+
+  /// Default constructor. The network is 0.0.0.0/0.
+  STDNET_CONSTEXPR network_v4() STDNET_NOEXCEPT
+    : address_(),
+      prefix_length_(0)
+  {
+  }
+
+  /// Construct from an address and a prefix length.
+  /**
+   * @throws std::out_of_range if the prefix length is greater than 32.
+   */
+  STDNET_CONSTEXPR network_v4(const address_v4& addr, int prefix_len)
+    : address_(addr),
+      prefix_length_(prefix_len < 0 || prefix_len > 32
+          ? std::experimental::net::detail::throw_exception_as<unsigned char>(
+              std::out_of_range("network_v4 prefix length"))
+          : static_cast<unsigned char>(prefix_len))
+  {
+  }
+
+  /// Construct from an address and a netmask.
+  /**
+   * The prefix length is the number of leading one bits in the mask.
+   *
+   * @throws std::invalid_argument if the one bits in the mask are not
+   * contiguous and leading.
+   */
+  STDNET_CONSTEXPR network_v4(const address_v4& addr, const address_v4& mask)
+    : address_(addr),
+      prefix_length_(prefix_length_from_mask(mask.to_ulong()))
+  {
+  }
+
+  /// Get the address from which the network was constructed.
+  STDNET_CONSTEXPR address_v4 address() const STDNET_NOEXCEPT
+  {
+    return address_;
+  }
+
+  /// Get the prefix length.
+  STDNET_CONSTEXPR int prefix_length() const STDNET_NOEXCEPT
+  {
+    return prefix_length_;
+  }
+
+  /// Get the netmask, in which the first prefix_length() bits are set.
+  STDNET_CONSTEXPR address_v4 netmask() const STDNET_NOEXCEPT
+  {
+    return make_address_v4(mask());
+  }
+
+  /// Get the network address, with all host bits clear.
+  STDNET_CONSTEXPR address_v4 network() const STDNET_NOEXCEPT
+  {
+    return make_address_v4(address_.to_ulong() & mask());
+  }
+
+  /// Get the broadcast address, with all host bits set.
+  STDNET_CONSTEXPR address_v4 broadcast() const STDNET_NOEXCEPT
+  {
+    return make_address_v4(address_.to_ulong() | (~mask() & 0xFFFFFFFF));
+  }
+
+  /// Get the network with the same prefix length whose address is the
+  /// network address.
+  STDNET_CONSTEXPR network_v4 canonical() const STDNET_NOEXCEPT
+  {
+    return network_v4(network(), prefix_length_, 0);
+  }
+
+  /// Determine whether the network is a single host, having a prefix length
+  /// of 32.
+  STDNET_CONSTEXPR bool is_host() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ == 32;
+  }
+
+  /// Determine whether an address is within the network.
+  /**
+   * Compares the leading prefix_length() bits of the address with those of
+   * the network, with one exclusive-or and one mask.
+   */
+  STDNET_CONSTEXPR bool contains(const address_v4& addr) const STDNET_NOEXCEPT
+  {
+    return ((addr.to_ulong() ^ address_.to_ulong()) & mask()) == 0;
+  }
+
+  /// Determine whether the network is within another, and is smaller.
+  STDNET_CONSTEXPR bool is_subnet_of(
+      const network_v4& other) const STDNET_NOEXCEPT
+  {
+    return other.prefix_length_ < prefix_length_ && other.contains(address_);
+  }
+
+  /// Get an iterator to the first host address.
+  iterator begin() const STDNET_NOEXCEPT
+  {
+    return iterator(network()) + first();
+  }
+
+  /// Get an iterator one past the last host address.
+  iterator end() const STDNET_NOEXCEPT
+  {
+    return iterator(broadcast()) + (prefix_length_ >= 31 ? 1 : 0);
+  }
+
+  /// Get the number of host addresses.
+  STDNET_CONSTEXPR std::size_t size() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ >= 31
+      ? static_cast<std::size_t>(1) << (32 - prefix_length_)
+      : (static_cast<std::size_t>(~mask() & 0xFFFFFFFF) - 1);
+  }
+
+  /// Compare two networks for equality.
+  friend STDNET_CONSTEXPR bool operator==(const network_v4& a,
+      const network_v4& b) STDNET_NOEXCEPT
+  {
+    return a.address_.to_ulong() == b.address_.to_ulong()
+      && a.prefix_length_ == b.prefix_length_;
+  }
+
+  /// Compare two networks for inequality.
+  friend STDNET_CONSTEXPR bool operator!=(const network_v4& a,
+      const network_v4& b) STDNET_NOEXCEPT
+  {
+    return !(a == b);
+  }
+
+private:
+  // Construct without checking the prefix length.
+  STDNET_CONSTEXPR network_v4(const address_v4& addr,
+      unsigned char prefix_len, int) STDNET_NOEXCEPT
+    : address_(addr),
+      prefix_length_(prefix_len)
+  {
+  }
+
+  // The mask with the first prefix_length_ bits set.
+  STDNET_CONSTEXPR unsigned long mask() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ == 0 ? 0
+      : (0xFFFFFFFFUL << (32 - prefix_length_)) & 0xFFFFFFFF;
+  }
+
+  // The number of addresses at the start of the network that are not hosts.
+  std::ptrdiff_t first() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ >= 31 ? 0 : 1;
+  }
+
+  // Find the prefix length of a netmask. A valid mask is the mask for the
+  // number of its leading one bits.
+  static STDNET_CONSTEXPR unsigned char prefix_length_from_mask(
+      unsigned long mask)
+  {
+    return check_mask(mask,
+        std::experimental::net::detail::bit_ops::count_leading_ones(
+          static_cast<unsigned long long>(mask) << 32));
+  }
+
+  static STDNET_CONSTEXPR unsigned char check_mask(unsigned long mask,
+      unsigned int ones)
+  {
+    return mask != (ones == 0 ? 0 : (0xFFFFFFFFUL << (32 - ones)) & 0xFFFFFFFF)
+      ? std::experimental::net::detail::throw_exception_as<unsigned char>(
+          std::invalid_argument("network_v4 netmask"))
+      : static_cast<unsigned char>(ones);
+  }
+
+  address_v4 address_;
+  unsigned char prefix_length_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_NETWORK_V4_HPP
@@ -0,0 +1,210 @@
+//
+// ip/network_v6.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_NETWORK_V6_HPP
+#define STDNET_IP_NETWORK_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <stdexcept>
+#include "std/net/detail/throw_exception.hpp"
+#include "std/net/ip/address_iterator_v6.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/compact_address_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// Represents an IPv6 network, as an address and a prefix length.
+/**
+ * The ip::network_v6 class holds an address and the number of leading bits
+ * of it that identify the network, as in 2001:db8::1/64. The address need not
+ * be the network address itself; canonical() clears the host bits. The scope
+ * ID of the address is kept, but is ignored when testing whether the network
+ * contains an address.
+ *
+ * All functions other than the iteration functions may be used in constant
+ * expressions.
+ *
+ * A network_v6 is also a range of all of the addresses in the network.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class network_v6
+{
+public:
+  /// The type of an iterator over the addresses in the network.
+  typedef address_iterator_v6 iterator;
+
+  /// The type of an iterator over the addresses in the network.
+  typedef address_iterator_v6 const_iterator;
+
+  /// Default constructor. The network is ::/0.
+  STDNET_CONSTEXPR network_v6() STDNET_NOEXCEPT
+    : address_(),
+      prefix_length_(0)
+  {
+  }
+
+  /// Construct from an address and a prefix length.
+  /**
+   * @throws std::out_of_range if the prefix length is greater than 128.
+   */
+  STDNET_CONSTEXPR network_v6(const address_v6& addr, int prefix_len)
+    : address_(addr),
+      prefix_length_(prefix_len < 0 || prefix_len > 128
+          ? std::experimental::net::detail::throw_exception_as<unsigned char>(
+              std::out_of_range("network_v6 prefix length"))
+          : static_cast<unsigned char>(prefix_len))
+  {
+  }
+
+  /// Get the address from which the network was constructed.
+  STDNET_CONSTEXPR address_v6 address() const STDNET_NOEXCEPT
+  {
+    return address_;
+  }
+
+  /// Get the prefix length.
+  STDNET_CONSTEXPR int prefix_length() const STDNET_NOEXCEPT
+  {
+    return prefix_length_;
+  }
+
+  /// Get the network address, with all host bits clear and the same scope
+  /// ID as address().
+  STDNET_CONSTEXPR address_v6 network() const STDNET_NOEXCEPT
+  {
+    return address_v6::from_words(address_.word(0) & high_mask(),
+        address_.word(8) & low_mask(), address_.scope_id());
+  }
+
+  /// Get the network with the same prefix length whose address is the
+  /// network address.
+  STDNET_CONSTEXPR network_v6 canonical() const STDNET_NOEXCEPT
+  {
+    return network_v6(network(), prefix_length_, 0);
+  }
+
+  /// Determine whether the network is a single host, having a prefix length
+  /// of 128.
+  STDNET_CONSTEXPR bool is_host() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ == 128;
+  }
+
+  /// Determine whether an address is within the network.
+  /**
+   * Compares the leading prefix_length() bits of the address with those of
+   * the network, a 64-bit word at a time. Scope IDs are ignored.
+   */
+  STDNET_CONSTEXPR bool contains(const address_v6& addr) const STDNET_NOEXCEPT
+  {
+    return contains(addr.word(0), addr.word(8));
+  }
+
+  /// Determine whether an address is within the network.
+  STDNET_CONSTEXPR bool contains(
+      const compact_address_v6& addr) const STDNET_NOEXCEPT
+  {
+    return contains(addr.high(), addr.low());
+  }
+
+  /// Determine whether the network is within another, and is smaller.
+  STDNET_CONSTEXPR bool is_subnet_of(
+      const network_v6& other) const STDNET_NOEXCEPT
+  {
+    return other.prefix_length_ < prefix_length_ && other.contains(address_);
+  }
+
+  /// Get an iterator to the network address.
+  iterator begin() const STDNET_NOEXCEPT
+  {
+    return iterator(network());
+  }
+
+  /// Get an iterator one past the last address in the network.
+  iterator end() const STDNET_NOEXCEPT
+  {
+    return iterator(address_v6::from_words(address_.word(0) | ~high_mask(),
+          address_.word(8) | ~low_mask(), address_.scope_id())) + 1;
+  }
+
+  /// Compare two networks for equality.
+  friend STDNET_CONSTEXPR bool operator==(const network_v6& a,
+      const network_v6& b) STDNET_NOEXCEPT
+  {
+    return a.equals(b);
+  }
+
+  /// Compare two networks for inequality.
+  friend STDNET_CONSTEXPR bool operator!=(const network_v6& a,
+      const network_v6& b) STDNET_NOEXCEPT
+  {
+    return !(a == b);
+  }
+
+private:
+  // Construct without checking the prefix length.
+  STDNET_CONSTEXPR network_v6(const address_v6& addr,
+      unsigned char prefix_len, int) STDNET_NOEXCEPT
+    : address_(addr),
+      prefix_length_(prefix_len)
+  {
+  }
+
+  // The masks for the upper and lower words of an address.
+  STDNET_CONSTEXPR unsigned long long high_mask() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ == 0 ? 0
+      : prefix_length_ >= 64 ? ~0ULL : ~0ULL << (64 - prefix_length_);
+  }
+
+  STDNET_CONSTEXPR unsigned long long low_mask() const STDNET_NOEXCEPT
+  {
+    return prefix_length_ <= 64 ? 0 : ~0ULL << (128 - prefix_length_);
+  }
+
+  STDNET_CONSTEXPR bool contains(unsigned long long high,
+      unsigned long long low) const STDNET_NOEXCEPT
+  {
+    return ((high ^ address_.word(0)) & high_mask()) == 0
+      && ((low ^ address_.word(8)) & low_mask()) == 0;
+  }
+
+  STDNET_CONSTEXPR bool equals(const network_v6& other) const STDNET_NOEXCEPT
+  {
+    return address_.word(0) == other.address_.word(0)
+      && address_.word(8) == other.address_.word(8)
+      && address_.scope_id() == other.address_.scope_id()
+      && prefix_length_ == other.prefix_length_;
+  }
+
+  address_v6 address_;
+  unsigned char prefix_length_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#endif // STDNET_IP_NETWORK_V6_HPP
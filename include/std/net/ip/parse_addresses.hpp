@@ -0,0 +1,151 @@
+//
+// ip/parse_addresses.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_PARSE_ADDRESSES_HPP
+#define STDNET_IP_PARSE_ADDRESSES_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/ip/address.hpp"
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/fwd.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace detail {
+
+// The number of strings parsed together, one for each bit of a status word.
+const std::size_t parse_group_size = 64;
+
+// Parse a group of at most parse_group_size strings, given as pointers and
+// lengths. Returns the status word for the group, in which bit i is set if
+// string i is a valid address.
+STDNET_DECL std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address_v4* addrs) STDNET_NOEXCEPT;
+STDNET_DECL std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address_v6* addrs) STDNET_NOEXCEPT;
+STDNET_DECL std::uint64_t parse_address_group(const char* const* strs,
+    const std::size_t* lengths, std::size_t count,
+    ip::address* addrs) STDNET_NOEXCEPT;
+
+} // namespace detail
+
+namespace ip {
+
+/// Parse a sequence of strings into a sequence of addresses.
+/**
+ * Parses each of the @c count strings starting at @c strs, writing the
+ * resulting addresses to the array starting at @c addrs. @c String is any type
+ * with @c data() and @c size() members, such as @c std::string_view or
+ * @c std::string. @c Address is one of address_v4, address_v6 or address. The
+ * strings need not be NUL-terminated.
+ *
+ * The outcome for each string is recorded in the status bitmap starting at
+ * @c status, which must have room for <tt>(count + 63) / 64</tt> words. Bit
+ * <tt>i % 64</tt> of word <tt>i / 64</tt> is set if string @c i is a valid
+ * address. Every word is written, and bits beyond @c count are zero. An
+ * invalid string gives a default-constructed address.
+ *
+ * Strings are parsed in groups of 64, one for each status word. No memory is
+ * allocated and no exceptions are thrown.
+ *
+ * @returns @c count is the number of strings parsed, @c valid the number of
+ * them that are valid addresses, and @c ptr is null.
+ */
+template <class String, class Address>
+parse_addresses_result parse_addresses(const String* strs, std::size_t count,
+    Address* addrs, std::uint64_t* status) STDNET_NOEXCEPT
+{
+  const std::size_t group_size = std::experimental::net::detail::parse_group_size;
+  const char* group_strs[group_size];
+  std::size_t group_lengths[group_size];
+
+  parse_addresses_result result = { 0, 0, 0 };
+  while (result.count < count)
+  {
+    const std::size_t n = count - result.count < group_size
+      ? count - result.count : group_size;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      group_strs[i] = strs[result.count + i].data();
+      group_lengths[i] = strs[result.count + i].size();
+    }
+
+    const std::uint64_t bits =
+      std::experimental::net::detail::parse_address_group(
+          group_strs, group_lengths, n, addrs + result.count);
+    status[result.count / group_size] = bits;
+    result.valid += std::experimental::net::detail::bit_ops::popcount(bits);
+    result.count += n;
+  }
+
+  return result;
+}
+
+/// Parse a delimited buffer of strings into a sequence of addresses.
+/**
+ * Splits [first, last) into strings at each occurrence of @c delimiter, and
+ * parses at most @c max_count of them as for the overload that takes a
+ * sequence of strings. A delimiter at the very end of the buffer does not
+ * begin another string, but an empty string between two delimiters is parsed,
+ * and is invalid, so that strings keep their positions in the buffer. When the
+ * delimiter is a newline, a carriage return before it is ignored, as is one at
+ * the very end of the buffer.
+ *
+ * @returns @c count is the number of strings parsed, @c valid the number of
+ * them that are valid addresses, and @c ptr points to the first character not
+ * consumed. If fewer than @c max_count strings were parsed, @c ptr is equal to
+ * @c last. Otherwise, parsing may be resumed from @c ptr.
+ */
+STDNET_DECL parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address_v4* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT;
+
+/// Parse a delimited buffer of strings into a sequence of addresses.
+/**
+ * As for the address_v4 overload.
+ */
+STDNET_DECL parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address_v6* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT;
+
+/// Parse a delimited buffer of strings into a sequence of addresses.
+/**
+ * As for the address_v4 overload. Each string may be an IPv4 or an IPv6
+ * address.
+ */
+STDNET_DECL parse_addresses_result parse_addresses(const char* first,
+    const char* last, char delimiter, address* addrs,
+    std::size_t max_count, std::uint64_t* status) STDNET_NOEXCEPT;
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/parse_addresses.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_IP_PARSE_ADDRESSES_HPP
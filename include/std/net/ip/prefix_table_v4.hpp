@@ -0,0 +1,242 @@
+//
+// ip/prefix_table_v4.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_PREFIX_TABLE_V4_HPP
+#define STDNET_IP_PREFIX_TABLE_V4_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "std/net/detail/huge_page_allocator.hpp"
+#include "std/net/detail/prefetch.hpp"
+#include "std/net/ip/address_v4.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// A longest-prefix-match table keyed on IPv4 addresses.
+/**
+ * The ip::prefix_table_v4 class maps IPv4 prefixes, each given as an address
+ * and a prefix length, to integer values, and finds the value of the longest
+ * prefix that contains a given address.
+ *
+ * The table uses the DIR-24-8 scheme. A first-level array has one entry for
+ * each /24, so that a lookup matched by a prefix of length 24 or less takes a
+ * single memory access. Each /24 that contains a longer prefix instead refers
+ * to a group of 256 second-level entries, one per address, and a lookup then
+ * takes a second access. The first-level array occupies 64 MB, independent of
+ * the number of prefixes.
+ *
+ * Values must be no greater than @c max_value.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for concurrent lookups. Unsafe if any thread
+ * modifies the table.
+ */
+class prefix_table_v4
+{
+public:
+  /// The type of the values held in the table.
+  typedef std::uint32_t value_type;
+
+  /// The largest value that may be held in the table.
+  static const value_type max_value = 0xFFFFFF;
+
+  /// The value returned by a lookup that matches no prefix.
+  static const value_type no_value = 0xFFFFFFFF;
+
+  /// Construct an empty table.
+  STDNET_DECL prefix_table_v4();
+
+  /// Add a prefix to the table, or replace the value of an existing prefix.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 32 or
+   * @c value is greater than @c max_value.
+   */
+  STDNET_DECL void insert(const address_v4& addr, unsigned int prefix_length,
+      value_type value);
+
+  /// Remove a prefix from the table.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @returns @c true if the prefix was in the table.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 32.
+   */
+  STDNET_DECL bool erase(const address_v4& addr, unsigned int prefix_length);
+
+  /// Remove all prefixes from the table.
+  STDNET_DECL void clear();
+
+  /// Get the number of prefixes in the table.
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Find the value of the longest prefix that contains an address.
+  /**
+   * @returns The value, or @c no_value if no prefix contains the address.
+   */
+  value_type lookup(const address_v4& addr) const STDNET_NOEXCEPT
+  {
+    const std::uint32_t a = static_cast<std::uint32_t>(addr.to_ulong());
+    std::uint32_t e = tbl24_[a >> 8];
+    if (e & extended_flag)
+      e = tbl8_[((e & value_mask) << 8) | (a & 0xFF)];
+    return (e & valid_flag) ? (e & value_mask) : no_value;
+  }
+
+  /// Find the values of the longest prefixes that contain a sequence of
+  /// addresses.
+  /**
+   * Equivalent to calling lookup() for each address in turn, but the table
+   * entries for each address are prefetched well before they are read, so
+   * that the memory accesses for many addresses are in flight at once.
+   */
+  void lookup(const address_v4* addrs, std::size_t count,
+      value_type* values) const STDNET_NOEXCEPT
+  {
+    namespace detail = std::experimental::net::detail;
+
+    // The first-level entry for an address is prefetched two distances ahead
+    // of its result, and read one distance ahead, at which point the
+    // second-level entry is prefetched if it is needed. Pending entries are
+    // held in a ring, indexed by position modulo the distance.
+    const std::size_t distance = 32;
+    const std::uint32_t* tbl24 = tbl24_.data();
+    const std::uint32_t* tbl8 = tbl8_.data();
+    const std::uint32_t* pending[distance];
+
+    for (std::size_t i = 0; i < count && i < 2 * distance; ++i)
+      detail::prefetch(tbl24 + (addrs[i].to_ulong() >> 8));
+    for (std::size_t i = 0; i < count && i < distance; ++i)
+      pending[i] = next_entry(tbl24, tbl8, addrs[i]);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const std::uint32_t e = *pending[i % distance];
+      values[i] = (e & valid_flag) ? (e & value_mask) : no_value;
+      if (i + distance < count)
+        pending[i % distance] = next_entry(tbl24, tbl8, addrs[i + distance]);
+      if (i + 2 * distance < count)
+        detail::prefetch(tbl24 + (addrs[i + 2 * distance].to_ulong() >> 8));
+    }
+  }
+
+private:
+  // Each entry is a 32-bit word. An extended entry refers to a group of
+  // second-level entries, and its low 24 bits hold the group number. A valid
+  // entry holds a value in its low 24 bits and the length of the prefix that
+  // set it in the bits above. An entry that is neither is empty.
+  static const std::uint32_t extended_flag = 0x80000000;
+  static const std::uint32_t valid_flag = 0x40000000;
+  static const std::uint32_t value_mask = 0x00FFFFFF;
+  static const int length_shift = 24;
+
+  // Make a valid entry.
+  static std::uint32_t make_entry(value_type value, unsigned int length)
+  {
+    return valid_flag | (length << length_shift) | value;
+  }
+
+  // Get the prefix length of a valid entry.
+  static unsigned int entry_length(std::uint32_t e)
+  {
+    return (e >> length_shift) & 0x3F;
+  }
+
+  // Read the first-level entry for an address. If it refers to a group,
+  // prefetch the second-level entry and return it, otherwise return the
+  // first-level entry.
+  static const std::uint32_t* next_entry(const std::uint32_t* tbl24,
+      const std::uint32_t* tbl8, const address_v4& addr) STDNET_NOEXCEPT
+  {
+    const std::uint32_t a = static_cast<std::uint32_t>(addr.to_ulong());
+    const std::uint32_t* e = tbl24 + (a >> 8);
+    if (*e & extended_flag)
+    {
+      e = tbl8 + (((*e & value_mask) << 8) | (a & 0xFF));
+      std::experimental::net::detail::prefetch(e);
+    }
+    return e;
+  }
+
+  // Clear the bits of an address beyond the prefix length.
+  static std::uint32_t mask(std::uint32_t a, unsigned int length)
+  {
+    return length == 0 ? 0 : a & (0xFFFFFFFF << (32 - length));
+  }
+
+  // Write an entry over those covered by a prefix. When adding a prefix, the
+  // entries replaced are those that are empty or were set by a prefix no
+  // longer than it. When removing one, they are those that it set.
+  STDNET_DECL void update(std::uint32_t prefix, unsigned int length,
+      std::uint32_t entry, bool adding);
+
+  // Write an entry over a run of second-level entries in a group.
+  STDNET_DECL void update_group(std::uint32_t group, std::size_t first,
+      std::size_t count, unsigned int length, std::uint32_t entry, bool adding);
+
+  // Take a group of second-level entries from the free list or by growing the
+  // array, and fill it with a first-level entry.
+  STDNET_DECL std::uint32_t allocate_group(std::uint32_t entry);
+
+  // Release the group referred to by a first-level entry if all its entries
+  // are now the same and could be held in the first level.
+  STDNET_DECL void collapse_group(std::size_t index);
+
+  typedef std::vector<std::uint32_t,
+    std::experimental::net::detail::huge_page_allocator<std::uint32_t> >
+      entry_vector;
+
+  // The first-level entries, one for each /24.
+  entry_vector tbl24_;
+
+  // The second-level entries, in groups of 256.
+  entry_vector tbl8_;
+
+  // Numbers of released groups, to be reused before the array grows.
+  std::vector<std::uint32_t> free_groups_;
+
+  // The prefixes in the table, by length. These are used to find the prefix
+  // that takes over when a longer one is removed.
+  std::unordered_map<std::uint32_t, value_type> prefixes_[33];
+
+  // The number of prefixes in the table.
+  std::size_t size_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/prefix_table_v4.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_IP_PREFIX_TABLE_V4_HPP
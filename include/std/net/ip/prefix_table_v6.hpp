@@ -0,0 +1,297 @@
+//
+// ip/prefix_table_v6.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef STDNET_IP_PREFIX_TABLE_V6_HPP
+#define STDNET_IP_PREFIX_TABLE_V6_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "std/net/detail/config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "std/net/detail/bit_ops.hpp"
+#include "std/net/detail/huge_page_allocator.hpp"
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/compact_address_v6.hpp"
+
+#include "std/net/detail/push_options.hpp"
+
+namespace std {
+namespace experimental {
+namespace net {
+namespace ip {
+
+/// A longest-prefix-match table keyed on IPv6 addresses.
+/**
+ * The ip::prefix_table_v6 class maps IPv6 prefixes, each given as an address
+ * and a prefix length, to integer values, and finds the value of the longest
+ * prefix that contains a given address. Scope IDs are ignored.
+ *
+ * The table is a poptrie. The first 16 bits of an address index a direct
+ * array, whose entries hold either a value or the root of a multibit trie
+ * that consumes the remaining bits 6 at a time. Each trie node has a 64-bit
+ * bitmap of the children that are nodes and another marking where runs of
+ * equal values start among the children that are not. Children and values
+ * are stored contiguously, so a node holds only the two bitmaps and two base
+ * indexes, and a child is found by counting the set bits below its position.
+ * Runs of equal values are stored once. A lookup for a typical routing table
+ * takes the direct array entry, one to three nodes and a value.
+ *
+ * Changing a prefix rebuilds the deepest node whose children it covers,
+ * reusing the subtries of the children it does not cover, or the direct array
+ * entries it covers if it is no longer than 16 bits. The arrays are compacted
+ * when the space left by replaced nodes and values exceeds that in use.
+ *
+ * Values must be no greater than @c max_value.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe for concurrent lookups. Unsafe if any thread
+ * modifies the table.
+ */
+class prefix_table_v6
+{
+public:
+  /// The type of the values held in the table.
+  typedef std::uint32_t value_type;
+
+  /// The largest value that may be held in the table.
+  static const value_type max_value = 0xFFFFFF;
+
+  /// The value returned by a lookup that matches no prefix.
+  static const value_type no_value = 0xFFFFFFFF;
+
+  /// Construct an empty table.
+  STDNET_DECL prefix_table_v6();
+
+  /// Add a prefix to the table, or replace the value of an existing prefix.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 128 or
+   * @c value is greater than @c max_value.
+   */
+  STDNET_DECL void insert(const address_v6& addr, unsigned int prefix_length,
+      value_type value);
+
+  /// Remove a prefix from the table.
+  /**
+   * Bits of @c addr beyond the prefix length are ignored.
+   *
+   * @returns @c true if the prefix was in the table.
+   *
+   * @throws std::out_of_range if @c prefix_length is greater than 128.
+   */
+  STDNET_DECL bool erase(const address_v6& addr, unsigned int prefix_length);
+
+  /// Remove all prefixes from the table.
+  STDNET_DECL void clear();
+
+  /// Get the number of prefixes in the table.
+  std::size_t size() const STDNET_NOEXCEPT
+  {
+    return prefixes_.size();
+  }
+
+  /// Find the value of the longest prefix that contains an address.
+  /**
+   * @returns The value, or @c no_value if no prefix contains the address.
+   */
+  value_type lookup(const address_v6& addr) const STDNET_NOEXCEPT
+  {
+    const address_v6::bytes_type bytes = addr.to_bytes();
+    return lookup(load_word(bytes.data()), load_word(bytes.data() + 8));
+  }
+
+  /// Find the value of the longest prefix that contains an address.
+  /**
+   * @returns The value, or @c no_value if no prefix contains the address.
+   */
+  value_type lookup(const compact_address_v6& addr) const STDNET_NOEXCEPT
+  {
+    return lookup(addr.high(), addr.low());
+  }
+
+  /// Find the values of the longest prefixes that contain a sequence of
+  /// addresses.
+  /**
+   * Equivalent to calling lookup() for each address in turn, but the
+   * addresses are looked up in groups that descend their tries together, so
+   * that the memory accesses for the addresses in a group are in flight at
+   * once.
+   */
+  STDNET_DECL void lookup(const compact_address_v6* addrs, std::size_t count,
+      value_type* values) const STDNET_NOEXCEPT;
+
+private:
+  // The number of leading bits that index the direct array, and the number
+  // consumed by each trie node below it.
+  static const unsigned int direct_bits = 16;
+  static const unsigned int stride = 6;
+
+  // A direct array entry with this bit set holds a value, or no_value.
+  // Otherwise it holds the index of the root node of a trie.
+  static const std::uint32_t leaf_flag = 0x80000000;
+
+  struct node
+  {
+    // Bit i is set if child i is a node.
+    unsigned long long vector;
+
+    // Bit i is set if child i is a value and differs from the value of the
+    // previous child that is a value, or is the first such child.
+    unsigned long long leafvec;
+
+    // The index of the first value of the node in values_.
+    std::uint32_t base0;
+
+    // The index of the first child node of the node in nodes_.
+    std::uint32_t base1;
+  };
+
+  // A prefix, ordered by its bits and then its length, so that the prefixes
+  // below a direct array entry are contiguous.
+  struct prefix_key
+  {
+    unsigned long long high;
+    unsigned long long low;
+    unsigned int length;
+
+    friend bool operator<(const prefix_key& a, const prefix_key& b)
+    {
+      if (a.high != b.high)
+        return a.high < b.high;
+      if (a.low != b.low)
+        return a.low < b.low;
+      return a.length < b.length;
+    }
+  };
+
+  typedef std::map<prefix_key, value_type> prefix_map;
+
+  // Load eight bytes, in network byte order, as a 64-bit value.
+  static unsigned long long load_word(const unsigned char* p) STDNET_NOEXCEPT
+  {
+    return (static_cast<unsigned long long>(p[0]) << 56)
+      | (static_cast<unsigned long long>(p[1]) << 48)
+      | (static_cast<unsigned long long>(p[2]) << 40)
+      | (static_cast<unsigned long long>(p[3]) << 32)
+      | (static_cast<unsigned long long>(p[4]) << 24)
+      | (static_cast<unsigned long long>(p[5]) << 16)
+      | (static_cast<unsigned long long>(p[6]) << 8)
+      | static_cast<unsigned long long>(p[7]);
+  }
+
+  value_type lookup(unsigned long long high,
+      unsigned long long low) const STDNET_NOEXCEPT
+  {
+    namespace bit_ops = std::experimental::net::detail::bit_ops;
+
+    const std::uint32_t d = direct_[high >> 48];
+    if (d & leaf_flag)
+      return d == no_value ? no_value : (d & ~leaf_flag);
+
+    // The bits not yet consumed are kept left-aligned in two words.
+    unsigned long long bits = (high << 16) | (low >> 48);
+    low <<= 16;
+    const node* n = &nodes_[d];
+    unsigned int v = static_cast<unsigned int>(bits >> 58);
+    while (n->vector & (1ULL << v))
+    {
+      n = &nodes_[n->base1 + bit_ops::popcount(
+          n->vector & ((2ULL << v) - 1)) - 1];
+      bits = (bits << stride) | (low >> 58);
+      low <<= stride;
+      v = static_cast<unsigned int>(bits >> 58);
+    }
+    return values_[n->base0
+      + bit_ops::popcount(n->leafvec & ((2ULL << v) - 1)) - 1];
+  }
+
+  // Rebuild the part of the table below a prefix that has been added,
+  // removed or changed.
+  STDNET_DECL void update(const prefix_key& key);
+
+  // Rebuild the tries for a range of direct array entries.
+  STDNET_DECL void rebuild(std::size_t first, std::size_t last);
+
+  // Rebuild every trie into new arrays, discarding replaced tries.
+  STDNET_DECL void rebuild_all();
+
+  // Find the value of the longest prefix, no longer than the given length,
+  // that contains the given bits.
+  STDNET_DECL std::uint32_t covering_value(unsigned long long high,
+      unsigned long long low, unsigned int length) const;
+
+  // Find the prefixes that are longer than the given length and start with
+  // the given bits.
+  STDNET_DECL void find_prefixes(unsigned long long high,
+      unsigned long long low, unsigned int length,
+      prefix_map::const_iterator& first,
+      prefix_map::const_iterator& last) const;
+
+  // Build the trie for a direct array entry, given the value for addresses
+  // that match no longer prefix, and return the new direct array entry.
+  STDNET_DECL std::uint32_t build_direct(std::size_t index,
+      std::uint32_t value);
+
+  // Fill in a node from the prefixes in [first, last) that are longer than
+  // the given offset in bits, appending its children and values. If the node
+  // is being rebuilt, the children of the old node outside the range
+  // [first_changed, last_changed) are reused rather than built again.
+  STDNET_DECL void build_node(std::size_t index, unsigned int offset,
+      prefix_map::const_iterator first, prefix_map::const_iterator last,
+      std::uint32_t value, const node* old = 0,
+      unsigned int first_changed = 0, unsigned int last_changed = 0);
+
+  // Count the nodes and values in the trie below a node, including the node.
+  STDNET_DECL std::size_t count_trie(std::uint32_t index) const;
+
+  typedef std::vector<std::uint32_t,
+    std::experimental::net::detail::huge_page_allocator<std::uint32_t> >
+      direct_vector;
+  typedef std::vector<node,
+    std::experimental::net::detail::huge_page_allocator<node> > node_vector;
+  typedef std::vector<value_type,
+    std::experimental::net::detail::huge_page_allocator<value_type> >
+      value_vector;
+
+  // The direct array, with one entry for each 16-bit prefix.
+  direct_vector direct_;
+
+  // The trie nodes.
+  node_vector nodes_;
+
+  // The values of the trie nodes' children that are not nodes.
+  value_vector values_;
+
+  // The number of entries in nodes_ and values_ that belong to replaced tries.
+  std::size_t garbage_;
+
+  // The prefixes in the table.
+  prefix_map prefixes_;
+};
+
+} // namespace ip
+} // namespace net
+} // namespace experimental
+} // namespace std
+
+#include "std/net/detail/pop_options.hpp"
+
+#if defined(STDNET_HEADER_ONLY)
+# include "std/net/ip/impl/prefix_table_v6.ipp"
+#endif // defined(STDNET_HEADER_ONLY)
+
+#endif // STDNET_IP_PREFIX_TABLE_V6_HPP
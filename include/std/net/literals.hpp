@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "std/net/detail/literal_ops.hpp"
 #include "std/net/ip/address.hpp"
 #include "std/net/ip/address_v4.hpp"
 #include "std/net/ip/address_v6.hpp"
@@ -23,22 +24,68 @@
 
 namespace std {
 namespace experimental {
+namespace net {
+namespace detail {
+namespace literal_ops {
+
+// Each literal is parsed by a constexpr function. Text that is not a valid
+// address, or that names an interface in its zone ID, falls back to the
+// run-time parser, which is not constexpr. A constant expression that uses
+// such a literal is therefore ill-formed, while at run time the literal
+// throws or looks up the interface as it would otherwise.
+
+inline STDNET_CONSTEXPR ip::address_v4 make_v4(const v4_result& r,
+    const char* str, std::size_t len)
+{
+  return r.ok ? ip::make_address_v4(r.value)
+    : ip::make_address_v4(str, len);
+}
+
+inline STDNET_CONSTEXPR ip::address_v6 make_v6(const v6_result& r,
+    const char* str, std::size_t len)
+{
+  return r.ok ? ip::address_v6(ip::address_v6::bytes_type(
+        r.high >> 56, r.high >> 48, r.high >> 40, r.high >> 32,
+        r.high >> 24, r.high >> 16, r.high >> 8, r.high,
+        r.low >> 56, r.low >> 48, r.low >> 40, r.low >> 32,
+        r.low >> 24, r.low >> 16, r.low >> 8, r.low), r.scope_id)
+    : ip::make_address_v6(str, len);
+}
+
+} // namespace literal_ops
+} // namespace detail
+} // namespace net
+
 inline namespace literals {
 inline namespace net_literals {
 
-inline net::ip::address operator"" _ip(const char* str, std::size_t)
+// The operators are constexpr rather than immediate functions, even where
+// consteval is available, so that a zone ID naming an interface can still be
+// looked up at run time. A malformed literal is an error wherever a constant
+// is required, such as when initializing a constexpr object.
+
+inline STDNET_CONSTEXPR net::ip::address operator"" _ip(
+    const char* str, std::size_t len)
 {
-  return net::ip::make_address(str);
+  return net::detail::literal_ops::is_v6(str, len)
+    ? net::ip::address(net::detail::literal_ops::make_v6(
+          net::detail::literal_ops::parse_v6(str, len), str, len))
+    : net::ip::address(net::detail::literal_ops::make_v4(
+          net::detail::literal_ops::parse_v4(str, len), str, len));
 }
 
-inline net::ip::address_v4 operator"" _ipv4(const char* str, std::size_t)
+inline STDNET_CONSTEXPR net::ip::address_v4 operator"" _ipv4(
+    const char* str, std::size_t len)
 {
-  return net::ip::make_address_v4(str);
+  return net::detail::literal_ops::make_v4(
+      net::detail::literal_ops::parse_v4(str, len), str, len);
 }
 
-inline net::ip::address_v6 operator"" _ipv6(const char* str, std::size_t)
+inline STDNET_CONSTEXPR net::ip::address_v6 operator"" _ipv6(
+    const char* str, std::size_t len)
 {
-  return net::ip::make_address_v6(str);
+  return net::detail::literal_ops::make_v6(
+      net::detail::literal_ops::parse_v6(str, len), str, len);
 }
 
 } // inline namespace net_literals
@@ -13,6 +13,8 @@
 
 #include "../unit_test.hpp"
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 //------------------------------------------------------------------------------
 
@@ -96,6 +98,35 @@ void test()
     addr1 = ip::make_address("127.0.0.1", ec);
     addr1 = ip::make_address(string_value);
     addr1 = ip::make_address(string_value, ec);
+    addr1 = ip::make_address("127.0.0.1", 9);
+    addr1 = ip::make_address("127.0.0.1", 9, ec);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = ip::make_address(std::string_view(string_value));
+    addr1 = ip::make_address(std::string_view(string_value), ec);
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+    const char* first = string_value.data();
+    const char* last = first + string_value.size();
+    ip::from_chars_result result = ip::from_chars(first, last, addr1);
+    (void)result;
+
+    char buffer[80];
+    ip::to_chars_result to_result = ip::to_chars(buffer, buffer + 80, addr1);
+    (void)to_result;
+
+    ip::parse_result<ip::address> parse_result =
+      ip::parse_address("127.0.0.1");
+    parse_result = ip::parse_address(string_value);
+    parse_result = ip::parse_address("127.0.0.1", 9);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    parse_result = ip::parse_address(std::string_view(string_value));
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = parse_result.value_or(addr1);
+
+    // address hashing.
+
+    std::size_t hash_value = std::hash<ip::address>()(addr1);
+    (void)hash_value;
 
     // address I/O.
 
@@ -114,8 +145,314 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_address_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that addresses of each family keep their value,
+// type and scope ID through construction, copying and address_cast, and that
+// the predicates and comparisons only look at the active family.
+
+namespace ip_address_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_cast;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::bad_address_cast;
+
+  const address_v4 v4(address_v4::bytes_type(127, 0, 0, 1));
+  const address_v6 v6(address_v6::bytes_type(
+        0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1), 7);
+
+  address a1(v4);
+  STDNET_CHECK(a1.is_v4());
+  STDNET_CHECK(!a1.is_v6());
+  STDNET_CHECK(a1.is_loopback());
+  STDNET_CHECK(!a1.is_unspecified());
+  STDNET_CHECK(address_cast<address_v4>(a1) == v4);
+
+  address a2(v6);
+  STDNET_CHECK(a2.is_v6());
+  STDNET_CHECK(!a2.is_loopback());
+  STDNET_CHECK(address_cast<address_v6>(a2) == v6);
+  STDNET_CHECK(address_cast<address_v6>(a2).scope_id() == 7);
+
+  address a3(a2);
+  STDNET_CHECK(a3 == a2);
+  a3 = a1;
+  STDNET_CHECK(a3 == a1);
+  STDNET_CHECK(a3 != a2);
+  STDNET_CHECK(a3.is_v4());
+
+  // An IPv6 address whose leading bytes match an IPv4 address is still
+  // distinct from it.
+  address a4(address_v6(address_v6::bytes_type(127, 0, 0, 1)));
+  STDNET_CHECK(a4 != a1);
+  STDNET_CHECK(a1 < a4);
+
+  address_v6 v6_other_scope(v6);
+  v6_other_scope.scope_id(8);
+  STDNET_CHECK(address(v6_other_scope) != a2);
+  STDNET_CHECK(a2 < address(v6_other_scope));
+
+  address a5;
+  STDNET_CHECK(!a5.is_v4());
+  STDNET_CHECK(!a5.is_v6());
+  STDNET_CHECK(!a5.is_unspecified());
+  STDNET_CHECK(a5 == address());
+  STDNET_CHECK(a5 < a1);
+
+  bool caught = false;
+  try
+  {
+    address_cast<address_v6>(a1);
+  }
+  catch (bad_address_cast&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_address_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_address_parse test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that make_address and parse_address select the
+// correct address family and report the same errors as the family-specific
+// functions, and that to_chars writes either family.
+
+namespace ip_address_parse {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::make_address;
+  using std::experimental::net::ip::parse_address;
+  using std::experimental::net::ip::parse_result;
+  using std::experimental::net::ip::to_chars;
+  using std::experimental::net::ip::to_chars_result;
+
+  std::error_code ec;
+
+  address a1 = make_address("1.2.3.4", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a1.is_v4());
+
+  address a2 = make_address("::1", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a2.is_v6());
+  STDNET_CHECK(a2.is_loopback());
+
+  address a3 = make_address("1234::1.2.3.4", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a3.is_v6());
+
+  address a4 = make_address("fe80::1%3", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a4.is_v6());
+
+  const char field[] = "::1 1.2.3.4";
+  address a5 = make_address(field, 3, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a5.is_v6());
+
+  address a6 = make_address(field + 4, 7, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a6.is_v4());
+
+  address a7;
+  std::experimental::net::ip::from_chars_result r =
+    std::experimental::net::ip::from_chars(field, field + 11, a7);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == field + 3);
+  STDNET_CHECK(a7.is_v6());
+
+  r = std::experimental::net::ip::from_chars(r.ptr + 1, field + 11, a7);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == field + 11);
+  STDNET_CHECK(a7.is_v4());
+
+  const char* invalid[] =
+  {
+    "", "1", "1.2.3.4.5", "12345:1::", "1.2.3.4:80", "1:2", "::1.2.3",
+    "localhost"
+  };
+
+  for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+  {
+    address a = make_address(invalid[i], ec);
+    STDNET_CHECK(!!ec);
+    STDNET_CHECK(a == address());
+
+    parse_result<address> p = parse_address(invalid[i]);
+    STDNET_CHECK(!p.has_value());
+    STDNET_CHECK(p.error() == std::errc::invalid_argument);
+    STDNET_CHECK(p.value_or(a1) == a1);
+  }
+
+  parse_result<address> p1 = parse_address(field, 3);
+  STDNET_CHECK(p1.has_value());
+  STDNET_CHECK(p1->is_v6());
+  STDNET_CHECK(*p1 == a5);
+
+  parse_result<address> p2 = parse_address(std::string(field + 4, 7));
+  STDNET_CHECK(!!p2);
+  STDNET_CHECK(p2->is_v4());
+  STDNET_CHECK(*p2 == a6);
+
+  parse_result<address> p3 = parse_address("fe80::1%3");
+  STDNET_CHECK(!!p3);
+  STDNET_CHECK(*p3 == a4);
+
+  char buffer[64];
+  to_chars_result w = to_chars(buffer, buffer + sizeof(buffer), a4);
+  STDNET_CHECK(w.ec == std::errc());
+  STDNET_CHECK(std::string(buffer, w.ptr) == a4.to_string());
+
+  w = to_chars(buffer, buffer + sizeof(buffer), a6);
+  STDNET_CHECK(w.ec == std::errc());
+  STDNET_CHECK(std::string(buffer, w.ptr) == "1.2.3.4");
+
+  w = to_chars(buffer, buffer + 6, a6);
+  STDNET_CHECK(w.ec == std::errc::value_too_large);
+  STDNET_CHECK(w.ptr == buffer + 6);
+
+  w = to_chars(buffer, buffer + sizeof(buffer), address());
+  STDNET_CHECK(w.ec == std::errc::invalid_argument);
+  STDNET_CHECK(w.ptr == buffer);
+}
+
+} // namespace ip_address_parse
+
+//------------------------------------------------------------------------------
+
+// ip_address_io test
+// ~~~~~~~~~~~~~~~~~~
+// The following test checks that stream insertion writes the same text as
+// to_string, as a single field that honours the stream's width, fill and
+// adjustment, and that the stream state is respected.
+
+namespace ip_address_io {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_cast;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address;
+
+  address a1 = make_address("1.2.3.4");
+  address a2 = make_address("2001:db8::1");
+
+  std::ostringstream os;
+  os << a1 << ' ' << a2 << ' ' << address_cast<address_v4>(a1)
+    << ' ' << address_cast<address_v6>(a2);
+  STDNET_CHECK(os.str() == "1.2.3.4 2001:db8::1 1.2.3.4 2001:db8::1");
+
+  std::wostringstream wos;
+  wos << a1 << L' ' << a2;
+  STDNET_CHECK(wos.str() == L"1.2.3.4 2001:db8::1");
+
+  std::ostringstream padded;
+  padded.width(10);
+  padded << a1 << '|';
+  padded.width(14);
+  padded.fill('*');
+  padded.setf(std::ios_base::left, std::ios_base::adjustfield);
+  padded << a2 << '|';
+  padded.width(3);
+  padded << a2 << '|';
+  STDNET_CHECK(padded.str() == "   1.2.3.4|2001:db8::1***|2001:db8::1|");
+
+  std::ostringstream failed;
+  failed.setstate(std::ios_base::failbit);
+  failed << a1;
+  STDNET_CHECK(failed.str().empty());
+
+  bool caught = false;
+  try
+  {
+    std::ostringstream invalid;
+    invalid << address();
+  }
+  catch (std::experimental::net::ip::bad_address_cast&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_address_io
+
+//------------------------------------------------------------------------------
+
+// ip_address_hash test
+// ~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the hash of an address agrees with the hash
+// of the corresponding family-specific address, and that addresses can be used
+// as keys in unordered containers.
+
+namespace ip_address_hash {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_cast;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address;
+
+  const char* texts[] =
+  {
+    "0.0.0.0", "1.2.3.4", "1.2.3.5", "255.255.255.255", "::", "::1", "::2",
+    "2001:db8::1", "2001:db8::1:0", "fe80::1%1", "fe80::1%2", "::ffff:1.2.3.4"
+  };
+  const std::size_t count = sizeof(texts) / sizeof(texts[0]);
+
+  std::unordered_map<address, std::size_t> addresses;
+  std::unordered_set<address_v4> v4_addresses;
+  std::unordered_set<address_v6> v6_addresses;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    address a = make_address(texts[i]);
+    if (a.is_v4())
+    {
+      address_v4 v4 = address_cast<address_v4>(a);
+      STDNET_CHECK(std::hash<address>()(a) == std::hash<address_v4>()(v4));
+      v4_addresses.insert(v4);
+    }
+    else
+    {
+      address_v6 v6 = address_cast<address_v6>(a);
+      STDNET_CHECK(std::hash<address>()(a) == std::hash<address_v6>()(v6));
+      v6_addresses.insert(v6);
+    }
+    addresses[a] = i;
+  }
+
+  STDNET_CHECK(addresses.size() == count);
+  STDNET_CHECK(v4_addresses.size() + v6_addresses.size() == count);
+  for (std::size_t i = 0; i < count; ++i)
+    STDNET_CHECK(addresses[make_address(texts[i])] == i);
+
+  STDNET_CHECK(make_address("::1") != make_address("::2"));
+}
+
+} // namespace ip_address_hash
+
+//------------------------------------------------------------------------------
+
 STDNET_TEST_SUITE
 (
   "ip/address",
   STDNET_TEST_CASE(ip_address_compile::test)
+  STDNET_TEST_CASE(ip_address_runtime::test)
+  STDNET_TEST_CASE(ip_address_parse::test)
+  STDNET_TEST_CASE(ip_address_io::test)
+  STDNET_TEST_CASE(ip_address_hash::test)
 )
@@ -0,0 +1,216 @@
+//
+// address_cache.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/address_cache.hpp"
+
+#include "../unit_test.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+//------------------------------------------------------------------------------
+
+// ip_address_cache_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::address_cache compile and link correctly. Runtime failures are ignored.
+
+namespace ip_address_cache_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    std::error_code ec;
+    std::string string_value("127.0.0.1");
+
+    // address_cache constructors.
+
+    ip::address_cache cache1;
+    ip::address_cache cache2(16);
+
+    // address_cache functions.
+
+    ip::parse_result<ip::address> result = cache1.parse("127.0.0.1", 9);
+    result = cache1.parse(string_value);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    result = cache1.parse(std::string_view(string_value));
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+    (void)result;
+
+    ip::address addr = cache1.make_address("127.0.0.1");
+    addr = cache1.make_address("127.0.0.1", ec);
+    addr = cache1.make_address(string_value);
+    addr = cache1.make_address(string_value, ec);
+    addr = cache1.make_address("127.0.0.1", 9);
+    addr = cache1.make_address("127.0.0.1", 9, ec);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    addr = cache1.make_address(std::string_view(string_value));
+    addr = cache1.make_address(std::string_view(string_value), ec);
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+    std::size_t capacity = cache2.capacity();
+    (void)capacity;
+
+    std::uint64_t count = cache1.hits() + cache1.misses();
+    (void)count;
+
+    cache1.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_address_cache_compile
+
+//------------------------------------------------------------------------------
+
+// ip_address_cache_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the cache gives the same results as
+// make_address, that repeated strings are hits, and that the cache is bounded.
+
+namespace ip_address_cache_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_cache;
+  using std::experimental::net::ip::make_address;
+  using std::experimental::net::ip::parse_result;
+
+  std::error_code ec;
+
+  address_cache cache1(5);
+  STDNET_CHECK(cache1.capacity() == 8);
+  STDNET_CHECK(address_cache(0).capacity() == 2);
+  STDNET_CHECK(address_cache().capacity() == address_cache::default_capacity);
+
+  const char* strs[] =
+  {
+    "1.2.3.4", "::1", "fe80::1%3", "::ffff:1.2.3.4", "255.255.255.255",
+    "2001:db8:85a3::8a2e:370:7334", "1.2.3", "", "localhost",
+    "1234:5678:9abc:def0:1234:5678:9abc:def0"
+  };
+  const std::size_t count = sizeof(strs) / sizeof(strs[0]);
+
+  for (int round = 0; round < 2; ++round)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      std::error_code expected_ec;
+      address expected = make_address(strs[i], expected_ec);
+      address a = cache1.make_address(strs[i], ec);
+      STDNET_CHECK(a == expected);
+      STDNET_CHECK(ec == expected_ec);
+    }
+  }
+  STDNET_CHECK(cache1.hits() + cache1.misses() == 2 * count);
+
+  // Invalid strings and strings longer than max_key_length are never cached.
+  STDNET_CHECK(std::strlen(strs[count - 1]) > address_cache::max_key_length);
+  STDNET_CHECK(cache1.misses() >= count + 4);
+
+  address_cache cache2(64);
+  parse_result<address> r = cache2.parse("10.0.0.1", 8);
+  STDNET_CHECK(r.has_value());
+  STDNET_CHECK(cache2.misses() == 1 && cache2.hits() == 0);
+
+  const char field[] = "10.0.0.1,10.0.0.12";
+  r = cache2.parse(field, 8);
+  STDNET_CHECK(r.has_value());
+  STDNET_CHECK(*r == make_address("10.0.0.1"));
+  STDNET_CHECK(cache2.misses() == 1 && cache2.hits() == 1);
+
+  r = cache2.parse(field + 9, 9);
+  STDNET_CHECK(*r == make_address("10.0.0.12"));
+  STDNET_CHECK(cache2.misses() == 2 && cache2.hits() == 1);
+
+  r = cache2.parse(std::string("10.0.0.1"));
+  STDNET_CHECK(cache2.misses() == 2 && cache2.hits() == 2);
+
+  r = cache2.parse("10.0.0.1x", 9);
+  STDNET_CHECK(!r.has_value());
+  STDNET_CHECK(r.error() == std::errc::invalid_argument);
+  r = cache2.parse("10.0.0.1x", 9);
+  STDNET_CHECK(!r.has_value());
+  STDNET_CHECK(cache2.misses() == 4 && cache2.hits() == 2);
+
+  // A string that differs only in its zone is a different key.
+  r = cache2.parse("fe80::1%3", 9);
+  r = cache2.parse("fe80::1%4", 9);
+  STDNET_CHECK(r.has_value());
+  STDNET_CHECK(r->is_v6());
+  STDNET_CHECK(*r == make_address("fe80::1%4"));
+  STDNET_CHECK(cache2.misses() == 6);
+
+  cache2.clear();
+  STDNET_CHECK(cache2.hits() == 0 && cache2.misses() == 0);
+  cache2.parse("10.0.0.1", 8);
+  STDNET_CHECK(cache2.misses() == 1);
+
+  // Many more distinct strings than the capacity give correct results, with
+  // at most capacity() of them left to hit on a second pass.
+  address_cache cache3(16);
+  for (int round = 0; round < 2; ++round)
+  {
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+      char buffer[16];
+      std::sprintf(buffer, "10.%u.%u.%u", i >> 8, i & 0xFF, i % 7);
+      address a = cache3.make_address(buffer, ec);
+      STDNET_CHECK(!ec);
+      STDNET_CHECK(a == make_address(buffer));
+    }
+  }
+  STDNET_CHECK(cache3.hits() <= cache3.capacity());
+  STDNET_CHECK(cache3.hits() + cache3.misses() == 2000);
+
+  // A hot string stays cached while others pass through its set.
+  address_cache cache4(2);
+  for (unsigned i = 0; i < 100; ++i)
+  {
+    char buffer[16];
+    std::sprintf(buffer, "192.0.2.%u", i);
+    cache4.parse("198.51.100.1", 12);
+    cache4.parse(buffer, std::strlen(buffer));
+  }
+  STDNET_CHECK(cache4.hits() == 99);
+
+  bool caught = false;
+  try
+  {
+    cache4.make_address("not an address");
+  }
+  catch (std::system_error&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_address_cache_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/address_cache",
+  STDNET_TEST_CASE(ip_address_cache_compile::test)
+  STDNET_TEST_CASE(ip_address_cache_runtime::test)
+)
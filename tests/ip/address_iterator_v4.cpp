@@ -0,0 +1,120 @@
+//
+// address_iterator_v4.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/address_iterator_v4.hpp"
+
+#include "../unit_test.hpp"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+// ip_address_iterator_v4_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::address_iterator_v4 compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_address_iterator_v4_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  static_assert(std::is_same<
+      std::iterator_traits<ip::address_iterator_v4>::iterator_category,
+      std::random_access_iterator_tag>::value, "random access");
+
+  ip::address_iterator_v4 iter1(ip::address_v4::loopback());
+  ip::address_iterator_v4 iter2(iter1);
+
+  const ip::address_v4& addr = *iter1;
+  (void)addr;
+  unsigned long value = iter1->to_ulong();
+  value = iter1[1].to_ulong();
+  (void)value;
+
+  ++iter1;
+  iter1++;
+  --iter1;
+  iter1--;
+  iter1 += 2;
+  iter1 -= 2;
+  iter2 = iter1 + 1;
+  iter2 = 1 + iter1;
+  iter2 = iter1 - 1;
+
+  ip::address_iterator_v4::difference_type n = iter2 - iter1;
+  (void)n;
+
+  bool b = (iter1 == iter2);
+  b = (iter1 != iter2);
+  b = (iter1 < iter2);
+  b = (iter1 > iter2);
+  b = (iter1 <= iter2);
+  b = (iter1 >= iter2);
+  (void)b;
+}
+
+} // namespace ip_address_iterator_v4_compile
+
+//------------------------------------------------------------------------------
+
+// ip_address_iterator_v4_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks iterator arithmetic, including at the ends of the
+// address space.
+
+namespace ip_address_iterator_v4_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_iterator_v4;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::make_address_v4;
+
+  address_iterator_v4 iter1(make_address_v4(0xC0A800FF));
+  ++iter1;
+  STDNET_CHECK(*iter1 == make_address_v4(0xC0A80100));
+  iter1 += 0x100;
+  STDNET_CHECK(*iter1 == make_address_v4(0xC0A80200));
+  iter1 -= 0x201;
+  STDNET_CHECK(*iter1 == make_address_v4(0xC0A7FFFF));
+  STDNET_CHECK(iter1[2] == make_address_v4(0xC0A80001));
+  STDNET_CHECK(iter1[-0xFFFF] == make_address_v4(0xC0A70000));
+
+  // The whole space is 2^32 steps long, ending one past the last address.
+  const address_iterator_v4 first(address_v4::any());
+  const address_iterator_v4 last = address_iterator_v4(address_v4::broadcast()) + 1;
+  STDNET_CHECK(last != first);
+  STDNET_CHECK(first < last);
+  STDNET_CHECK(last - first == 0x100000000LL);
+  STDNET_CHECK(*(last - 1) == address_v4::broadcast());
+  STDNET_CHECK(*(first + (last - first) / 2) == make_address_v4(0x80000000));
+
+  // Binary search works directly on the addresses.
+  address_iterator_v4 begin(make_address_v4(0x0A000000));
+  address_iterator_v4 end = begin + 0x1000000;
+  STDNET_CHECK(std::lower_bound(begin, end, make_address_v4(0x0A123456))
+      - begin == 0x123456);
+}
+
+} // namespace ip_address_iterator_v4_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/address_iterator_v4",
+  STDNET_TEST_CASE(ip_address_iterator_v4_compile::test)
+  STDNET_TEST_CASE(ip_address_iterator_v4_runtime::test)
+)
@@ -0,0 +1,146 @@
+//
+// address_iterator_v6.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/address_iterator_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+//------------------------------------------------------------------------------
+
+// ip_address_iterator_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::address_iterator_v6 compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_address_iterator_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  static_assert(std::is_same<
+      std::iterator_traits<ip::address_iterator_v6>::iterator_category,
+      std::random_access_iterator_tag>::value, "random access");
+
+  ip::address_iterator_v6 iter1(ip::address_v6::loopback());
+  ip::address_iterator_v6 iter2(iter1);
+
+  const ip::address_v6& addr = *iter1;
+  (void)addr;
+  unsigned long scope_id = iter1->scope_id();
+  scope_id = iter1[1].scope_id();
+  (void)scope_id;
+
+  ++iter1;
+  iter1++;
+  --iter1;
+  iter1--;
+  iter1 += 2;
+  iter1 -= 2;
+  iter2 = iter1 + 1;
+  iter2 = 1 + iter1;
+  iter2 = iter1 - 1;
+
+  ip::address_iterator_v6::difference_type n = iter2 - iter1;
+  (void)n;
+
+  bool b = (iter1 == iter2);
+  b = (iter1 != iter2);
+  b = (iter1 < iter2);
+  b = (iter1 > iter2);
+  b = (iter1 <= iter2);
+  b = (iter1 >= iter2);
+  (void)b;
+}
+
+} // namespace ip_address_iterator_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_address_iterator_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that steps carry and borrow between the 64-bit
+// halves of the address, and past the last address.
+
+namespace ip_address_iterator_v6_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_iterator_v6;
+  using std::experimental::net::ip::address_v6;
+
+  const address_v6 a1(address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8,
+        0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe), 7);
+  const address_v6 a2(address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8,
+        0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1), 7);
+
+  address_iterator_v6 iter1(a1);
+  iter1 += 3;
+  STDNET_CHECK(*iter1 == a2);
+  STDNET_CHECK(iter1->scope_id() == 7);
+  STDNET_CHECK(iter1 - address_iterator_v6(a1) == 3);
+  STDNET_CHECK(address_iterator_v6(a1) - iter1 == -3);
+  STDNET_CHECK(address_iterator_v6(a1) < iter1);
+  iter1 -= 3;
+  STDNET_CHECK(*iter1 == a1);
+  STDNET_CHECK(address_iterator_v6(a2)[-3] == a1);
+
+  // Iterators may point one past the last address.
+  const address_v6 last(address_v6::bytes_type(0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  address_iterator_v6 iter2(last);
+  ++iter2;
+  STDNET_CHECK(iter2 != address_iterator_v6(address_v6::any()));
+  STDNET_CHECK(address_iterator_v6(last) < iter2);
+  STDNET_CHECK(iter2 - address_iterator_v6(last) == 1);
+  --iter2;
+  STDNET_CHECK(*iter2 == last);
+  STDNET_CHECK(iter2 == address_iterator_v6(last));
+
+  // Distances that cannot be represented saturate, keeping their sign.
+  typedef address_iterator_v6::difference_type difference_type;
+  const difference_type max = std::numeric_limits<difference_type>::max();
+  const difference_type min = std::numeric_limits<difference_type>::min();
+  address_iterator_v6 iter3(a1);
+  iter3 += max;
+  STDNET_CHECK(iter3 - address_iterator_v6(a1) == max);
+  STDNET_CHECK(address_iterator_v6(a1) - iter3 == -max);
+  ++iter3;
+  STDNET_CHECK(iter3 - address_iterator_v6(a1) == max);
+  STDNET_CHECK(address_iterator_v6(a1) - iter3 == min);
+  ++iter3;
+  STDNET_CHECK(address_iterator_v6(a1) - iter3 == min);
+  address_iterator_v6 iter4(address_v6::any());
+  iter4 += max;
+  iter4 += max;
+  iter4 += 2;
+  STDNET_CHECK(*iter4 == address_v6(address_v6::bytes_type(
+          0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0)));
+  STDNET_CHECK(iter4 - address_iterator_v6(address_v6::any()) == max);
+  STDNET_CHECK(address_iterator_v6(address_v6::any()) - iter4 == min);
+  STDNET_CHECK(iter2 + 1 - address_iterator_v6(address_v6::any()) == max);
+  STDNET_CHECK(address_iterator_v6(address_v6::any()) - (iter2 + 1) == min);
+}
+
+} // namespace ip_address_iterator_v6_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/address_iterator_v6",
+  STDNET_TEST_CASE(ip_address_iterator_v6_compile::test)
+  STDNET_TEST_CASE(ip_address_iterator_v6_runtime::test)
+)
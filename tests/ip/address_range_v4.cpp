@@ -0,0 +1,156 @@
+//
+// address_range_v4.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/address_range_v4.hpp"
+
+#include "../unit_test.hpp"
+#include <iterator>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+// ip_address_range_v4_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::address_range_v4 compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_address_range_v4_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    // address_range_v4 constructors.
+
+    ip::address_range_v4 range1;
+    ip::address_range_v4 range2(ip::address_v4::loopback());
+    ip::address_range_v4 range3(ip::address_v4::loopback(),
+        ip::make_address_v4(0xFF000000));
+    ip::address_range_v4 range4(ip::network_v4(ip::address_v4::loopback(), 8));
+
+    // address_range_v4 functions.
+
+    ip::address_v4 addr = range2.network();
+    addr = range2.netmask();
+    addr = range2.broadcast();
+    (void)addr;
+
+    ip::address_range_v4::iterator iter = range3.begin();
+    iter = range3.end();
+    iter = range3.find(ip::address_v4::loopback());
+    (void)iter;
+
+    bool b = range4.empty();
+    (void)b;
+
+    std::size_t size = range4.size();
+    (void)size;
+
+    range1 = range2;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_address_range_v4_compile
+
+//------------------------------------------------------------------------------
+
+// ip_address_range_v4_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the addresses in ranges, and that a range divides
+// into chunks by iterator arithmetic alone.
+
+namespace ip_address_range_v4_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_range_v4;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::make_address_v4;
+  using std::experimental::net::ip::network_v4;
+
+  address_range_v4 range1;
+  STDNET_CHECK(range1.empty());
+  STDNET_CHECK(range1.size() == 0);
+  STDNET_CHECK(range1.begin() == range1.end());
+  STDNET_CHECK(range1.find(address_v4::any()) == range1.end());
+
+  address_range_v4 range2(make_address_v4(0xC0A80105));
+  STDNET_CHECK(range2.size() == 1);
+  STDNET_CHECK(range2.network() == make_address_v4(0xC0A80105));
+  STDNET_CHECK(range2.broadcast() == make_address_v4(0xC0A80105));
+  STDNET_CHECK(range2.netmask() == address_v4::broadcast());
+
+  address_range_v4 range3(make_address_v4(0xC0A80105),
+      make_address_v4(0xFFFFFF00));
+  STDNET_CHECK(range3.size() == 256);
+  STDNET_CHECK(range3.network() == make_address_v4(0xC0A80100));
+  STDNET_CHECK(range3.netmask() == make_address_v4(0xFFFFFF00));
+  STDNET_CHECK(range3.broadcast() == make_address_v4(0xC0A801FF));
+  STDNET_CHECK(std::distance(range3.begin(), range3.end()) == 256);
+  STDNET_CHECK(range3.find(make_address_v4(0xC0A801FA))
+      == range3.begin() + 0xFA);
+  STDNET_CHECK(range3.end() - range3.find(make_address_v4(0xC0A801FA)) == 6);
+  STDNET_CHECK(range3.find(make_address_v4(0xC0A80200)) == range3.end());
+  STDNET_CHECK(range3.find(make_address_v4(0xC0A800FF)) == range3.end());
+
+  // The whole address space.
+  address_range_v4 range4(network_v4(address_v4::any(), 0));
+  STDNET_CHECK(range4.size() == 0x100000000ULL);
+  STDNET_CHECK(range4.network() == address_v4::any());
+  STDNET_CHECK(range4.netmask() == address_v4::any());
+  STDNET_CHECK(range4.broadcast() == address_v4::broadcast());
+  STDNET_CHECK(range4.find(address_v4::broadcast()) == range4.end() - 1);
+
+  // A /8 divides into equal chunks, which together cover it exactly.
+  address_range_v4 range5(network_v4(make_address_v4(0x0A000000), 8));
+  const std::size_t threads = 7;
+  const std::size_t chunk = range5.size() / threads;
+  address_range_v4::iterator next = range5.begin();
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    address_range_v4::iterator first = range5.begin() + t * chunk;
+    address_range_v4::iterator last =
+      t + 1 == threads ? range5.end() : first + chunk;
+    STDNET_CHECK(first == next);
+    STDNET_CHECK(static_cast<std::size_t>(last - first) >= chunk);
+    next = last;
+  }
+  STDNET_CHECK(next == range5.end());
+
+  bool caught = false;
+  try
+  {
+    address_range_v4 range(address_v4::loopback(), make_address_v4(0xFF00FF00));
+    (void)range;
+  }
+  catch (std::invalid_argument&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_address_range_v4_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/address_range_v4",
+  STDNET_TEST_CASE(ip_address_range_v4_compile::test)
+  STDNET_TEST_CASE(ip_address_range_v4_runtime::test)
+)
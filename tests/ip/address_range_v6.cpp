@@ -0,0 +1,214 @@
+//
+// address_range_v6.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/address_range_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+//------------------------------------------------------------------------------
+
+// ip_address_range_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::address_range_v6 compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_address_range_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    // address_range_v6 constructors.
+
+    ip::address_range_v6 range1;
+    ip::address_range_v6 range2(ip::address_v6::loopback());
+    ip::address_range_v6 range3(ip::address_v6::loopback(), 64);
+    ip::address_range_v6 range4(ip::network_v6(ip::address_v6::loopback(), 64));
+
+    // address_range_v6 functions.
+
+    ip::address_v6 addr = range2.network();
+    (void)addr;
+
+    int prefix_length = range2.prefix_length();
+    (void)prefix_length;
+
+    ip::address_range_v6::iterator iter = range3.begin();
+    iter = range3.end();
+    iter = range3.find(ip::address_v6::loopback());
+    (void)iter;
+
+    bool b = range4.empty();
+    (void)b;
+
+    std::pair<ip::address_range_v6::iterator,
+      ip::address_range_v6::iterator> part = range4.split(4, 1);
+    (void)part;
+
+    range1 = range2;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_address_range_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_address_range_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the addresses in ranges, including ranges too
+// large for their size to be represented.
+
+namespace ip_address_range_v6_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_range_v6;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::network_v6;
+
+  address_range_v6 range1;
+  STDNET_CHECK(range1.empty());
+  STDNET_CHECK(range1.find(address_v6::any()) == range1.end());
+
+  const address_v6 addr(address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x12, 0x34));
+
+  address_range_v6 range2(addr);
+  STDNET_CHECK(!range2.empty());
+  STDNET_CHECK(range2.network() == addr);
+  STDNET_CHECK(range2.prefix_length() == 128);
+  STDNET_CHECK(range2.end() - range2.begin() == 1);
+
+  address_range_v6 range3(addr, 112);
+  STDNET_CHECK(range3.network() == address_v6(address_v6::bytes_type(
+          0x20, 0x01, 0x0d, 0xb8)));
+  STDNET_CHECK(range3.prefix_length() == 112);
+  STDNET_CHECK(range3.end() - range3.begin() == 0x10000);
+  STDNET_CHECK(range3.find(addr) - range3.begin() == 0x1234);
+  STDNET_CHECK(range3.find(address_v6::loopback()) == range3.end());
+  STDNET_CHECK(range3.find(address_v6(addr.to_bytes(), 1)) == range3.end());
+
+  // A /48 is split into parts that tile it exactly.
+  address_range_v6 range4(network_v6(addr, 48));
+  const std::size_t part_counts[] = { 1, 2, 3, 7, 64, 1000, 65536 };
+  for (std::size_t n = 0; n < sizeof(part_counts) / sizeof(part_counts[0]); ++n)
+  {
+    const std::size_t parts = part_counts[n];
+    address_range_v6::iterator next = range4.begin();
+    for (std::size_t i = 0; i < parts; ++i)
+    {
+      std::pair<address_range_v6::iterator,
+        address_range_v6::iterator> part = range4.split(parts, i);
+      STDNET_CHECK(part.first == next);
+      STDNET_CHECK(part.first < part.second);
+      STDNET_CHECK(part.first->scope_id() == addr.scope_id());
+      next = part.second;
+    }
+    STDNET_CHECK(next == range4.end());
+  }
+
+  // Parts of 2^64 addresses are each a /64.
+  for (std::size_t i = 0; i < 0x10000; i += 0x1111)
+  {
+    std::pair<address_range_v6::iterator,
+      address_range_v6::iterator> part = range4.split(0x10000, i);
+    network_v6 net(*part.first, 64);
+    STDNET_CHECK(net.network() == *part.first);
+    STDNET_CHECK(part.first == net.begin() && part.second == net.end());
+    STDNET_CHECK(part.first->to_bytes()[6] == (i >> 8));
+    STDNET_CHECK(part.first->to_bytes()[7] == (i & 0xff));
+  }
+  STDNET_CHECK(range4.split(0x100000, 5).second
+      - range4.split(0x100000, 5).first == 0x1000000000000000LL);
+  STDNET_CHECK(range4.find(addr) == range4.begin() + 0x1234);
+  STDNET_CHECK(range4.find(range4.end()[-1]) == range4.end() - 1);
+
+  // The whole address space.
+  address_range_v6 range5(network_v6(address_v6::any(), 0));
+  STDNET_CHECK(!range5.empty());
+  STDNET_CHECK(range5.find(range5.end()[-1]) != range5.end());
+  STDNET_CHECK(range5.split(3, 0).first == range5.begin());
+  STDNET_CHECK(range5.split(3, 1).first == range5.split(3, 0).second);
+  STDNET_CHECK(range5.split(3, 2).first == range5.split(3, 1).second);
+  STDNET_CHECK(range5.split(3, 2).second == range5.end());
+  STDNET_CHECK(range5.split(3, 1).first->to_bytes()[0] == 0x55);
+  STDNET_CHECK(range5.split(3, 1).first->to_bytes()[15] == 0x55);
+
+  // Part sizes differ by at most one address.
+  address_range_v6 range6(network_v6(addr, 64));
+  STDNET_CHECK(range6.split(3, 0).second - range6.split(3, 0).first
+      == 0x5555555555555555LL);
+  STDNET_CHECK(range6.split(3, 1).second - range6.split(3, 1).first
+      == 0x5555555555555555LL);
+  STDNET_CHECK(range6.split(3, 2).second - range6.split(3, 2).first
+      == 0x5555555555555556LL);
+  STDNET_CHECK(range3.split(7, 0).second - range3.split(7, 0).first == 9362);
+  STDNET_CHECK(range3.split(7, 6).second - range3.split(7, 6).first == 9363);
+  STDNET_CHECK(range3.split(100000, 0).first == range3.split(100000, 0).second);
+  STDNET_CHECK(address_range_v6(addr).split(2, 1).second
+      == address_range_v6(addr).end());
+  STDNET_CHECK(address_range_v6().split(2, 1).first
+      == address_range_v6().end());
+
+  bool caught = false;
+  try
+  {
+    address_range_v6 range(addr, 129);
+    (void)range;
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    range4.split(0, 0);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    range4.split(4, 4);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_address_range_v6_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/address_range_v6",
+  STDNET_TEST_CASE(ip_address_range_v6_compile::test)
+  STDNET_TEST_CASE(ip_address_range_v6_runtime::test)
+)
@@ -12,6 +12,8 @@
 #include "std/net/ip/address_v4.hpp"
 
 #include "../unit_test.hpp"
+#include <cstdio>
+#include <cstring>
 #include <sstream>
 #include "std/net/ip/address_v6.hpp"
 
@@ -113,6 +115,35 @@ void test()
     addr1 = ip::make_address_v4("127.0.0.1", ec);
     addr1 = ip::make_address_v4(string_value);
     addr1 = ip::make_address_v4(string_value, ec);
+    addr1 = ip::make_address_v4("127.0.0.1", 9);
+    addr1 = ip::make_address_v4("127.0.0.1", 9, ec);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = ip::make_address_v4(std::string_view(string_value));
+    addr1 = ip::make_address_v4(std::string_view(string_value), ec);
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+    const char* first = string_value.data();
+    const char* last = first + string_value.size();
+    ip::from_chars_result result = ip::from_chars(first, last, addr1);
+    (void)result;
+
+    char buffer[16];
+    ip::to_chars_result to_result = ip::to_chars(buffer, buffer + 16, addr1);
+    (void)to_result;
+
+    ip::parse_result<ip::address_v4> parse_result =
+      ip::parse_address_v4("127.0.0.1");
+    parse_result = ip::parse_address_v4(string_value);
+    parse_result = ip::parse_address_v4("127.0.0.1", 9);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    parse_result = ip::parse_address_v4(std::string_view(string_value));
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = parse_result.value_or(addr1);
+
+    // address_v4 hashing.
+
+    std::size_t hash_value = std::hash<ip::address_v4>()(addr1);
+    (void)hash_value;
 
     // address_v4 I/O.
 
@@ -246,9 +277,223 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_address_v4_compare test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that equality and ordering follow the bytes of
+// the address in network byte order.
+
+namespace ip_address_v4_compare {
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+
+  // Each pair of addresses differs in one byte, in each position, so that the
+  // ordering must agree with the byte order of the address.
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    address_v4::bytes_type low_bytes(0x80, 0x81, 0x82, 0x83);
+    address_v4::bytes_type high_bytes(low_bytes);
+    low_bytes[i] = 0x7f;
+    high_bytes[i] = 0xfe;
+
+    address_v4 low(low_bytes), high(high_bytes);
+    STDNET_CHECK(low < high);
+    STDNET_CHECK(!(high < low));
+    STDNET_CHECK(low != high);
+    STDNET_CHECK(!(low == high));
+    STDNET_CHECK(high > low);
+    STDNET_CHECK(low <= high);
+    STDNET_CHECK(high >= low);
+    STDNET_CHECK(low.to_bytes() == low_bytes);
+    STDNET_CHECK(high.to_bytes() == high_bytes);
+  }
+
+  address_v4 a1(0x0A000001), a2(address_v4::bytes_type(10, 0, 0, 1));
+  STDNET_CHECK(a1 == a2);
+  STDNET_CHECK(!(a1 != a2));
+  STDNET_CHECK(!(a1 < a2));
+  STDNET_CHECK(a1 <= a2 && a1 >= a2);
+
+  address_v4 mask(0xFFFFFF00);
+  STDNET_CHECK(address_v4::broadcast(a1, mask).to_ulong() == 0x0A0000FF);
+}
+
+} // namespace ip_address_v4_compare
+
+//------------------------------------------------------------------------------
+
+// ip_address_v4_parse test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that make_address_v4 accepts exactly the strings
+// accepted by inet_pton(AF_INET), and that parse_address_v4 agrees with it.
+
+namespace ip_address_v4_parse {
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::make_address_v4;
+  using std::experimental::net::ip::parse_address_v4;
+  using std::experimental::net::ip::parse_result;
+
+  std::error_code ec;
+
+  address_v4 a1 = make_address_v4("1.2.3.4", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a1.to_ulong() == 0x01020304);
+
+  address_v4 a2 = make_address_v4("0.0.0.0", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a2.to_ulong() == 0);
+
+  address_v4 a3 = make_address_v4("255.255.255.255", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a3.to_ulong() == 0xFFFFFFFF);
+
+  address_v4 a4 = make_address_v4("192.168.10.200", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a4.to_ulong() == 0xC0A80AC8);
+
+  address_v4 a5 = make_address_v4("10.0.100.1", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a5.to_ulong() == 0x0A006401);
+
+  const char field[] = "10.1.2.3,192.168.0.1";
+  address_v4 a6 = make_address_v4(field + 9, 11, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a6.to_ulong() == 0xC0A80001);
+
+  address_v4 a7 = make_address_v4(field, 8, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a7.to_ulong() == 0x0A010203);
+
+  make_address_v4(field, 9, ec);
+  STDNET_CHECK(!!ec);
+
+  make_address_v4(std::string("1.2.3.4\0", 8), ec);
+  STDNET_CHECK(!!ec);
+
+  const char list[] = "10.1.2.3:8080,1.2.3.4.5,1.2.3.456";
+  const char* const list_end = list + sizeof(list) - 1;
+  address_v4 a8;
+  std::experimental::net::ip::from_chars_result r =
+    std::experimental::net::ip::from_chars(list, list_end, a8);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == list + 8);
+  STDNET_CHECK(a8.to_ulong() == 0x0A010203);
+
+  r = std::experimental::net::ip::from_chars(list + 14, list_end, a8);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == list + 21);
+  STDNET_CHECK(a8.to_ulong() == 0x01020304);
+
+  r = std::experimental::net::ip::from_chars(list + 24, list_end, a8);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == list_end - 1);
+  STDNET_CHECK(a8.to_ulong() == 0x0102032D);
+
+  r = std::experimental::net::ip::from_chars(list + 8, list_end, a8);
+  STDNET_CHECK(r.ec == std::errc::invalid_argument);
+  STDNET_CHECK(r.ptr == list + 8);
+  STDNET_CHECK(a8.to_ulong() == 0x0102032D);
+
+  const char* invalid[] =
+  {
+    "", "1", "1.2.3", "1.2.3.", "1.2.3.4.", ".1.2.3.4", "1..2.3",
+    "1.2.3.4.5", "256.1.1.1", "1.2.3.256", "1.2.3.04", "01.2.3.4",
+    "1.2.3.00", "1.2.3.1000", "1.2.3.4 ", " 1.2.3.4", "1.2.3.-4",
+    "1.2.3.a", "0x1.2.3.4", "1.2.3.4:80", "255.255.255.255.255",
+    "::1", "1234567890123456"
+  };
+
+  for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+  {
+    address_v4 a = make_address_v4(invalid[i], ec);
+    STDNET_CHECK(!!ec);
+    STDNET_CHECK(a == address_v4());
+
+    parse_result<address_v4> p = parse_address_v4(invalid[i]);
+    STDNET_CHECK(!p.has_value());
+    STDNET_CHECK(p.error() == std::errc::invalid_argument);
+    STDNET_CHECK(p.value_or(a1) == a1);
+  }
+
+  parse_result<address_v4> p1 = parse_address_v4("192.168.10.200");
+  STDNET_CHECK(p1.has_value());
+  STDNET_CHECK(*p1 == a4);
+  STDNET_CHECK(p1->to_ulong() == 0xC0A80AC8);
+
+  parse_result<address_v4> p2 = parse_address_v4(field + 9, 11);
+  STDNET_CHECK(!!p2);
+  STDNET_CHECK(*p2 == a6);
+
+  parse_result<address_v4> p3 = parse_address_v4(std::string(field, 8));
+  STDNET_CHECK(!!p3);
+  STDNET_CHECK(*p3 == a7);
+
+  STDNET_CHECK(!parse_address_v4(field, 9));
+  STDNET_CHECK(!parse_address_v4(std::string("1.2.3.4\0", 8)));
+}
+
+} // namespace ip_address_v4_parse
+
+//------------------------------------------------------------------------------
+
+// ip_address_v4_format test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that to_chars and to_string produce the dotted
+// decimal form of every octet value, and that to_chars respects the size of
+// the buffer.
+
+namespace ip_address_v4_format {
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::to_chars;
+  using std::experimental::net::ip::to_chars_result;
+
+  for (unsigned i = 0; i < 256; ++i)
+  {
+    address_v4 a(address_v4::bytes_type(i, 255 - i, i / 2, 9));
+    char expected[16];
+    std::sprintf(expected, "%u.%u.%u.9", i, 255 - i, i / 2);
+    const std::size_t length = std::strlen(expected);
+
+    char buffer[32];
+    to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), a);
+    STDNET_CHECK(r.ec == std::errc());
+    STDNET_CHECK(r.ptr == buffer + length);
+    STDNET_CHECK(std::memcmp(buffer, expected, length) == 0);
+
+    r = to_chars(buffer, buffer + length, a);
+    STDNET_CHECK(r.ec == std::errc());
+    STDNET_CHECK(r.ptr == buffer + length);
+    STDNET_CHECK(std::memcmp(buffer, expected, length) == 0);
+
+    r = to_chars(buffer, buffer + length - 1, a);
+    STDNET_CHECK(r.ec == std::errc::value_too_large);
+    STDNET_CHECK(r.ptr == buffer + length - 1);
+
+    STDNET_CHECK(a.to_string() == expected);
+    
+    std::ostringstream os;
+    os << a;
+    STDNET_CHECK(os.str() == expected);
+  }
+}
+
+} // namespace ip_address_v4_format
+
+//------------------------------------------------------------------------------
+
 STDNET_TEST_SUITE
 (
   "ip/address_v4",
   STDNET_TEST_CASE(ip_address_v4_compile::test)
   STDNET_TEST_CASE(ip_address_v4_runtime::test)
+  STDNET_TEST_CASE(ip_address_v4_compare::test)
+  STDNET_TEST_CASE(ip_address_v4_parse::test)
+  STDNET_TEST_CASE(ip_address_v4_format::test)
 )
@@ -12,7 +12,13 @@
 #include "std/net/ip/address_v6.hpp"
 
 #include "../unit_test.hpp"
+#include <cstring>
 #include <sstream>
+#include <vector>
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+# include <net/if.h>
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
 
 //------------------------------------------------------------------------------
 
@@ -122,6 +128,35 @@ void test()
     addr1 = ip::make_address_v6("0::0", ec);
     addr1 = ip::make_address_v6(string_value);
     addr1 = ip::make_address_v6(string_value, ec);
+    addr1 = ip::make_address_v6("0::0", 4);
+    addr1 = ip::make_address_v6("0::0", 4, ec);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = ip::make_address_v6(std::string_view(string_value));
+    addr1 = ip::make_address_v6(std::string_view(string_value), ec);
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+    const char* first = string_value.data();
+    const char* last = first + string_value.size();
+    ip::from_chars_result result = ip::from_chars(first, last, addr1);
+    (void)result;
+
+    char buffer[80];
+    ip::to_chars_result to_result = ip::to_chars(buffer, buffer + 80, addr1);
+    (void)to_result;
+
+    ip::parse_result<ip::address_v6> parse_result =
+      ip::parse_address_v6("0::0");
+    parse_result = ip::parse_address_v6(string_value);
+    parse_result = ip::parse_address_v6("0::0", 4);
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+    parse_result = ip::parse_address_v6(std::string_view(string_value));
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+    addr1 = parse_result.value_or(addr1);
+
+    // address_v6 hashing.
+
+    std::size_t hash_value = std::hash<ip::address_v6>()(addr1);
+    (void)hash_value;
 
     // address_v6 I/O.
 
@@ -347,9 +382,332 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_address_v6_compare test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that equality and ordering follow the bytes of
+// the address in network byte order, with the scope ID breaking ties.
+
+namespace ip_address_v6_compare {
+
+void test()
+{
+  using std::experimental::net::ip::address_v6;
+
+  // Each pair of addresses differs in one byte, in each position and in both
+  // directions, so that every byte of both 64-bit halves is significant.
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    address_v6::bytes_type low_bytes, high_bytes;
+    for (std::size_t j = 0; j < 16; ++j)
+      low_bytes[j] = high_bytes[j] = static_cast<unsigned char>(0x80 + j);
+    low_bytes[i] = 0x7f;
+    high_bytes[i] = 0x81;
+
+    address_v6 low(low_bytes, 9), high(high_bytes, 1);
+    STDNET_CHECK(low < high);
+    STDNET_CHECK(!(high < low));
+    STDNET_CHECK(low != high);
+    STDNET_CHECK(high > low);
+    STDNET_CHECK(low <= high);
+    STDNET_CHECK(high >= low);
+  }
+
+  address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+  bytes[15] = 1;
+  address_v6 a1(bytes, 1), a2(bytes, 2), a3(bytes, 1);
+  STDNET_CHECK(a1 == a3);
+  STDNET_CHECK(!(a1 < a3));
+  STDNET_CHECK(a1 != a2);
+  STDNET_CHECK(a1 < a2);
+  STDNET_CHECK(!(a2 < a1));
+}
+
+} // namespace ip_address_v6_compare
+
+//------------------------------------------------------------------------------
+
+// ip_address_v6_parse test
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that make_address_v6 accepts exactly the strings
+// accepted by inet_pton(AF_INET6), together with an optional zone ID, and that
+// parse_address_v6 agrees with it.
+
+namespace ip_address_v6_parse {
+
+void test()
+{
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address_v6;
+  using std::experimental::net::ip::parse_address_v6;
+  using std::experimental::net::ip::parse_result;
+
+  std::error_code ec;
+
+  address_v6 a1 = make_address_v6("::", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a1.is_unspecified());
+
+  address_v6 a2 = make_address_v6("::1", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a2.is_loopback());
+
+  address_v6 a3 = make_address_v6("1:2:3:4:5:6:7:8", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a3.to_bytes()[0] == 0 && a3.to_bytes()[1] == 1);
+  STDNET_CHECK(a3.to_bytes()[14] == 0 && a3.to_bytes()[15] == 8);
+
+  address_v6 a4 = make_address_v6("FEDC:ba98::7654:3210", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a4.to_bytes()[0] == 0xFE && a4.to_bytes()[1] == 0xDC);
+  STDNET_CHECK(a4.to_bytes()[2] == 0xBA && a4.to_bytes()[3] == 0x98);
+  STDNET_CHECK(a4.to_bytes()[4] == 0 && a4.to_bytes()[11] == 0);
+  STDNET_CHECK(a4.to_bytes()[12] == 0x76 && a4.to_bytes()[13] == 0x54);
+  STDNET_CHECK(a4.to_bytes()[14] == 0x32 && a4.to_bytes()[15] == 0x10);
+
+  address_v6 a5 = make_address_v6("::ffff:1.2.3.4", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a5.is_v4_mapped());
+  STDNET_CHECK(a5.to_bytes()[12] == 1 && a5.to_bytes()[15] == 4);
+
+  address_v6 a6 = make_address_v6("1:2:3:4:5:6:255.255.255.255", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a6.to_bytes()[11] == 6 && a6.to_bytes()[12] == 0xFF);
+
+  address_v6 a7 = make_address_v6("1:2:3:4:5:6:7::", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a7.to_bytes()[13] == 7 && a7.to_bytes()[15] == 0);
+
+  address_v6 a8 = make_address_v6("fe80::1%42", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a8.is_link_local());
+  STDNET_CHECK(a8.scope_id() == 42);
+
+  address_v6 a9 = make_address_v6("2001:db8::1%7", ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a9.scope_id() == 7);
+
+  const char field[] = "[fe80::1%3]:443";
+  address_v6 a10 = make_address_v6(field + 1, 9, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a10.is_link_local());
+  STDNET_CHECK(a10.scope_id() == 3);
+
+  address_v6 a11 = make_address_v6(field + 1, 7, ec);
+  STDNET_CHECK(!ec);
+  STDNET_CHECK(a11.scope_id() == 0);
+
+  make_address_v6(field, 10, ec);
+  STDNET_CHECK(!!ec);
+
+  const char uri[] = "[fe80::1%4]:443,::ffff:1.2.3.4]";
+  const char* const uri_end = uri + sizeof(uri) - 1;
+  address_v6 a12;
+  std::experimental::net::ip::from_chars_result r =
+    std::experimental::net::ip::from_chars(uri + 1, uri_end, a12);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == uri + 10);
+  STDNET_CHECK(a12.is_link_local());
+  STDNET_CHECK(a12.scope_id() == 4);
+
+  r = std::experimental::net::ip::from_chars(uri + 16, uri_end, a12);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == uri_end - 1);
+  STDNET_CHECK(a12.is_v4_mapped());
+
+  r = std::experimental::net::ip::from_chars(uri + 11, uri_end, a12);
+  STDNET_CHECK(r.ptr == uri + 11);
+  STDNET_CHECK(r.ec == std::errc::invalid_argument);
+  STDNET_CHECK(a12.is_v4_mapped());
+
+  const char* invalid[] =
+  {
+    "", ":", ":::", "1:", ":1", "1::2::3", "1:2:3:4:5:6:7", "12345::",
+    "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7:8::", "::1:2:3:4:5:6:7:8",
+    "1:2:3:4:5:6:7:1.2.3.4", "::1.2.3", "::1.2.3.4:5", "1.2.3.4::",
+    "::01.2.3.4", "::256.1.2.3", "::g", " ::1", "::1 ", "1.2.3.4",
+    "0000:0000:0000:0000:0000:0000:0000:0000:0"
+  };
+
+  for (std::size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i)
+  {
+    address_v6 a = make_address_v6(invalid[i], ec);
+    STDNET_CHECK(!!ec);
+    STDNET_CHECK(a == address_v6());
+
+    parse_result<address_v6> p = parse_address_v6(invalid[i]);
+    STDNET_CHECK(!p.has_value());
+    STDNET_CHECK(p.error() == std::errc::invalid_argument);
+    STDNET_CHECK(p.value_or(a2) == a2);
+  }
+
+  parse_result<address_v6> p1 = parse_address_v6("FEDC:ba98::7654:3210");
+  STDNET_CHECK(p1.has_value());
+  STDNET_CHECK(*p1 == a4);
+
+  parse_result<address_v6> p2 = parse_address_v6(std::string("fe80::1%42"));
+  STDNET_CHECK(!!p2);
+  STDNET_CHECK(p2->scope_id() == 42);
+
+  parse_result<address_v6> p3 = parse_address_v6(field + 1, 9);
+  STDNET_CHECK(!!p3);
+  STDNET_CHECK(*p3 == a10);
+
+  STDNET_CHECK(!parse_address_v6(field, 10));
+}
+
+} // namespace ip_address_v6_parse
+
+//------------------------------------------------------------------------------
+
+// ip_address_v6_format test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that to_chars and to_string produce the text form
+// recommended by RFC 5952, and that to_chars respects the size of the buffer.
+
+namespace ip_address_v6_format {
+
+void check(const char* text, const char* expected)
+{
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address_v6;
+  using std::experimental::net::ip::to_chars;
+  using std::experimental::net::ip::to_chars_result;
+
+  address_v6 a = make_address_v6(text);
+  const std::size_t length = std::strlen(expected);
+
+  char buffer[80];
+  to_chars_result r = to_chars(buffer, buffer + sizeof(buffer), a);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == buffer + length);
+  STDNET_CHECK(std::memcmp(buffer, expected, length) == 0);
+
+  r = to_chars(buffer, buffer + length, a);
+  STDNET_CHECK(r.ec == std::errc());
+  STDNET_CHECK(r.ptr == buffer + length);
+  STDNET_CHECK(std::memcmp(buffer, expected, length) == 0);
+
+  r = to_chars(buffer, buffer + length - 1, a);
+  STDNET_CHECK(r.ec == std::errc::value_too_large);
+  STDNET_CHECK(r.ptr == buffer + length - 1);
+
+  STDNET_CHECK(a.to_string() == expected);
+  
+  std::ostringstream os;
+  os << a;
+  STDNET_CHECK(os.str() == expected);
+}
+
+void test()
+{
+  check("::", "::");
+  check("::1", "::1");
+  check("1::", "1::");
+  check("1:0:0:2::3", "1:0:0:2::3");
+  check("1:0:0:2:0:0:0:3", "1:0:0:2::3");
+  check("1:0:2:0:3:0:4:0", "1:0:2:0:3:0:4:0");
+  check("2001:DB8:0:0:1:0:0:1", "2001:db8::1:0:0:1");
+  check("2001:db8:a:bc:def0:1234:5678:9abc",
+      "2001:db8:a:bc:def0:1234:5678:9abc");
+  check("::ffff:1.2.3.4", "::ffff:1.2.3.4");
+  check("::1.2.3.4", "::1.2.3.4");
+  check("::1:ffff:1.2.3.4", "::1:ffff:102:304");
+  check("fe80::1%4294967295", "fe80::1%4294967295");
+  check("2001:db8::1%7", "2001:db8::1%7");
+
+#if !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+  // A link-local zone ID that names an interface is converted to and from the
+  // interface index, whether the name or the index is given.
+  if (struct if_nameindex* interfaces = if_nameindex())
+  {
+    for (struct if_nameindex* p = interfaces; p->if_index != 0; ++p)
+    {
+      const std::string name_text = std::string("fe80::1%") + p->if_name;
+      std::ostringstream index_text;
+      index_text << "fe80::1%" << p->if_index;
+
+      using std::experimental::net::ip::make_address_v6;
+      STDNET_CHECK(make_address_v6(name_text).scope_id() == p->if_index);
+      STDNET_CHECK(make_address_v6(name_text).to_string() == name_text);
+      STDNET_CHECK(make_address_v6(index_text.str()).to_string() == name_text);
+    }
+    if_freenameindex(interfaces);
+  }
+#endif // !defined(STDNET_WINDOWS) && !defined(__CYGWIN__)
+}
+
+} // namespace ip_address_v6_format
+
+//------------------------------------------------------------------------------
+
+// ip_address_v6_hash test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the hashes of sequential addresses, and of
+// addresses that differ only in their scope ID or their upper word, are
+// spread across the low bits that select a bucket in a power-of-two table.
+
+namespace ip_address_v6_hash {
+
+// Count the distinct values of the low 16 bits of a set of hashes.
+std::size_t low_bit_spread(const std::vector<std::size_t>& hashes)
+{
+  std::vector<bool> seen(65536);
+  std::size_t distinct = 0;
+  for (std::size_t i = 0; i < hashes.size(); ++i)
+  {
+    const std::size_t bucket = hashes[i] & 0xFFFF;
+    distinct += !seen[bucket];
+    seen[bucket] = true;
+  }
+  return distinct;
+}
+
+void test()
+{
+  using std::experimental::net::ip::address_v6;
+
+  // For 65536 keys in 65536 buckets, a random hash fills about 63% of them.
+  const std::size_t count = 65536;
+  const std::size_t expected = count * 6 / 10;
+
+  address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8,
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  std::vector<std::size_t> hashes(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    bytes[14] = static_cast<unsigned char>(i >> 8);
+    bytes[15] = static_cast<unsigned char>(i);
+    hashes[i] = std::hash<address_v6>()(address_v6(bytes));
+  }
+  STDNET_CHECK(low_bit_spread(hashes) >= expected);
+
+  bytes[14] = 0;
+  bytes[15] = 1;
+  for (std::size_t i = 0; i < count; ++i)
+    hashes[i] = std::hash<address_v6>()(
+        address_v6(bytes, static_cast<unsigned long>(i)));
+  STDNET_CHECK(low_bit_spread(hashes) >= expected);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    bytes[6] = static_cast<unsigned char>(i >> 8);
+    bytes[7] = static_cast<unsigned char>(i);
+    hashes[i] = std::hash<address_v6>()(address_v6(bytes));
+  }
+  STDNET_CHECK(low_bit_spread(hashes) >= expected);
+}
+
+} // namespace ip_address_v6_hash
+
+//------------------------------------------------------------------------------
+
 STDNET_TEST_SUITE
 (
   "ip/address_v6",
   STDNET_TEST_CASE(ip_address_v6_compile::test)
   STDNET_TEST_CASE(ip_address_v6_runtime::test)
+  STDNET_TEST_CASE(ip_address_v6_compare::test)
+  STDNET_TEST_CASE(ip_address_v6_parse::test)
+  STDNET_TEST_CASE(ip_address_v6_format::test)
+  STDNET_TEST_CASE(ip_address_v6_hash::test)
 )
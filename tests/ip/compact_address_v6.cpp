@@ -0,0 +1,174 @@
+//
+// compact_address_v6.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/compact_address_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <unordered_set>
+
+//------------------------------------------------------------------------------
+
+// ip_compact_address_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::compact_address_v6 compile and link correctly. Runtime failures are
+// ignored.
+
+namespace ip_compact_address_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    // compact_address_v6 constructors.
+
+    ip::compact_address_v6 addr1;
+    const ip::compact_address_v6::bytes_type const_bytes_value(0);
+    ip::compact_address_v6 addr2(const_bytes_value);
+    ip::compact_address_v6 addr3(ip::address_v6::loopback());
+
+    // compact_address_v6 functions.
+
+    ip::compact_address_v6::bytes_type bytes_value = addr1.to_bytes();
+    (void)bytes_value;
+
+    ip::address_v6 v6_value = addr1.to_address_v6();
+    v6_value = addr3;
+
+    unsigned long long word = addr1.high();
+    word = addr1.low();
+    (void)word;
+
+    // compact_address_v6 comparisons.
+
+    bool b = (addr1 == addr2);
+    (void)b;
+
+    b = (addr1 != addr2);
+    (void)b;
+
+    b = (addr1 < addr2);
+    (void)b;
+
+    b = (addr1 > addr2);
+    (void)b;
+
+    b = (addr1 <= addr2);
+    (void)b;
+
+    b = (addr1 >= addr2);
+    (void)b;
+
+    // compact_address_v6 hashing.
+
+    std::size_t hash_value = std::hash<ip::compact_address_v6>()(addr1);
+    (void)hash_value;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_compact_address_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_compact_address_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a compact_address_v6 holds the same address
+// as the address_v6 it was made from, and orders and hashes addresses in the
+// same way.
+
+namespace ip_compact_address_v6_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::compact_address_v6;
+  using std::experimental::net::ip::bad_address_cast;
+
+  STDNET_CHECK(sizeof(compact_address_v6) == 16);
+
+  compact_address_v6 a1;
+  STDNET_CHECK(a1.to_address_v6() == address_v6::any());
+  STDNET_CHECK(a1.high() == 0 && a1.low() == 0);
+
+  address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+      0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef);
+  compact_address_v6 a2(bytes);
+  STDNET_CHECK(a2.to_bytes() == bytes);
+  STDNET_CHECK(a2.high() == 0x20010db800000000ULL);
+  STDNET_CHECK(a2.low() == 0x0123456789abcdefULL);
+
+  address_v6 v1 = a2;
+  STDNET_CHECK(v1 == address_v6(bytes));
+  STDNET_CHECK(v1.scope_id() == 0);
+  STDNET_CHECK(compact_address_v6(v1) == a2);
+
+  bool caught = false;
+  try
+  {
+    compact_address_v6 a3(address_v6(bytes, 1));
+    (void)a3;
+  }
+  catch (bad_address_cast&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  // Each pair of addresses differs in one byte, in each position, so that the
+  // ordering must agree with address_v6.
+  for (std::size_t i = 0; i < 16; ++i)
+  {
+    address_v6::bytes_type low_bytes, high_bytes;
+    for (std::size_t j = 0; j < 16; ++j)
+      low_bytes[j] = high_bytes[j] = static_cast<unsigned char>(0x80 + j);
+    low_bytes[i] = 0x7f;
+    high_bytes[i] = 0x81;
+
+    compact_address_v6 low(low_bytes), high(high_bytes);
+    STDNET_CHECK(low < high);
+    STDNET_CHECK(!(high < low));
+    STDNET_CHECK(low != high);
+    STDNET_CHECK(high > low);
+    STDNET_CHECK(low <= high);
+    STDNET_CHECK(high >= low);
+    STDNET_CHECK(low.to_bytes() == low_bytes);
+    STDNET_CHECK(high.to_bytes() == high_bytes);
+  }
+
+  std::unordered_set<compact_address_v6> set;
+  set.insert(a1);
+  set.insert(a2);
+  set.insert(compact_address_v6(bytes));
+  STDNET_CHECK(set.size() == 2);
+  STDNET_CHECK(set.count(compact_address_v6(address_v6::any())) == 1);
+
+  // An address hashes the same in either form.
+  STDNET_CHECK(std::hash<compact_address_v6>()(a2)
+      == std::hash<address_v6>()(address_v6(bytes)));
+  STDNET_CHECK(std::hash<compact_address_v6>()(a1)
+      == std::hash<address_v6>()(address_v6::any()));
+}
+
+} // namespace ip_compact_address_v6_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/compact_address_v6",
+  STDNET_TEST_CASE(ip_compact_address_v6_compile::test)
+  STDNET_TEST_CASE(ip_compact_address_v6_runtime::test)
+)
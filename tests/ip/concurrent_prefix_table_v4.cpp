@@ -0,0 +1,292 @@
+//
+// concurrent_prefix_table_v4.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/concurrent_prefix_table_v4.hpp"
+
+#include "../unit_test.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v4_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the classes
+// ip::concurrent_prefix_table_v4 and ip::concurrent_prefix_table_v4::reader
+// compile and link correctly. Runtime failures are ignored.
+
+namespace ip_concurrent_prefix_table_v4_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    ip::concurrent_prefix_table_v4 table;
+    const ip::concurrent_prefix_table_v4::reader reader(table);
+
+    table.insert(ip::address_v4(0x0A000000), 8, 1);
+
+    bool b = table.erase(ip::address_v4(0x0A000000), 8);
+    (void)b;
+
+    std::size_t size = table.size();
+    (void)size;
+
+    ip::concurrent_prefix_table_v4::value_type value =
+      reader.lookup(ip::address_v4(0x0A000001));
+    (void)value;
+
+    ip::address_v4 addrs[2];
+    ip::concurrent_prefix_table_v4::value_type values[2];
+    reader.lookup(addrs, 2, values);
+
+    table.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_concurrent_prefix_table_v4_compile
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v4_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups find the longest matching prefix as
+// prefixes are added and removed, by comparing with a linear search.
+
+namespace ip_concurrent_prefix_table_v4_runtime {
+
+struct route
+{
+  unsigned long prefix;
+  unsigned int length;
+  unsigned long value;
+};
+
+unsigned long mask(unsigned long a, unsigned int length)
+{
+  return length == 0 ? 0 : a & (0xFFFFFFFFUL << (32 - length));
+}
+
+unsigned long linear_lookup(const std::vector<route>& routes, unsigned long a)
+{
+  unsigned long value = 0xFFFFFFFF;
+  int best = -1;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    if (static_cast<int>(routes[i].length) > best
+        && mask(a, routes[i].length) == routes[i].prefix)
+    {
+      best = routes[i].length;
+      value = routes[i].value;
+    }
+  }
+  return value;
+}
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::concurrent_prefix_table_v4;
+
+  concurrent_prefix_table_v4 table;
+  const concurrent_prefix_table_v4::reader reader(table);
+  STDNET_CHECK(table.size() == 0);
+  const concurrent_prefix_table_v4::value_type no_value =
+    concurrent_prefix_table_v4::no_value;
+  STDNET_CHECK(reader.lookup(address_v4(0x0A000001)) == no_value);
+
+  table.insert(address_v4(0x0A000000), 8, 1);
+  table.insert(address_v4(0x0A010000), 16, 2);
+  table.insert(address_v4(0x0A010180), 25, 3);
+  table.insert(address_v4(0x0A010181), 32, 4);
+  STDNET_CHECK(table.size() == 4);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A020304)) == 1);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010203)) == 2);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A01017F)) == 2);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010180)) == 3);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010181)) == 4);
+  STDNET_CHECK(reader.lookup(address_v4(0x0B000000)) == no_value);
+
+  // Host bits are ignored, and inserting an existing prefix replaces it.
+  table.insert(address_v4(0x0A0101FF), 25, 5);
+  STDNET_CHECK(table.size() == 4);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010180)) == 5);
+
+  // Removing a prefix exposes the next longest one.
+  STDNET_CHECK(table.erase(address_v4(0x0A010000), 16));
+  STDNET_CHECK(!table.erase(address_v4(0x0A010000), 16));
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010203)) == 1);
+  STDNET_CHECK(table.erase(address_v4(0x0A010180), 25));
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010180)) == 1);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010181)) == 4);
+
+  table.insert(address_v4(0), 0, 0);
+  STDNET_CHECK(reader.lookup(address_v4(0xC0000201)) == 0);
+
+  bool caught = false;
+  try
+  {
+    table.insert(address_v4(0), 33, 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    table.insert(address_v4(0), 8, concurrent_prefix_table_v4::max_value + 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  table.clear();
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(reader.lookup(address_v4(0x0A010181)) == no_value);
+
+  // Random prefixes, concentrated in a /12 so that they overlap, are added and
+  // removed, and lookups are compared with a linear search after each step.
+  std::srand(42);
+  std::vector<route> routes;
+  for (int step = 0; step < 400; ++step)
+  {
+    if (routes.empty() || std::rand() % 3 != 0)
+    {
+      route r;
+      r.length = 12 + std::rand() % 21;
+      r.prefix = mask(0xAC100000UL | ((static_cast<unsigned long>(std::rand())
+              << 8) & 0x000FFFFF) | (std::rand() & 0xFF), r.length);
+      r.value = std::rand() % 1000;
+      bool replaced = false;
+      for (std::size_t i = 0; i < routes.size(); ++i)
+      {
+        if (routes[i].prefix == r.prefix && routes[i].length == r.length)
+        {
+          routes[i].value = r.value;
+          replaced = true;
+        }
+      }
+      if (!replaced)
+        routes.push_back(r);
+      table.insert(address_v4(r.prefix), r.length, r.value);
+    }
+    else
+    {
+      const std::size_t i = std::rand() % routes.size();
+      STDNET_CHECK(table.erase(address_v4(routes[i].prefix), routes[i].length));
+      routes.erase(routes.begin() + i);
+    }
+
+    STDNET_CHECK(table.size() == routes.size());
+
+    std::vector<address_v4> addrs;
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+      addrs.push_back(address_v4(routes[i].prefix));
+      addrs.push_back(address_v4(routes[i].prefix
+            | (0xFFFFFFFFUL >> routes[i].length)));
+    }
+    for (int i = 0; i < 50; ++i)
+      addrs.push_back(address_v4(0xAC100000UL | (std::rand() & 0xFFFFF)));
+
+    std::vector<concurrent_prefix_table_v4::value_type> values(addrs.size());
+    reader.lookup(addrs.data(), addrs.size(), values.data());
+    for (std::size_t i = 0; i < addrs.size(); ++i)
+    {
+      const unsigned long expected = linear_lookup(routes, addrs[i].to_ulong());
+      STDNET_CHECK(reader.lookup(addrs[i]) == expected);
+      STDNET_CHECK(values[i] == expected);
+    }
+  }
+}
+
+} // namespace ip_concurrent_prefix_table_v4_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v4_threads test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups from several threads see consistent
+// results while another thread modifies the table.
+
+namespace ip_concurrent_prefix_table_v4_threads {
+
+using std::experimental::net::ip::address_v4;
+using std::experimental::net::ip::concurrent_prefix_table_v4;
+
+void read(const concurrent_prefix_table_v4& table,
+    const std::atomic<bool>& done)
+{
+  const concurrent_prefix_table_v4::reader reader(table);
+  unsigned long a = 0;
+  while (!done.load())
+  {
+    // 192.168.0.0/16 is never changed. Within 10.0.0.0/8, each /24 is either
+    // absent or maps to its third octet, and is covered by the /8.
+    a = a * 1103515245 + 12345;
+    STDNET_CHECK(reader.lookup(address_v4(0xC0A80000 | (a & 0xFFFF))) == 7);
+    const unsigned long b = 0x0A000000 | (a & 0xFFFFFF);
+    const concurrent_prefix_table_v4::value_type value =
+      reader.lookup(address_v4(b));
+    STDNET_CHECK(value == 1 || value == ((b >> 8) & 0xFF) + 100);
+  }
+}
+
+void test()
+{
+  concurrent_prefix_table_v4 table;
+  table.insert(address_v4(0xC0A80000), 16, 7);
+  table.insert(address_v4(0x0A000000), 8, 1);
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+    readers.push_back(std::thread(read, std::cref(table), std::cref(done)));
+
+  std::srand(42);
+  for (int step = 0; step < 20000; ++step)
+  {
+    const unsigned long third = std::rand() & 0xFF;
+    const address_v4 prefix(0x0A000000 | (third << 8));
+    if (std::rand() % 2)
+      table.insert(prefix, 24, third + 100);
+    else
+      table.erase(prefix, 24);
+  }
+
+  done.store(true);
+  for (std::size_t i = 0; i < readers.size(); ++i)
+    readers[i].join();
+}
+
+} // namespace ip_concurrent_prefix_table_v4_threads
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/concurrent_prefix_table_v4",
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v4_compile::test)
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v4_runtime::test)
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v4_threads::test)
+)
@@ -0,0 +1,326 @@
+//
+// concurrent_prefix_table_v6.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/concurrent_prefix_table_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the classes
+// ip::concurrent_prefix_table_v6 and ip::concurrent_prefix_table_v6::reader
+// compile and link correctly. Runtime failures are ignored.
+
+namespace ip_concurrent_prefix_table_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    ip::concurrent_prefix_table_v6 table;
+    const ip::concurrent_prefix_table_v6::reader reader(table);
+
+    table.insert(ip::address_v6::loopback(), 128, 1);
+
+    bool b = table.erase(ip::address_v6::loopback(), 128);
+    (void)b;
+
+    std::size_t size = table.size();
+    (void)size;
+
+    ip::concurrent_prefix_table_v6::value_type value =
+      reader.lookup(ip::address_v6::loopback());
+    value = reader.lookup(ip::compact_address_v6());
+    (void)value;
+
+    ip::compact_address_v6 addrs[2];
+    ip::concurrent_prefix_table_v6::value_type values[2];
+    reader.lookup(addrs, 2, values);
+
+    table.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_concurrent_prefix_table_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups find the longest matching prefix as
+// prefixes are added and removed, by comparing with a linear search.
+
+namespace ip_concurrent_prefix_table_v6_runtime {
+
+using std::experimental::net::ip::address_v6;
+using std::experimental::net::ip::compact_address_v6;
+using std::experimental::net::ip::concurrent_prefix_table_v6;
+
+struct route
+{
+  address_v6::bytes_type prefix;
+  unsigned int length;
+  unsigned long value;
+};
+
+address_v6::bytes_type mask(address_v6::bytes_type bytes, unsigned int length)
+{
+  for (unsigned int i = 0; i < 16; ++i)
+  {
+    if (length >= 8 * (i + 1))
+      continue;
+    if (length <= 8 * i)
+      bytes[i] = 0;
+    else
+      bytes[i] &= static_cast<unsigned char>(0xFF << (8 * (i + 1) - length));
+  }
+  return bytes;
+}
+
+unsigned long linear_lookup(const std::vector<route>& routes,
+    const address_v6::bytes_type& bytes)
+{
+  unsigned long value = 0xFFFFFFFF;
+  int best = -1;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    if (static_cast<int>(routes[i].length) > best
+        && mask(bytes, routes[i].length) == routes[i].prefix)
+    {
+      best = routes[i].length;
+      value = routes[i].value;
+    }
+  }
+  return value;
+}
+
+address_v6::bytes_type random_bytes()
+{
+  // Addresses share the first 28 bits, and otherwise most variation is in
+  // the first 64 bits, so that prefixes overlap at every depth.
+  address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb0);
+  bytes[3] |= std::rand() & 0x0F;
+  for (std::size_t i = 4; i < 16; ++i)
+    bytes[i] = static_cast<unsigned char>(i < 8 ? std::rand() & 0x3 : 0);
+  bytes[15] = static_cast<unsigned char>(std::rand());
+  return bytes;
+}
+
+void test()
+{
+  concurrent_prefix_table_v6 table;
+  const concurrent_prefix_table_v6::reader reader(table);
+  const concurrent_prefix_table_v6::value_type no_value =
+    concurrent_prefix_table_v6::no_value;
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(reader.lookup(address_v6::loopback()) == no_value);
+
+  const address_v6::bytes_type doc(0x20, 0x01, 0x0d, 0xb8);
+  address_v6::bytes_type host = doc;
+  host[15] = 1;
+  table.insert(address_v6(doc), 32, 1);
+  table.insert(address_v6(host), 64, 2);
+  table.insert(address_v6(host), 127, 3);
+  table.insert(address_v6(host), 128, 4);
+  STDNET_CHECK(table.size() == 4);
+
+  address_v6::bytes_type a = doc;
+  a[4] = 1;
+  STDNET_CHECK(reader.lookup(address_v6(a)) == 1);
+  a = doc;
+  a[12] = 1;
+  STDNET_CHECK(reader.lookup(address_v6(a)) == 2);
+  a = host;
+  a[15] = 0;
+  STDNET_CHECK(reader.lookup(address_v6(a)) == 3);
+  STDNET_CHECK(reader.lookup(address_v6(host)) == 4);
+  STDNET_CHECK(reader.lookup(compact_address_v6(host)) == 4);
+  STDNET_CHECK(reader.lookup(address_v6(host, 3)) == 4);
+  STDNET_CHECK(reader.lookup(address_v6::loopback()) == no_value);
+
+  // Removing a prefix exposes the next longest one.
+  STDNET_CHECK(table.erase(address_v6(host), 128));
+  STDNET_CHECK(!table.erase(address_v6(host), 128));
+  STDNET_CHECK(reader.lookup(address_v6(host)) == 3);
+  STDNET_CHECK(table.erase(address_v6(doc), 64));
+  a = doc;
+  a[12] = 1;
+  STDNET_CHECK(reader.lookup(address_v6(a)) == 1);
+
+  table.insert(address_v6(), 0, 0);
+  STDNET_CHECK(reader.lookup(address_v6::loopback()) == 0);
+  STDNET_CHECK(reader.lookup(address_v6(host)) == 3);
+
+  bool caught = false;
+  try
+  {
+    table.insert(address_v6(), 129, 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  table.clear();
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(reader.lookup(address_v6(host)) == no_value);
+
+  // Random prefixes are added and removed, and lookups are compared with a
+  // linear search after each step.
+  std::srand(42);
+  std::vector<route> routes;
+  for (int step = 0; step < 300; ++step)
+  {
+    if (routes.empty() || std::rand() % 3 != 0)
+    {
+      route r;
+      const int kind = std::rand() % 4;
+      r.length = kind == 0 ? std::rand() % 17
+        : kind == 1 ? 17 + std::rand() % 48
+        : kind == 2 ? 64 : 65 + std::rand() % 64;
+      r.prefix = mask(random_bytes(), r.length);
+      r.value = std::rand() % 1000;
+      bool replaced = false;
+      for (std::size_t i = 0; i < routes.size(); ++i)
+      {
+        if (routes[i].prefix == r.prefix && routes[i].length == r.length)
+        {
+          routes[i].value = r.value;
+          replaced = true;
+        }
+      }
+      if (!replaced)
+        routes.push_back(r);
+      table.insert(address_v6(r.prefix), r.length, r.value);
+    }
+    else
+    {
+      const std::size_t i = std::rand() % routes.size();
+      STDNET_CHECK(table.erase(address_v6(routes[i].prefix),
+            routes[i].length));
+      routes.erase(routes.begin() + i);
+    }
+
+    STDNET_CHECK(table.size() == routes.size());
+
+    std::vector<compact_address_v6> addrs;
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+      addrs.push_back(compact_address_v6(routes[i].prefix));
+      address_v6::bytes_type last = routes[i].prefix;
+      for (unsigned int bit = routes[i].length; bit < 128; ++bit)
+        last[bit / 8] |= static_cast<unsigned char>(0x80 >> (bit % 8));
+      addrs.push_back(compact_address_v6(last));
+    }
+    for (int i = 0; i < 50; ++i)
+      addrs.push_back(compact_address_v6(random_bytes()));
+
+    std::vector<concurrent_prefix_table_v6::value_type> values(addrs.size());
+    reader.lookup(addrs.data(), addrs.size(), values.data());
+    for (std::size_t i = 0; i < addrs.size(); ++i)
+    {
+      const unsigned long expected =
+        linear_lookup(routes, addrs[i].to_bytes());
+      STDNET_CHECK(reader.lookup(addrs[i].to_address_v6()) == expected);
+      STDNET_CHECK(values[i] == expected);
+    }
+  }
+}
+
+} // namespace ip_concurrent_prefix_table_v6_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_concurrent_prefix_table_v6_threads test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups from several threads see consistent
+// results while another thread modifies the table.
+
+namespace ip_concurrent_prefix_table_v6_threads {
+
+using std::experimental::net::ip::address_v6;
+using std::experimental::net::ip::compact_address_v6;
+using std::experimental::net::ip::concurrent_prefix_table_v6;
+
+void read(const concurrent_prefix_table_v6& table,
+    const std::atomic<bool>& done)
+{
+  const concurrent_prefix_table_v6::reader reader(table);
+  unsigned long a = 0;
+  while (!done.load())
+  {
+    // fd00::/8 is never changed. Within 2001:db8::/32, each /48 is either
+    // absent or maps to its third group, and is covered by the /32.
+    a = a * 1103515245 + 12345;
+    address_v6::bytes_type bytes(0xfd);
+    bytes[15] = static_cast<unsigned char>(a);
+    STDNET_CHECK(reader.lookup(address_v6(bytes)) == 7);
+    bytes = address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, static_cast<unsigned char>(a >> 8));
+    bytes[5] = static_cast<unsigned char>(a >> 16);
+    const concurrent_prefix_table_v6::value_type value =
+      reader.lookup(compact_address_v6(bytes));
+    STDNET_CHECK(value == 1 || value == bytes[5] + 100u);
+  }
+}
+
+void test()
+{
+  concurrent_prefix_table_v6 table;
+  table.insert(address_v6(address_v6::bytes_type(0xfd)), 8, 7);
+  table.insert(address_v6(address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8)),
+      32, 1);
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i)
+    readers.push_back(std::thread(read, std::cref(table), std::cref(done)));
+
+  std::srand(42);
+  for (int step = 0; step < 20000; ++step)
+  {
+    const unsigned int group = std::rand() & 0xFF;
+    address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+    bytes[5] = static_cast<unsigned char>(group);
+    if (std::rand() % 2)
+      table.insert(address_v6(bytes), 48, group + 100);
+    else
+      table.erase(address_v6(bytes), 48);
+  }
+
+  done.store(true);
+  for (std::size_t i = 0; i < readers.size(); ++i)
+    readers[i].join();
+}
+
+} // namespace ip_concurrent_prefix_table_v6_threads
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/concurrent_prefix_table_v6",
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v6_compile::test)
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v6_runtime::test)
+  STDNET_TEST_CASE(ip_concurrent_prefix_table_v6_threads::test)
+)
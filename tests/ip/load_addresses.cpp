@@ -0,0 +1,197 @@
+//
+// load_addresses.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/load_addresses.hpp"
+
+#include "std/net/ip/address_cast.hpp"
+#include "../unit_test.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_load_addresses_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all overloads of ip::load_addresses,
+// ip::load_addresses_v4 and ip::load_addresses_v6 compile and link correctly.
+// Runtime failures are ignored.
+
+namespace ip_load_addresses_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    std::error_code ec;
+
+    ip::load_addresses_result<ip::address> result1 =
+      ip::load_addresses("nonexistent");
+    result1 = ip::load_addresses("nonexistent", 2);
+    result1 = ip::load_addresses("nonexistent", 2, ec);
+
+    ip::load_addresses_result<ip::address_v4> result2 =
+      ip::load_addresses_v4("nonexistent");
+    result2 = ip::load_addresses_v4("nonexistent", 2);
+    result2 = ip::load_addresses_v4("nonexistent", 2, ec);
+
+    ip::load_addresses_result<ip::address_v6> result3 =
+      ip::load_addresses_v6("nonexistent");
+    result3 = ip::load_addresses_v6("nonexistent", 2);
+    result3 = ip::load_addresses_v6("nonexistent", 2, ec);
+
+    std::size_t n = result1.addresses.size() + result1.failed_lines.size();
+    (void)n;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_load_addresses_compile
+
+//------------------------------------------------------------------------------
+
+// ip_load_addresses_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a file large enough to be split into many
+// chunks loads in file order, with the same result for any number of threads.
+
+namespace ip_load_addresses_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_cast;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::load_addresses;
+  using std::experimental::net::ip::load_addresses_result;
+  using std::experimental::net::ip::load_addresses_v4;
+  using std::experimental::net::ip::load_addresses_v6;
+  using std::experimental::net::ip::make_address;
+
+  const char* path = "load_addresses.tmp";
+
+  // Build the file and the expected results together. Every 97th line is
+  // invalid, some lines end with CRLF, and the last line has no newline.
+  std::string text;
+  std::vector<address> expected;
+  std::vector<address_v4> expected_v4;
+  std::vector<std::size_t> expected_failed, expected_failed_v4;
+  const std::size_t line_count = 60000;
+  for (std::size_t line = 1; line <= line_count; ++line)
+  {
+    char buffer[64];
+    if (line % 97 == 0)
+      std::snprintf(buffer, sizeof(buffer), "%s", line % 2 ? "" : "bad");
+    else if (line % 5 == 0)
+      std::snprintf(buffer, sizeof(buffer), "2001:db8::%x",
+          static_cast<unsigned>(line));
+    else
+      std::snprintf(buffer, sizeof(buffer), "10.%u.%u.%u",
+          static_cast<unsigned>(line >> 16 & 0xFF),
+          static_cast<unsigned>(line >> 8 & 0xFF),
+          static_cast<unsigned>(line & 0xFF));
+
+    text += buffer;
+    if (line != line_count)
+      text += line % 3 ? "\n" : "\r\n";
+    else
+      text += "\r";
+
+    std::error_code ec;
+    address addr = make_address(buffer, ec);
+    if (ec)
+    {
+      expected_failed.push_back(line);
+      expected_failed_v4.push_back(line);
+    }
+    else
+    {
+      expected.push_back(addr);
+      if (addr.is_v4())
+        expected_v4.push_back(address_cast<address_v4>(addr));
+      else
+        expected_failed_v4.push_back(line);
+    }
+  }
+
+  std::FILE* f = std::fopen(path, "wb");
+  STDNET_CHECK(f != 0);
+  if (!f)
+    return;
+  std::fwrite(text.data(), 1, text.size(), f);
+  std::fclose(f);
+
+  const std::size_t thread_counts[] = { 0, 1, 2, 3, 7 };
+  for (std::size_t i = 0; i < sizeof(thread_counts) / sizeof(std::size_t); ++i)
+  {
+    std::error_code ec;
+    load_addresses_result<address> result =
+      load_addresses(path, thread_counts[i], ec);
+    STDNET_CHECK(!ec);
+    STDNET_CHECK(result.addresses == expected);
+    STDNET_CHECK(result.failed_lines == expected_failed);
+
+    load_addresses_result<address_v4> result_v4 =
+      load_addresses_v4(path, thread_counts[i]);
+    STDNET_CHECK(result_v4.addresses == expected_v4);
+    STDNET_CHECK(result_v4.failed_lines == expected_failed_v4);
+
+    load_addresses_result<address_v6> result_v6 =
+      load_addresses_v6(path, thread_counts[i]);
+    STDNET_CHECK(result_v6.addresses.size()
+        + result_v6.failed_lines.size() == line_count);
+    STDNET_CHECK(result_v6.addresses.size()
+        == expected.size() - expected_v4.size());
+  }
+
+  // An empty file has no lines.
+  f = std::fopen(path, "wb");
+  STDNET_CHECK(f != 0);
+  if (f)
+    std::fclose(f);
+  load_addresses_result<address> empty = load_addresses(path, 2);
+  STDNET_CHECK(empty.addresses.empty());
+  STDNET_CHECK(empty.failed_lines.empty());
+
+  std::remove(path);
+
+  std::error_code ec;
+  load_addresses_result<address> missing = load_addresses(path, 2, ec);
+  STDNET_CHECK(!!ec);
+  STDNET_CHECK(missing.addresses.empty());
+
+  bool caught = false;
+  try
+  {
+    load_addresses(path);
+  }
+  catch (std::system_error&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_load_addresses_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/load_addresses",
+  STDNET_TEST_CASE(ip_load_addresses_compile::test)
+  STDNET_TEST_CASE(ip_load_addresses_runtime::test)
+)
@@ -0,0 +1,219 @@
+//
+// network_v4.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/network_v4.hpp"
+
+#include "../unit_test.hpp"
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_network_v4_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::network_v4 compile and link correctly. Runtime failures are ignored.
+
+namespace ip_network_v4_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    // network_v4 constructors.
+
+    ip::network_v4 net1;
+    ip::network_v4 net2(ip::address_v4::loopback(), 8);
+    ip::network_v4 net3(ip::address_v4::loopback(),
+        ip::make_address_v4(0xFF000000));
+
+    // network_v4 functions.
+
+    ip::address_v4 addr = net1.address();
+    addr = net1.netmask();
+    addr = net1.network();
+    addr = net1.broadcast();
+    (void)addr;
+
+    int prefix_length = net1.prefix_length();
+    (void)prefix_length;
+
+    net1 = net2.canonical();
+
+    bool b = net1.is_host();
+    b = net1.contains(ip::address_v4::loopback());
+    b = net1.is_subnet_of(net2);
+    (void)b;
+
+    ip::network_v4::iterator iter = net1.begin();
+    iter = net1.end();
+    (void)iter;
+
+    std::size_t size = net1.size();
+    (void)size;
+
+    // network_v4 comparisons.
+
+    b = (net1 == net3);
+    b = (net1 != net3);
+    (void)b;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_network_v4_compile
+
+//------------------------------------------------------------------------------
+
+// ip_network_v4_constexpr test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that networks may be built and queried in
+// constant expressions.
+
+namespace ip_network_v4_constexpr {
+
+#if defined(STDNET_HAS_CONSTEXPR)
+
+namespace ip = std::experimental::net::ip;
+
+constexpr ip::network_v4 private_net(ip::make_address_v4(0xC0A80164), 16);
+static_assert(private_net.prefix_length() == 16, "prefix length");
+static_assert(private_net.network().to_ulong() == 0xC0A80000, "network");
+static_assert(private_net.broadcast().to_ulong() == 0xC0A8FFFF, "broadcast");
+static_assert(private_net.contains(ip::make_address_v4(0xC0A8FE01)),
+    "contains");
+static_assert(!private_net.contains(ip::make_address_v4(0xC0A90001)),
+    "does not contain");
+
+constexpr ip::network_v4 masked_net(ip::make_address_v4(0x0A000001),
+    ip::make_address_v4(0xFFFFF000));
+static_assert(masked_net.prefix_length() == 20, "prefix length from mask");
+static_assert(masked_net.canonical().address().to_ulong() == 0x0A000000,
+    "canonical");
+
+#endif // defined(STDNET_HAS_CONSTEXPR)
+
+void test()
+{
+}
+
+} // namespace ip_network_v4_constexpr
+
+//------------------------------------------------------------------------------
+
+// ip_network_v4_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the addresses that a network contains and
+// iterates over.
+
+namespace ip_network_v4_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::make_address_v4;
+  using std::experimental::net::ip::network_v4;
+
+  network_v4 net1;
+  STDNET_CHECK(net1.prefix_length() == 0);
+  STDNET_CHECK(net1.contains(address_v4::broadcast()));
+  STDNET_CHECK(net1.size() == 0xFFFFFFFE);
+  STDNET_CHECK(std::distance(net1.begin(), net1.end()) == 0xFFFFFFFE);
+
+  network_v4 net2(make_address_v4(0xC0A8010A), 24);
+  STDNET_CHECK(net2.address() == make_address_v4(0xC0A8010A));
+  STDNET_CHECK(net2.netmask() == make_address_v4(0xFFFFFF00));
+  STDNET_CHECK(net2.network() == make_address_v4(0xC0A80100));
+  STDNET_CHECK(net2.broadcast() == make_address_v4(0xC0A801FF));
+  STDNET_CHECK(net2.canonical() == network_v4(make_address_v4(0xC0A80100), 24));
+  STDNET_CHECK(net2.canonical() != net2);
+  STDNET_CHECK(!net2.is_host());
+  STDNET_CHECK(net2.contains(make_address_v4(0xC0A80100)));
+  STDNET_CHECK(net2.contains(make_address_v4(0xC0A801FF)));
+  STDNET_CHECK(!net2.contains(make_address_v4(0xC0A80200)));
+  STDNET_CHECK(!net2.contains(make_address_v4(0x40A80100)));
+
+  // Hosts exclude the network and broadcast addresses.
+  STDNET_CHECK(net2.size() == 254);
+  STDNET_CHECK(*net2.begin() == make_address_v4(0xC0A80101));
+  STDNET_CHECK(net2.end()[-1] == make_address_v4(0xC0A801FE));
+  std::vector<address_v4> hosts(net2.begin(), net2.end());
+  STDNET_CHECK(hosts.size() == 254);
+  STDNET_CHECK(hosts[99] == net2.begin()[99]);
+
+  // A /31 and a /32 have no reserved addresses.
+  network_v4 net3(make_address_v4(0x0A000001), 31);
+  STDNET_CHECK(net3.size() == 2);
+  STDNET_CHECK(*net3.begin() == make_address_v4(0x0A000000));
+  STDNET_CHECK(net3.end() - net3.begin() == 2);
+  network_v4 net4(address_v4::broadcast(), 32);
+  STDNET_CHECK(net4.is_host());
+  STDNET_CHECK(net4.size() == 1);
+  STDNET_CHECK(*net4.begin() == address_v4::broadcast());
+  STDNET_CHECK(net4.end() - net4.begin() == 1);
+  STDNET_CHECK(net4.end() != net1.begin());
+
+  STDNET_CHECK(net4.is_subnet_of(net1));
+  STDNET_CHECK(net2.is_subnet_of(network_v4(make_address_v4(0xC0A80000), 16)));
+  STDNET_CHECK(!net2.is_subnet_of(net2));
+  STDNET_CHECK(!net1.is_subnet_of(net2));
+
+  // Masks give their prefix lengths, and masks with gaps are rejected.
+  for (int length = 0; length <= 32; ++length)
+  {
+    const unsigned long mask =
+      length == 0 ? 0 : (0xFFFFFFFFUL << (32 - length)) & 0xFFFFFFFF;
+    network_v4 net(address_v4::loopback(), make_address_v4(mask));
+    STDNET_CHECK(net.prefix_length() == length);
+    STDNET_CHECK(net.netmask() == make_address_v4(mask));
+  }
+
+  bool caught = false;
+  try
+  {
+    network_v4 net(address_v4::loopback(), make_address_v4(0xFF00FF00));
+    (void)net;
+  }
+  catch (std::invalid_argument&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    network_v4 net(address_v4::loopback(), 33);
+    (void)net;
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_network_v4_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/network_v4",
+  STDNET_TEST_CASE(ip_network_v4_compile::test)
+  STDNET_TEST_CASE(ip_network_v4_constexpr::test)
+  STDNET_TEST_CASE(ip_network_v4_runtime::test)
+)
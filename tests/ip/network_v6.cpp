@@ -0,0 +1,212 @@
+//
+// network_v6.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/network_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+//------------------------------------------------------------------------------
+
+// ip_network_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::network_v6 compile and link correctly. Runtime failures are ignored.
+
+namespace ip_network_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    // network_v6 constructors.
+
+    ip::network_v6 net1;
+    ip::network_v6 net2(ip::address_v6::loopback(), 64);
+
+    // network_v6 functions.
+
+    ip::address_v6 addr = net1.address();
+    addr = net1.network();
+    (void)addr;
+
+    int prefix_length = net1.prefix_length();
+    (void)prefix_length;
+
+    net1 = net2.canonical();
+
+    bool b = net1.is_host();
+    b = net1.contains(ip::address_v6::loopback());
+    b = net1.contains(ip::compact_address_v6(ip::address_v6::loopback()));
+    b = net1.is_subnet_of(net2);
+    (void)b;
+
+    ip::network_v6::iterator iter = net1.begin();
+    iter = net1.end();
+    (void)iter;
+
+    // network_v6 comparisons.
+
+    b = (net1 == net2);
+    b = (net1 != net2);
+    (void)b;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_network_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_network_v6_constexpr test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that networks may be built and queried in
+// constant expressions.
+
+namespace ip_network_v6_constexpr {
+
+#if defined(STDNET_HAS_CONSTEXPR)
+
+namespace ip = std::experimental::net::ip;
+
+constexpr ip::network_v6 doc_net(ip::address_v6(ip::address_v6::bytes_type(
+        0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1)), 32);
+static_assert(doc_net.prefix_length() == 32, "prefix length");
+static_assert(doc_net.contains(ip::address_v6(ip::address_v6::bytes_type(
+          0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff))), "contains");
+static_assert(!doc_net.contains(ip::address_v6::loopback()),
+    "does not contain");
+static_assert(doc_net.canonical() == ip::network_v6(ip::address_v6(
+        ip::address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8)), 32),
+    "canonical");
+
+#endif // defined(STDNET_HAS_CONSTEXPR)
+
+void test()
+{
+}
+
+} // namespace ip_network_v6_constexpr
+
+//------------------------------------------------------------------------------
+
+// ip_network_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the addresses that a network contains and
+// iterates over, for prefix lengths either side of the 64-bit boundary.
+
+namespace ip_network_v6_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::compact_address_v6;
+  using std::experimental::net::ip::network_v6;
+
+  const address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8, 0x12, 0x34,
+      0x56, 0x78, 0x9a, 0xbc, 0xde, 0xf0, 0x11, 0x22, 0x33, 0x44);
+  const address_v6 addr(bytes, 3);
+
+  network_v6 net1;
+  STDNET_CHECK(net1.prefix_length() == 0);
+  STDNET_CHECK(net1.contains(addr));
+  STDNET_CHECK(*net1.begin() == address_v6::any());
+  STDNET_CHECK(net1.end() != net1.begin());
+  STDNET_CHECK(net1.end()[-1].to_bytes() == address_v6::bytes_type(
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+
+  for (int length = 0; length <= 128; ++length)
+  {
+    network_v6 net(addr, length);
+    STDNET_CHECK(net.prefix_length() == length);
+    STDNET_CHECK(net.is_host() == (length == 128));
+    STDNET_CHECK(net.contains(addr));
+    STDNET_CHECK(net.contains(compact_address_v6(bytes)));
+    STDNET_CHECK(net.contains(net.network()));
+    STDNET_CHECK(net.canonical().address() == net.network());
+    STDNET_CHECK(net.network().scope_id() == 3);
+
+    // Flipping the last bit of the prefix leaves the network, and flipping
+    // the first bit after it does not.
+    if (length > 0)
+    {
+      address_v6::bytes_type outside = bytes;
+      outside[(length - 1) / 8] ^= 0x80 >> ((length - 1) % 8);
+      STDNET_CHECK(!net.contains(address_v6(outside)));
+    }
+    if (length < 128)
+    {
+      address_v6::bytes_type inside = bytes;
+      inside[length / 8] ^= 0x80 >> (length % 8);
+      STDNET_CHECK(net.contains(address_v6(inside)));
+      STDNET_CHECK(network_v6(addr, length + 1).is_subnet_of(net));
+    }
+    STDNET_CHECK(!net.is_subnet_of(net));
+  }
+
+  network_v6 net2(addr, 120);
+  STDNET_CHECK(net2.end() - net2.begin() == 256);
+  STDNET_CHECK(net2.begin()[0x44] == addr);
+  STDNET_CHECK(net2.end()[-1].to_bytes()[15] == 0xff);
+  STDNET_CHECK(net2.end()->to_bytes()[14] == 0x34);
+
+  network_v6 net3(addr, 128);
+  STDNET_CHECK(*net3.begin() == addr);
+  STDNET_CHECK(net3.end() - net3.begin() == 1);
+
+  // A /64 holds more addresses than difference_type can count, so the
+  // distance across it saturates.
+  typedef network_v6::iterator::difference_type difference_type;
+  const difference_type max = std::numeric_limits<difference_type>::max();
+  network_v6 net4(addr, 64);
+  STDNET_CHECK(net4.begin() != net4.end());
+  STDNET_CHECK(net4.end() - net4.begin() == max);
+  STDNET_CHECK(std::distance(net4.begin(), net4.end()) == max);
+  STDNET_CHECK(net4.begin() - net4.end() == -max - 1);
+  STDNET_CHECK((net4.begin() + max) - net4.begin() == max);
+  STDNET_CHECK(net4.end() - (net4.begin() + max) == max);
+  STDNET_CHECK(net4.end() - (net4.begin() + max + max) == 2);
+  STDNET_CHECK(network_v6(addr, 65).end() - network_v6(addr, 65).begin()
+      == max);
+  STDNET_CHECK(network_v6(addr, 66).end() - network_v6(addr, 66).begin()
+      == max / 2 + 1);
+
+  bool caught = false;
+  try
+  {
+    network_v6 net(addr, 129);
+    (void)net;
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace ip_network_v6_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/network_v6",
+  STDNET_TEST_CASE(ip_network_v6_compile::test)
+  STDNET_TEST_CASE(ip_network_v6_constexpr::test)
+  STDNET_TEST_CASE(ip_network_v6_runtime::test)
+)
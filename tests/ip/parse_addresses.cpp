@@ -0,0 +1,218 @@
+//
+// parse_addresses.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/parse_addresses.hpp"
+
+#include "../unit_test.hpp"
+#include <string>
+#include <vector>
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+# include <string_view>
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+//------------------------------------------------------------------------------
+
+// ip_parse_addresses_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all overloads of ip::parse_addresses compile
+// and link correctly. Runtime failures are ignored.
+
+namespace ip_parse_addresses_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  const std::string strs[1] = { "127.0.0.1" };
+  const char buffer[] = "127.0.0.1\n::1\n";
+  std::uint64_t status[1];
+
+  ip::address_v4 addrs4[1];
+  ip::address_v6 addrs6[1];
+  ip::address addrs[1];
+
+  ip::parse_addresses_result result =
+    ip::parse_addresses(strs, 1, addrs4, status);
+  result = ip::parse_addresses(strs, 1, addrs6, status);
+  result = ip::parse_addresses(strs, 1, addrs, status);
+
+#if defined(STDNET_HAS_STD_STRING_VIEW)
+  const std::string_view views[1] = { "127.0.0.1" };
+  result = ip::parse_addresses(views, 1, addrs4, status);
+  result = ip::parse_addresses(views, 1, addrs6, status);
+  result = ip::parse_addresses(views, 1, addrs, status);
+#endif // defined(STDNET_HAS_STD_STRING_VIEW)
+
+  result = ip::parse_addresses(buffer, buffer + sizeof(buffer) - 1, '\n',
+      addrs4, 1, status);
+  result = ip::parse_addresses(buffer, buffer + sizeof(buffer) - 1, '\n',
+      addrs6, 1, status);
+  result = ip::parse_addresses(buffer, buffer + sizeof(buffer) - 1, '\n',
+      addrs, 1, status);
+
+  std::size_t n = result.count + result.valid;
+  const char* ptr = result.ptr;
+  (void)n;
+  (void)ptr;
+}
+
+} // namespace ip_parse_addresses_compile
+
+//------------------------------------------------------------------------------
+
+// ip_parse_addresses_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that each string parses as it would on its own,
+// with its outcome in the matching bit of the status bitmap, across group
+// boundaries and when a buffer is parsed in pieces.
+
+namespace ip_parse_addresses_runtime {
+
+bool status_bit(const std::uint64_t* status, std::size_t i)
+{
+  return ((status[i / 64] >> (i % 64)) & 1) != 0;
+}
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address;
+  using std::experimental::net::ip::make_address_v4;
+  using std::experimental::net::ip::make_address_v6;
+  using std::experimental::net::ip::parse_addresses;
+  using std::experimental::net::ip::parse_addresses_result;
+
+  // A mix of valid and invalid strings, of every length the vector parsers
+  // accept and some they do not.
+  const char* samples[] =
+  {
+    "1.2.3.4", "255.255.255.255", "10.0.0.1", "0.0.0.0", "192.168.100.200",
+    "256.1.1.1", "1.2.3", "01.2.3.4", "1.2.3.4.", "", "1..2.3", "a.b.c.d",
+    "1.2.3.4 ", "127.0.0.1", "999.999.999.999", "100.200.250.251", "9.9.9.9",
+    "::1", "2001:db8::1", "fe80::1%3", "::ffff:1.2.3.4", "1:2:3:4:5:6:7:8:9",
+    "2001:db8::g", "1.2.3.4:80", "0.0.0.00", "1.2.3.255"
+  };
+  const std::size_t sample_count = sizeof(samples) / sizeof(samples[0]);
+
+  std::vector<std::string> strs;
+  std::string buffer;
+  for (std::size_t i = 0; i < 200; ++i)
+  {
+    strs.push_back(samples[(i * 7) % sample_count]);
+    buffer += strs.back();
+    buffer += (i % 3 == 0) ? "\r\n" : "\n";
+  }
+
+  std::vector<address_v4> addrs4(strs.size());
+  std::vector<address_v6> addrs6(strs.size());
+  std::vector<address> addrs(strs.size());
+  std::vector<std::uint64_t> status4(4, ~0ULL);
+  std::vector<std::uint64_t> status6(4, ~0ULL);
+  std::vector<std::uint64_t> status(4, ~0ULL);
+
+  parse_addresses_result result4 =
+    parse_addresses(&strs[0], strs.size(), &addrs4[0], &status4[0]);
+  parse_addresses_result result6 =
+    parse_addresses(&strs[0], strs.size(), &addrs6[0], &status6[0]);
+  parse_addresses_result result =
+    parse_addresses(&strs[0], strs.size(), &addrs[0], &status[0]);
+  STDNET_CHECK(result4.count == strs.size());
+  STDNET_CHECK(result6.count == strs.size());
+  STDNET_CHECK(result.count == strs.size());
+  STDNET_CHECK(result.ptr == 0);
+
+  std::size_t valid4 = 0, valid6 = 0, valid = 0;
+  for (std::size_t i = 0; i < strs.size(); ++i)
+  {
+    std::error_code ec;
+    address_v4 addr4 = make_address_v4(strs[i].data(), strs[i].size(), ec);
+    STDNET_CHECK(status_bit(&status4[0], i) == !ec);
+    STDNET_CHECK(addrs4[i] == addr4);
+    valid4 += !ec;
+
+    address_v6 addr6 = make_address_v6(strs[i].data(), strs[i].size(), ec);
+    STDNET_CHECK(status_bit(&status6[0], i) == !ec);
+    STDNET_CHECK(addrs6[i] == addr6);
+    valid6 += !ec;
+
+    address addr = make_address(strs[i].data(), strs[i].size(), ec);
+    STDNET_CHECK(status_bit(&status[0], i) == !ec);
+    STDNET_CHECK(addrs[i] == addr);
+    valid += !ec;
+  }
+  STDNET_CHECK(result4.valid == valid4);
+  STDNET_CHECK(result6.valid == valid6);
+  STDNET_CHECK(result.valid == valid);
+  STDNET_CHECK(valid4 > 0 && valid4 < strs.size());
+  STDNET_CHECK(valid6 > 0 && valid6 < strs.size());
+  STDNET_CHECK(valid == valid4 + valid6);
+
+  // Bits beyond the last string are zero.
+  STDNET_CHECK((status[3] >> (strs.size() % 64)) == 0);
+
+  // The delimited buffer gives the same results, and may be parsed in
+  // pieces by resuming from the returned pointer.
+  const char* first = buffer.data();
+  const char* last = buffer.data() + buffer.size();
+  std::vector<address> buffer_addrs(strs.size());
+  std::size_t count = 0;
+  while (first != last)
+  {
+    std::uint64_t buffer_status[2];
+    parse_addresses_result r = parse_addresses(first, last, '\n',
+        &buffer_addrs[count], 70, buffer_status);
+    STDNET_CHECK(r.count == 70 || r.ptr == last);
+    for (std::size_t i = 0; i < r.count; ++i)
+      STDNET_CHECK(status_bit(buffer_status, i)
+          == status_bit(&status[0], count + i));
+    count += r.count;
+    first = r.ptr;
+  }
+  STDNET_CHECK(count == strs.size());
+  STDNET_CHECK(buffer_addrs == addrs);
+
+  // Empty strings between delimiters keep their places.
+  const char fields[] = "1.2.3.4,,5.6.7.8,";
+  address_v4 field_addrs[3];
+  std::uint64_t field_status;
+  parse_addresses_result r = parse_addresses(fields,
+      fields + sizeof(fields) - 1, ',', field_addrs, 10, &field_status);
+  STDNET_CHECK(r.count == 3);
+  STDNET_CHECK(r.valid == 2);
+  STDNET_CHECK(r.ptr == fields + sizeof(fields) - 1);
+  STDNET_CHECK(field_status == 5);
+  STDNET_CHECK(field_addrs[2] == make_address_v4(0x05060708));
+
+  // A CRLF buffer whose last line has a carriage return but no newline.
+  const char lines[] = "1.2.3.4\r\n5.6.7.8\r";
+  address_v4 line_addrs[2];
+  std::uint64_t line_status;
+  r = parse_addresses(lines, lines + sizeof(lines) - 1, '\n', line_addrs, 10,
+      &line_status);
+  STDNET_CHECK(r.count == 2);
+  STDNET_CHECK(r.valid == 2);
+  STDNET_CHECK(line_status == 3);
+  STDNET_CHECK(line_addrs[1] == make_address_v4(0x05060708));
+}
+
+} // namespace ip_parse_addresses_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/parse_addresses",
+  STDNET_TEST_CASE(ip_parse_addresses_compile::test)
+  STDNET_TEST_CASE(ip_parse_addresses_runtime::test)
+)
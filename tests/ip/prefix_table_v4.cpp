@@ -0,0 +1,226 @@
+//
+// prefix_table_v4.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/prefix_table_v4.hpp"
+
+#include "../unit_test.hpp"
+#include <cstdlib>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_v4_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::prefix_table_v4 compile and link correctly. Runtime failures are ignored.
+
+namespace ip_prefix_table_v4_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    ip::prefix_table_v4 table;
+
+    table.insert(ip::address_v4(0x0A000000), 8, 1);
+
+    bool b = table.erase(ip::address_v4(0x0A000000), 8);
+    (void)b;
+
+    std::size_t size = table.size();
+    (void)size;
+
+    ip::prefix_table_v4::value_type value =
+      table.lookup(ip::address_v4(0x0A000001));
+    (void)value;
+
+    ip::address_v4 addrs[2];
+    ip::prefix_table_v4::value_type values[2];
+    table.lookup(addrs, 2, values);
+
+    table.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_prefix_table_v4_compile
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_v4_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups find the longest matching prefix as
+// prefixes are added and removed, by comparing with a linear search.
+
+namespace ip_prefix_table_v4_runtime {
+
+struct route
+{
+  unsigned long prefix;
+  unsigned int length;
+  unsigned long value;
+};
+
+unsigned long mask(unsigned long a, unsigned int length)
+{
+  return length == 0 ? 0 : a & (0xFFFFFFFFUL << (32 - length));
+}
+
+unsigned long linear_lookup(const std::vector<route>& routes, unsigned long a)
+{
+  unsigned long value = 0xFFFFFFFF;
+  int best = -1;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    if (static_cast<int>(routes[i].length) > best
+        && mask(a, routes[i].length) == routes[i].prefix)
+    {
+      best = routes[i].length;
+      value = routes[i].value;
+    }
+  }
+  return value;
+}
+
+void test()
+{
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::prefix_table_v4;
+
+  prefix_table_v4 table;
+  STDNET_CHECK(table.size() == 0);
+  const prefix_table_v4::value_type no_value = prefix_table_v4::no_value;
+  STDNET_CHECK(table.lookup(address_v4(0x0A000001)) == no_value);
+
+  table.insert(address_v4(0x0A000000), 8, 1);
+  table.insert(address_v4(0x0A010000), 16, 2);
+  table.insert(address_v4(0x0A010180), 25, 3);
+  table.insert(address_v4(0x0A010181), 32, 4);
+  STDNET_CHECK(table.size() == 4);
+  STDNET_CHECK(table.lookup(address_v4(0x0A020304)) == 1);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010203)) == 2);
+  STDNET_CHECK(table.lookup(address_v4(0x0A01017F)) == 2);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010180)) == 3);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010181)) == 4);
+  STDNET_CHECK(table.lookup(address_v4(0x0B000000)) == no_value);
+
+  // Host bits are ignored, and inserting an existing prefix replaces it.
+  table.insert(address_v4(0x0A0101FF), 25, 5);
+  STDNET_CHECK(table.size() == 4);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010180)) == 5);
+
+  // Removing a prefix exposes the next longest one.
+  STDNET_CHECK(table.erase(address_v4(0x0A010000), 16));
+  STDNET_CHECK(!table.erase(address_v4(0x0A010000), 16));
+  STDNET_CHECK(table.lookup(address_v4(0x0A010203)) == 1);
+  STDNET_CHECK(table.erase(address_v4(0x0A010180), 25));
+  STDNET_CHECK(table.lookup(address_v4(0x0A010180)) == 1);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010181)) == 4);
+
+  table.insert(address_v4(0), 0, 0);
+  STDNET_CHECK(table.lookup(address_v4(0xC0000201)) == 0);
+
+  bool caught = false;
+  try
+  {
+    table.insert(address_v4(0), 33, 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  caught = false;
+  try
+  {
+    table.insert(address_v4(0), 8, prefix_table_v4::max_value + 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  table.clear();
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(table.lookup(address_v4(0x0A010181)) == no_value);
+
+  // Random prefixes, concentrated in a /12 so that they overlap, are added and
+  // removed, and lookups are compared with a linear search after each step.
+  std::srand(42);
+  std::vector<route> routes;
+  for (int step = 0; step < 400; ++step)
+  {
+    if (routes.empty() || std::rand() % 3 != 0)
+    {
+      route r;
+      r.length = 12 + std::rand() % 21;
+      r.prefix = mask(0xAC100000UL | ((static_cast<unsigned long>(std::rand())
+              << 8) & 0x000FFFFF) | (std::rand() & 0xFF), r.length);
+      r.value = std::rand() % 1000;
+      bool replaced = false;
+      for (std::size_t i = 0; i < routes.size(); ++i)
+      {
+        if (routes[i].prefix == r.prefix && routes[i].length == r.length)
+        {
+          routes[i].value = r.value;
+          replaced = true;
+        }
+      }
+      if (!replaced)
+        routes.push_back(r);
+      table.insert(address_v4(r.prefix), r.length, r.value);
+    }
+    else
+    {
+      const std::size_t i = std::rand() % routes.size();
+      STDNET_CHECK(table.erase(address_v4(routes[i].prefix), routes[i].length));
+      routes.erase(routes.begin() + i);
+    }
+
+    STDNET_CHECK(table.size() == routes.size());
+
+    std::vector<address_v4> addrs;
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+      addrs.push_back(address_v4(routes[i].prefix));
+      addrs.push_back(address_v4(routes[i].prefix
+            | (0xFFFFFFFFUL >> routes[i].length)));
+    }
+    for (int i = 0; i < 50; ++i)
+      addrs.push_back(address_v4(0xAC100000UL | (std::rand() & 0xFFFFF)));
+
+    std::vector<prefix_table_v4::value_type> values(addrs.size());
+    table.lookup(addrs.data(), addrs.size(), values.data());
+    for (std::size_t i = 0; i < addrs.size(); ++i)
+    {
+      const unsigned long expected = linear_lookup(routes, addrs[i].to_ulong());
+      STDNET_CHECK(table.lookup(addrs[i]) == expected);
+      STDNET_CHECK(values[i] == expected);
+    }
+  }
+}
+
+} // namespace ip_prefix_table_v4_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/prefix_table_v4",
+  STDNET_TEST_CASE(ip_prefix_table_v4_compile::test)
+  STDNET_TEST_CASE(ip_prefix_table_v4_runtime::test)
+)
@@ -0,0 +1,253 @@
+//
+// prefix_table_v6.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/ip/prefix_table_v6.hpp"
+
+#include "../unit_test.hpp"
+#include <cstdlib>
+#include <vector>
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_v6_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// ip::prefix_table_v6 compile and link correctly. Runtime failures are ignored.
+
+namespace ip_prefix_table_v6_compile {
+
+void test()
+{
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    ip::prefix_table_v6 table;
+
+    table.insert(ip::address_v6::loopback(), 128, 1);
+
+    bool b = table.erase(ip::address_v6::loopback(), 128);
+    (void)b;
+
+    std::size_t size = table.size();
+    (void)size;
+
+    ip::prefix_table_v6::value_type value =
+      table.lookup(ip::address_v6::loopback());
+    value = table.lookup(ip::compact_address_v6());
+    (void)value;
+
+    ip::compact_address_v6 addrs[2];
+    ip::prefix_table_v6::value_type values[2];
+    table.lookup(addrs, 2, values);
+
+    table.clear();
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace ip_prefix_table_v6_compile
+
+//------------------------------------------------------------------------------
+
+// ip_prefix_table_v6_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that lookups find the longest matching prefix as
+// prefixes are added and removed, by comparing with a linear search.
+
+namespace ip_prefix_table_v6_runtime {
+
+using std::experimental::net::ip::address_v6;
+using std::experimental::net::ip::compact_address_v6;
+using std::experimental::net::ip::prefix_table_v6;
+
+struct route
+{
+  address_v6::bytes_type prefix;
+  unsigned int length;
+  unsigned long value;
+};
+
+address_v6::bytes_type mask(address_v6::bytes_type bytes, unsigned int length)
+{
+  for (unsigned int i = 0; i < 16; ++i)
+  {
+    if (length >= 8 * (i + 1))
+      continue;
+    if (length <= 8 * i)
+      bytes[i] = 0;
+    else
+      bytes[i] &= static_cast<unsigned char>(0xFF << (8 * (i + 1) - length));
+  }
+  return bytes;
+}
+
+unsigned long linear_lookup(const std::vector<route>& routes,
+    const address_v6::bytes_type& bytes)
+{
+  unsigned long value = 0xFFFFFFFF;
+  int best = -1;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    if (static_cast<int>(routes[i].length) > best
+        && mask(bytes, routes[i].length) == routes[i].prefix)
+    {
+      best = routes[i].length;
+      value = routes[i].value;
+    }
+  }
+  return value;
+}
+
+address_v6::bytes_type random_bytes()
+{
+  // Addresses share the first 28 bits, and otherwise most variation is in
+  // the first 64 bits, so that prefixes overlap at every depth.
+  address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb0);
+  bytes[3] |= std::rand() & 0x0F;
+  for (std::size_t i = 4; i < 16; ++i)
+    bytes[i] = static_cast<unsigned char>(i < 8 ? std::rand() & 0x3 : 0);
+  bytes[15] = static_cast<unsigned char>(std::rand());
+  return bytes;
+}
+
+void test()
+{
+  prefix_table_v6 table;
+  const prefix_table_v6::value_type no_value = prefix_table_v6::no_value;
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(table.lookup(address_v6::loopback()) == no_value);
+
+  const address_v6::bytes_type doc(0x20, 0x01, 0x0d, 0xb8);
+  address_v6::bytes_type host = doc;
+  host[15] = 1;
+  table.insert(address_v6(doc), 32, 1);
+  table.insert(address_v6(host), 64, 2);
+  table.insert(address_v6(host), 127, 3);
+  table.insert(address_v6(host), 128, 4);
+  STDNET_CHECK(table.size() == 4);
+
+  address_v6::bytes_type a = doc;
+  a[4] = 1;
+  STDNET_CHECK(table.lookup(address_v6(a)) == 1);
+  a = doc;
+  a[12] = 1;
+  STDNET_CHECK(table.lookup(address_v6(a)) == 2);
+  a = host;
+  a[15] = 0;
+  STDNET_CHECK(table.lookup(address_v6(a)) == 3);
+  STDNET_CHECK(table.lookup(address_v6(host)) == 4);
+  STDNET_CHECK(table.lookup(compact_address_v6(host)) == 4);
+  STDNET_CHECK(table.lookup(address_v6(host, 3)) == 4);
+  STDNET_CHECK(table.lookup(address_v6::loopback()) == no_value);
+
+  // Removing a prefix exposes the next longest one.
+  STDNET_CHECK(table.erase(address_v6(host), 128));
+  STDNET_CHECK(!table.erase(address_v6(host), 128));
+  STDNET_CHECK(table.lookup(address_v6(host)) == 3);
+  STDNET_CHECK(table.erase(address_v6(doc), 64));
+  a = doc;
+  a[12] = 1;
+  STDNET_CHECK(table.lookup(address_v6(a)) == 1);
+
+  table.insert(address_v6(), 0, 0);
+  STDNET_CHECK(table.lookup(address_v6::loopback()) == 0);
+  STDNET_CHECK(table.lookup(address_v6(host)) == 3);
+
+  bool caught = false;
+  try
+  {
+    table.insert(address_v6(), 129, 1);
+  }
+  catch (std::out_of_range&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+
+  table.clear();
+  STDNET_CHECK(table.size() == 0);
+  STDNET_CHECK(table.lookup(address_v6(host)) == no_value);
+
+  // Random prefixes are added and removed, and lookups are compared with a
+  // linear search after each step.
+  std::srand(42);
+  std::vector<route> routes;
+  for (int step = 0; step < 300; ++step)
+  {
+    if (routes.empty() || std::rand() % 3 != 0)
+    {
+      route r;
+      const int kind = std::rand() % 4;
+      r.length = kind == 0 ? std::rand() % 17
+        : kind == 1 ? 17 + std::rand() % 48
+        : kind == 2 ? 64 : 65 + std::rand() % 64;
+      r.prefix = mask(random_bytes(), r.length);
+      r.value = std::rand() % 1000;
+      bool replaced = false;
+      for (std::size_t i = 0; i < routes.size(); ++i)
+      {
+        if (routes[i].prefix == r.prefix && routes[i].length == r.length)
+        {
+          routes[i].value = r.value;
+          replaced = true;
+        }
+      }
+      if (!replaced)
+        routes.push_back(r);
+      table.insert(address_v6(r.prefix), r.length, r.value);
+    }
+    else
+    {
+      const std::size_t i = std::rand() % routes.size();
+      STDNET_CHECK(table.erase(address_v6(routes[i].prefix),
+            routes[i].length));
+      routes.erase(routes.begin() + i);
+    }
+
+    STDNET_CHECK(table.size() == routes.size());
+
+    std::vector<compact_address_v6> addrs;
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+      addrs.push_back(compact_address_v6(routes[i].prefix));
+      address_v6::bytes_type last = routes[i].prefix;
+      for (unsigned int bit = routes[i].length; bit < 128; ++bit)
+        last[bit / 8] |= static_cast<unsigned char>(0x80 >> (bit % 8));
+      addrs.push_back(compact_address_v6(last));
+    }
+    for (int i = 0; i < 50; ++i)
+      addrs.push_back(compact_address_v6(random_bytes()));
+
+    std::vector<prefix_table_v6::value_type> values(addrs.size());
+    table.lookup(addrs.data(), addrs.size(), values.data());
+    for (std::size_t i = 0; i < addrs.size(); ++i)
+    {
+      const unsigned long expected =
+        linear_lookup(routes, addrs[i].to_bytes());
+      STDNET_CHECK(table.lookup(addrs[i].to_address_v6()) == expected);
+      STDNET_CHECK(values[i] == expected);
+    }
+  }
+}
+
+} // namespace ip_prefix_table_v6_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "ip/prefix_table_v6",
+  STDNET_TEST_CASE(ip_prefix_table_v6_compile::test)
+  STDNET_TEST_CASE(ip_prefix_table_v6_runtime::test)
+)
@@ -0,0 +1,211 @@
+//
+// literals.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include "std/net/literals.hpp"
+
+#include "unit_test.hpp"
+#include <cstring>
+#include <system_error>
+
+//------------------------------------------------------------------------------
+
+// literals_compile test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all of the literal operators compile and
+// link correctly. Runtime failures are ignored.
+
+namespace literals_compile {
+
+void test()
+{
+  using namespace std::experimental::literals;
+  namespace ip = std::experimental::net::ip;
+
+  try
+  {
+    ip::address addr1 = "127.0.0.1"_ip;
+    ip::address addr2 = "::1"_ip;
+    ip::address_v4 addr3 = "127.0.0.1"_ipv4;
+    ip::address_v6 addr4 = "::1"_ipv6;
+    (void)addr1;
+    (void)addr2;
+    (void)addr3;
+    (void)addr4;
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace literals_compile
+
+//------------------------------------------------------------------------------
+
+// literals_constexpr test
+// ~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that literals are parsed at compile time, so that
+// tables of them are constant.
+
+namespace literals_constexpr {
+
+#if defined(STDNET_HAS_CONSTEXPR)
+
+using namespace std::experimental::literals;
+namespace ip = std::experimental::net::ip;
+
+constexpr ip::address_v4 acl_v4[] =
+{
+  "10.0.0.1"_ipv4, "192.168.100.200"_ipv4, "0.0.0.0"_ipv4,
+  "255.255.255.255"_ipv4
+};
+static_assert(acl_v4[0].to_ulong() == 0x0A000001, "10.0.0.1");
+static_assert(acl_v4[1].to_ulong() == 0xC0A864C8, "192.168.100.200");
+static_assert(acl_v4[2].is_unspecified(), "0.0.0.0");
+static_assert(acl_v4[3].to_ulong() == 0xFFFFFFFF, "255.255.255.255");
+
+constexpr ip::address_v6 acl_v6[] =
+{
+  "::"_ipv6, "::1"_ipv6, "fe80::1%3"_ipv6, "ff02::1"_ipv6,
+  "2001:DB8:0:0:1:0:0:1"_ipv6, "::ffff:10.0.0.1"_ipv6
+};
+static_assert(acl_v6[0].is_unspecified(), "::");
+static_assert(acl_v6[1].is_loopback(), "::1");
+static_assert(acl_v6[2].is_link_local(), "fe80::1%3");
+static_assert(acl_v6[2].scope_id() == 3, "fe80::1%3 scope");
+static_assert(acl_v6[3].is_multicast_link_local(), "ff02::1");
+static_assert(!acl_v6[4].is_multicast(), "2001:DB8:0:0:1:0:0:1");
+static_assert(acl_v6[5].is_v4_mapped(), "::ffff:10.0.0.1");
+
+constexpr ip::address acl[] = { "127.0.0.1"_ip, "::1"_ip, "1::"_ip };
+static_assert(acl[0].is_v4() && acl[0].is_loopback(), "127.0.0.1");
+static_assert(acl[1].is_v6() && acl[1].is_loopback(), "::1");
+static_assert(acl[2].is_v6() && !acl[2].is_unspecified(), "1::");
+
+#endif // defined(STDNET_HAS_CONSTEXPR)
+
+void test()
+{
+#if defined(STDNET_HAS_CONSTEXPR)
+  // The values are those given by the run-time parser.
+  const char* text_v4[] =
+  {
+    "10.0.0.1", "192.168.100.200", "0.0.0.0", "255.255.255.255"
+  };
+  for (std::size_t i = 0; i < 4; ++i)
+    STDNET_CHECK(acl_v4[i] == ip::make_address_v4(text_v4[i]));
+
+  const char* text_v6[] =
+  {
+    "::", "::1", "fe80::1%3", "ff02::1", "2001:DB8:0:0:1:0:0:1",
+    "::ffff:10.0.0.1"
+  };
+  for (std::size_t i = 0; i < 6; ++i)
+    STDNET_CHECK(acl_v6[i] == ip::make_address_v6(text_v6[i]));
+#endif // defined(STDNET_HAS_CONSTEXPR)
+}
+
+} // namespace literals_constexpr
+
+//------------------------------------------------------------------------------
+
+// literals_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that each literal gives the same address as the
+// run-time parser, for valid and invalid text alike.
+
+namespace literals_runtime {
+
+void test()
+{
+  using std::experimental::net::ip::address;
+  using std::experimental::net::ip::address_v4;
+  using std::experimental::net::ip::address_v6;
+  using std::experimental::net::ip::make_address;
+  using std::experimental::net::ip::make_address_v4;
+  using std::experimental::net::ip::make_address_v6;
+  namespace literal_ops = std::experimental::net::detail::literal_ops;
+
+  const char* samples[] =
+  {
+    "1.2.3.4", "255.255.255.255", "0.0.0.0", "256.1.1.1", "1.2.3", "01.2.3.4",
+    "1.2.3.4.", "", "1..2.3", "1.2.3.4 ", "::", "::1", "1::", "1:2:3:4:5:6:7:8",
+    "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8",
+    "1:2:3:4:5:6:7:8::", ":::", "1:::2", ":1::2", "1:2", "12345::1",
+    "::ffff:1.2.3.4", "1:2:3:4:5:6:1.2.3.4", "1:2:3:4:5:6:7:1.2.3.4",
+    "1:2:3:4:5::1.2.3.4", "1:2:3:4:5:6::1.2.3.4", "::1.2.3.4:5",
+    "::256.1.1.1", "fe80::1%", "fe80::1%12", "fe80::1%1a", "2001:db8::g",
+    "1.2.3.4:80", "::ffff:01.2.3.4"
+  };
+
+  for (std::size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); ++i)
+  {
+    const char* str = samples[i];
+    const std::size_t len = std::strlen(str);
+
+    std::error_code ec;
+    address_v4 addr4 = make_address_v4(str, len, ec);
+    literal_ops::v4_result r4 = literal_ops::parse_v4(str, len);
+    STDNET_CHECK(r4.ok == !ec);
+    STDNET_CHECK(!r4.ok || make_address_v4(r4.value) == addr4);
+    STDNET_CHECK(!r4.ok
+        || literal_ops::make_v4(r4, str, len) == addr4);
+
+    // A zone ID that is not numeric is left to the run-time parser.
+    address_v6 addr6 = make_address_v6(str, len, ec);
+    literal_ops::v6_result r6 = literal_ops::parse_v6(str, len);
+    const bool named_zone = std::strcmp(str, "fe80::1%1a") == 0;
+    STDNET_CHECK(r6.ok == (!ec && !named_zone));
+    STDNET_CHECK(!r6.ok || literal_ops::make_v6(r6, str, len) == addr6);
+
+    // The family is chosen as for make_address.
+    address addr = make_address(str, len, ec);
+    STDNET_CHECK(ec || literal_ops::is_v6(str, len) == addr.is_v6());
+  }
+
+  // At run time, text that is not a constant falls back to make_address_v6.
+  using namespace std::experimental::literals;
+  STDNET_CHECK("::1"_ipv6 == address_v6::loopback());
+  STDNET_CHECK("127.0.0.1"_ip == address(address_v4::loopback()));
+
+  // A zone ID that names an interface is looked up at run time, in every
+  // language mode.
+  std::error_code ec;
+  address_v6 named = make_address_v6("fe80::1%lo", ec);
+  if (!ec)
+  {
+    STDNET_CHECK("fe80::1%lo"_ipv6 == named);
+    STDNET_CHECK("fe80::1%lo"_ip == address(named));
+  }
+
+  bool caught = false;
+  try
+  {
+    address_v6 addr6 = "1:::2"_ipv6;
+    (void)addr6;
+  }
+  catch (std::system_error&)
+  {
+    caught = true;
+  }
+  STDNET_CHECK(caught);
+}
+
+} // namespace literals_runtime
+
+//------------------------------------------------------------------------------
+
+STDNET_TEST_SUITE
+(
+  "literals",
+  STDNET_TEST_CASE(literals_compile::test)
+  STDNET_TEST_CASE(literals_constexpr::test)
+  STDNET_TEST_CASE(literals_runtime::test)
+)
@@ -0,0 +1,119 @@
+//
+// address_cache.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares make_address with address_cache of several capacities, replaying
+// streams of strings drawn from a Zipf distribution over a corpus that is
+// mostly IPv4 and over one that is all IPv6.
+
+#include "std/net/ip/address.hpp"
+#include "std/net/ip/address_cache.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+const std::size_t corpus_size = 1 << 16;
+const std::size_t stream_size = 1 << 22;
+
+// Build a corpus in which one string in every v6_ratio is an IPv6 address.
+std::vector<std::string> make_corpus(std::mt19937& rng, unsigned v6_ratio)
+{
+  std::vector<std::string> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    char buffer[48];
+    if (rng() % v6_ratio != 0)
+      std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u",
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256));
+    else
+      std::snprintf(buffer, sizeof(buffer), "2001:db8:%x:%x::%x:%x",
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536));
+    corpus.push_back(buffer);
+  }
+  return corpus;
+}
+
+// Draw a stream from the corpus, in which the k-th string appears with
+// probability proportional to 1 / k.
+std::vector<const std::string*> make_stream(std::mt19937& rng,
+    const std::vector<std::string>& corpus)
+{
+  std::vector<double> cdf(corpus.size());
+  double total = 0;
+  for (std::size_t i = 0; i < corpus.size(); ++i)
+    cdf[i] = total += 1.0 / static_cast<double>(i + 1);
+
+  std::uniform_real_distribution<double> uniform(0, total);
+  std::vector<const std::string*> stream(stream_size);
+  for (std::size_t i = 0; i < stream_size; ++i)
+  {
+    std::size_t k = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng))
+      - cdf.begin();
+    stream[i] = &corpus[k < corpus.size() ? k : corpus.size() - 1];
+  }
+  return stream;
+}
+
+void run(const char* corpus_name,
+    const std::vector<const std::string*>& stream)
+{
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s, make_address", corpus_name);
+  benchmark_run(name, stream_size,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        ip::address a = ip::make_address(
+            stream[i]->data(), stream[i]->size(), ec);
+        benchmark_sink(a);
+      });
+
+  const std::size_t capacities[] = { 256, 4096, 65536 };
+  for (std::size_t c = 0; c < 3; ++c)
+  {
+    ip::address_cache cache(capacities[c]);
+    std::snprintf(name, sizeof(name), "%s, address_cache(%u)", corpus_name,
+        static_cast<unsigned>(capacities[c]));
+    benchmark_run(name, stream_size,
+        [&](std::size_t i)
+        {
+          std::error_code ec;
+          ip::address a = cache.make_address(
+              stream[i]->data(), stream[i]->size(), ec);
+          benchmark_sink(a);
+        });
+    std::printf("%-40s %10.1f %%\n", "  hit rate", 100.0 * cache.hits()
+        / static_cast<double>(cache.hits() + cache.misses()));
+  }
+}
+
+int main()
+{
+  std::mt19937 rng(42);
+
+  std::vector<std::string> mixed = make_corpus(rng, 10);
+  run("mixed", make_stream(rng, mixed));
+
+  std::vector<std::string> v6 = make_corpus(rng, 1);
+  run("IPv6", make_stream(rng, v6));
+
+  return 0;
+}
@@ -0,0 +1,42 @@
+//
+// benchmark.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Prevents the compiler from discarding a computed result.
+template <typename T>
+inline void benchmark_sink(const T& value)
+{
+  static volatile unsigned char sink;
+  sink = sink + *reinterpret_cast<const volatile unsigned char*>(&value);
+}
+
+// Runs a function the specified number of times and prints the average cost
+// of each call in nanoseconds.
+template <typename Function>
+double benchmark_run(const char* name, std::size_t iterations, Function f)
+{
+  typedef std::chrono::steady_clock clock;
+  clock::time_point start = clock::now();
+  for (std::size_t i = 0; i < iterations; ++i)
+    f(i);
+  clock::duration elapsed = clock::now() - start;
+  double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+  double per_op = ns / static_cast<double>(iterations);
+  std::printf("%-40s %10.2f ns/op\n", name, per_op);
+  return per_op;
+}
+
+#endif // BENCHMARK_HPP
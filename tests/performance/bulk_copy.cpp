@@ -0,0 +1,81 @@
+//
+// bulk_copy.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures vector growth and bulk copies of addresses, which use memmove now
+// that the address types are trivially copyable. Each address type is compared
+// with a wrapper that has a user-provided copy constructor and assignment
+// operator, as the address types did before.
+
+#include "std/net/ip/address.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+template <typename Address>
+struct user_copied
+{
+  user_copied(const Address& a) : addr(a) {}
+  user_copied(const user_copied& other) : addr(other.addr) {}
+  user_copied& operator=(const user_copied& other)
+  {
+    addr = other.addr;
+    return *this;
+  }
+
+  Address addr;
+};
+
+template <typename T>
+void run(const char* grow_name, const char* copy_name, const T& value)
+{
+  const std::size_t count = 1 << 12;
+  const std::size_t rounds = 8192;
+
+  // Each iteration grows a vector one element at a time, reallocating as it
+  // goes, so the reported cost includes the moves made by each reallocation.
+  benchmark_run(grow_name, rounds,
+      [&](std::size_t)
+      {
+        std::vector<T> v;
+        for (std::size_t i = 0; i < count; ++i)
+          v.push_back(value);
+        benchmark_sink(v.back());
+      });
+
+  const std::vector<T> source(count, value);
+  std::vector<T> target(count, value);
+  benchmark_run(copy_name, rounds,
+      [&](std::size_t)
+      {
+        std::copy(source.begin(), source.end(), target.begin());
+        benchmark_sink(target.back());
+      });
+}
+
+int main()
+{
+  const ip::address_v4 v4(0x0a000001);
+  const ip::address_v6 v6(ip::address_v6::bytes_type(0x20, 0x01, 0x0d, 0xb8,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1));
+
+  run("address_v4 grow, user copy", "address_v4 copy, user copy",
+      user_copied<ip::address_v4>(v4));
+  run("address_v4 grow", "address_v4 copy", v4);
+  run("address_v6 grow, user copy", "address_v6 copy, user copy",
+      user_copied<ip::address_v6>(v6));
+  run("address_v6 grow", "address_v6 copy", v6);
+  run("address grow, user copy", "address copy, user copy",
+      user_copied<ip::address>(ip::address(v6)));
+  run("address grow", "address copy", ip::address(v6));
+
+  return 0;
+}
@@ -0,0 +1,197 @@
+//
+// concurrent_lpm.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures lookup throughput with increasing numbers of reader threads while
+// another thread updates the table, for concurrent_prefix_table_v4 and for a
+// prefix_table_v4 behind a reader-writer lock.
+
+#include "std/net/ip/concurrent_prefix_table_v4.hpp"
+#include "std/net/ip/prefix_table_v4.hpp"
+#include "benchmark.hpp"
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+const std::size_t prefix_count = 500000;
+const std::size_t address_count = 1 << 20;
+const std::size_t batch_size = 64;
+const int run_ms = 1000;
+const int updates_per_second = 1000;
+
+struct route
+{
+  ip::address_v4 prefix;
+  unsigned int length;
+};
+
+// Routes with a length distribution similar to a full BGP table.
+std::vector<route> make_routes(std::mt19937& rng)
+{
+  std::vector<route> routes(prefix_count);
+  for (std::size_t i = 0; i < prefix_count; ++i)
+  {
+    const unsigned int r = rng() % 100;
+    routes[i].length = r < 60 ? 24 : r < 90 ? 16 + rng() % 8
+      : r < 95 ? 8 + rng() % 8 : 25 + rng() % 8;
+    routes[i].prefix = ip::address_v4(
+        rng() & (0xFFFFFFFFUL << (32 - routes[i].length)));
+  }
+  return routes;
+}
+
+class locked_table
+{
+public:
+  locked_table()
+  {
+    pthread_rwlock_init(&lock_, 0);
+  }
+
+  ~locked_table()
+  {
+    pthread_rwlock_destroy(&lock_);
+  }
+
+  void insert(const ip::address_v4& addr, unsigned int length,
+      ip::prefix_table_v4::value_type value)
+  {
+    pthread_rwlock_wrlock(&lock_);
+    table_.insert(addr, length, value);
+    pthread_rwlock_unlock(&lock_);
+  }
+
+  void erase(const ip::address_v4& addr, unsigned int length)
+  {
+    pthread_rwlock_wrlock(&lock_);
+    table_.erase(addr, length);
+    pthread_rwlock_unlock(&lock_);
+  }
+
+  // Takes the lock for each batch of lookups.
+  class reader
+  {
+  public:
+    explicit reader(locked_table& table)
+      : table_(table)
+    {
+    }
+
+    void lookup(const ip::address_v4* addrs, std::size_t count,
+        ip::prefix_table_v4::value_type* values) const
+    {
+      pthread_rwlock_rdlock(&table_.lock_);
+      for (std::size_t i = 0; i < count; ++i)
+        values[i] = table_.table_.lookup(addrs[i]);
+      pthread_rwlock_unlock(&table_.lock_);
+    }
+
+  private:
+    locked_table& table_;
+  };
+
+private:
+  ip::prefix_table_v4 table_;
+  pthread_rwlock_t lock_;
+};
+
+// Runs the given number of readers, each looking up batches of addresses,
+// while the calling thread removes and reinserts routes. Returns the total
+// number of lookups per second.
+template <typename Table>
+double run(Table& table, const std::vector<route>& routes,
+    const std::vector<ip::address_v4>& addrs, int readers)
+{
+  std::atomic<bool> done(false);
+  std::vector<std::size_t> counts(readers * 16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < readers; ++t)
+  {
+    threads.push_back(std::thread(
+          [&, t]()
+          {
+            const typename Table::reader reader(table);
+            std::vector<ip::prefix_table_v4::value_type> values(batch_size);
+            std::size_t count = 0;
+            std::size_t i = (t * address_count / readers) & ~(batch_size - 1);
+            while (!done.load(std::memory_order_relaxed))
+            {
+              reader.lookup(&addrs[i], batch_size, &values[0]);
+              count += batch_size;
+              i = (i + batch_size) % address_count;
+            }
+            benchmark_sink(values[0]);
+            counts[t * 16] = count;
+          }));
+  }
+
+  typedef std::chrono::steady_clock clock;
+  const clock::time_point start = clock::now();
+  const clock::duration interval =
+    std::chrono::microseconds(1000000 / updates_per_second);
+  clock::time_point next = start;
+  for (std::size_t u = 0; clock::now() - start
+      < std::chrono::milliseconds(run_ms); ++u)
+  {
+    const route& r = routes[u % routes.size()];
+    table.erase(r.prefix, r.length);
+    table.insert(r.prefix, r.length, u & 0xFFFF);
+    next += interval;
+    std::this_thread::sleep_until(next);
+  }
+  done.store(true);
+  const clock::duration elapsed = clock::now() - start;
+
+  std::size_t total = 0;
+  for (int t = 0; t < readers; ++t)
+  {
+    threads[t].join();
+    total += counts[t * 16];
+  }
+  return total / std::chrono::duration<double>(elapsed).count();
+}
+
+int main()
+{
+  std::mt19937 rng(42);
+  const std::vector<route> routes = make_routes(rng);
+
+  std::vector<ip::address_v4> addrs(address_count);
+  for (std::size_t i = 0; i < address_count; ++i)
+  {
+    const route& r = routes[rng() % routes.size()];
+    addrs[i] = ip::address_v4(r.prefix.to_ulong()
+        | (r.length == 32 ? 0 : rng() & (0xFFFFFFFFUL >> r.length)));
+  }
+
+  ip::concurrent_prefix_table_v4 concurrent;
+  locked_table locked;
+  for (std::size_t i = 0; i < routes.size(); ++i)
+  {
+    concurrent.insert(routes[i].prefix, routes[i].length, i & 0xFFFF);
+    locked.insert(routes[i].prefix, routes[i].length, i & 0xFFFF);
+  }
+
+  const int max_readers =
+    std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int readers = 1; readers <= max_readers; readers *= 2)
+  {
+    const double concurrent_rate = run(concurrent, routes, addrs, readers);
+    const double locked_rate = run(locked, routes, addrs, readers);
+    std::printf("%2d readers: %10.1f M/s concurrent %10.1f M/s locked\n",
+        readers, concurrent_rate / 1e6, locked_rate / 1e6);
+  }
+
+  return 0;
+}
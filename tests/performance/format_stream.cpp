@@ -0,0 +1,92 @@
+//
+// format_stream.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares stream insertion of addresses with the to_string and per-character
+// widening that operator<< previously used.
+
+#include "std/net/ip/address.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+template <typename Stream>
+void write_per_character(Stream& os, const ip::address& addr)
+{
+  std::string s = addr.to_string();
+  for (std::string::iterator i = s.begin(); i != s.end(); ++i)
+    os << os.widen(*i);
+}
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 22;
+
+  std::mt19937 rng(42);
+  std::vector<ip::address> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      corpus.push_back(ip::address_v4(static_cast<unsigned long>(rng())));
+    }
+    else
+    {
+      ip::address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+      for (std::size_t j = 8; j < 16; ++j)
+        bytes[j] = static_cast<unsigned char>(rng());
+      corpus.push_back(ip::address_v6(bytes));
+    }
+  }
+
+  std::ostringstream os;
+  std::wostringstream wos;
+
+  benchmark_run("per-character ostream", iterations,
+      [&](std::size_t i)
+      {
+        if ((i & (corpus_size - 1)) == 0)
+          os.str(std::string());
+        write_per_character(os, corpus[i & (corpus_size - 1)]);
+      });
+
+  benchmark_run("operator<< ostream", iterations,
+      [&](std::size_t i)
+      {
+        if ((i & (corpus_size - 1)) == 0)
+          os.str(std::string());
+        os << corpus[i & (corpus_size - 1)];
+      });
+
+  benchmark_run("per-character wostream", iterations,
+      [&](std::size_t i)
+      {
+        if ((i & (corpus_size - 1)) == 0)
+          wos.str(std::wstring());
+        write_per_character(wos, corpus[i & (corpus_size - 1)]);
+      });
+
+  benchmark_run("operator<< wostream", iterations,
+      [&](std::size_t i)
+      {
+        if ((i & (corpus_size - 1)) == 0)
+          wos.str(std::wstring());
+        wos << corpus[i & (corpus_size - 1)];
+      });
+
+  benchmark_sink(os);
+  benchmark_sink(wos);
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+//
+// format_v4.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares to_chars for address_v4 with to_string and with the inet_ntop based
+// formatting that to_string previously used.
+
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/detail/socket_ops.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+namespace socket_ops = std::experimental::net::detail::socket_ops;
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 24;
+
+  std::mt19937 rng(42);
+  std::vector<ip::address_v4> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+    corpus.push_back(ip::address_v4(static_cast<unsigned long>(rng())));
+
+  benchmark_run("inet_ntop", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        char buffer[16];
+        ip::address_v4::bytes_type bytes =
+          corpus[i & (corpus_size - 1)].to_bytes();
+        socket_ops::inet_ntop(AF_INET, bytes.data(),
+            buffer, sizeof(buffer), 0, ec);
+        benchmark_sink(buffer);
+      });
+
+  benchmark_run("to_string", iterations,
+      [&](std::size_t i)
+      {
+        std::string s = corpus[i & (corpus_size - 1)].to_string();
+        benchmark_sink(s);
+      });
+
+  benchmark_run("to_chars", iterations,
+      [&](std::size_t i)
+      {
+        char buffer[16];
+        ip::to_chars_result r = ip::to_chars(buffer, buffer + sizeof(buffer),
+            corpus[i & (corpus_size - 1)]);
+        benchmark_sink(buffer);
+        benchmark_sink(r);
+      });
+
+  return 0;
+}
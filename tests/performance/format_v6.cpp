@@ -0,0 +1,71 @@
+//
+// format_v6.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares to_chars for address_v6 with to_string and with the inet_ntop based
+// formatting that to_string previously used.
+
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/detail/socket_ops.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+namespace socket_ops = std::experimental::net::detail::socket_ops;
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 24;
+
+  std::mt19937 rng(42);
+  std::vector<ip::address_v6> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    // Documentation prefix addresses with a random interface identifier, some
+    // of which have zero groups to be compressed.
+    ip::address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+    for (std::size_t j = 8; j < 16; ++j)
+      bytes[j] = (rng() % 4 == 0) ? 0 : static_cast<unsigned char>(rng());
+    corpus.push_back(ip::address_v6(bytes));
+  }
+
+  benchmark_run("inet_ntop", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        char buffer[80];
+        ip::address_v6::bytes_type bytes =
+          corpus[i & (corpus_size - 1)].to_bytes();
+        socket_ops::inet_ntop(AF_INET6, bytes.data(),
+            buffer, sizeof(buffer), 0, ec);
+        benchmark_sink(buffer);
+      });
+
+  benchmark_run("to_string", iterations,
+      [&](std::size_t i)
+      {
+        std::string s = corpus[i & (corpus_size - 1)].to_string();
+        benchmark_sink(s);
+      });
+
+  benchmark_run("to_chars", iterations,
+      [&](std::size_t i)
+      {
+        char buffer[80];
+        ip::to_chars_result r = ip::to_chars(buffer, buffer + sizeof(buffer),
+            corpus[i & (corpus_size - 1)]);
+        benchmark_sink(buffer);
+        benchmark_sink(r);
+      });
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+//
+// hash_lookup.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures unordered_map lookups keyed on each address type using std::hash,
+// alongside the byte-wise FNV-1a hasher that users previously had to supply.
+
+#include "std/net/ip/address.hpp"
+#include "std/net/ip/compact_address_v6.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+struct fnv1a_hash
+{
+  std::size_t operator()(const ip::address_v4& addr) const
+  {
+    return bytes(addr.to_bytes().data(), 4, 0);
+  }
+
+  std::size_t operator()(const ip::address_v6& addr) const
+  {
+    return bytes(addr.to_bytes().data(), 16, addr.scope_id());
+  }
+
+  std::size_t operator()(const ip::address& addr) const
+  {
+    if (addr.is_v4())
+      return (*this)(ip::address_cast<ip::address_v4>(addr));
+    return (*this)(ip::address_cast<ip::address_v6>(addr));
+  }
+
+  static std::size_t bytes(const unsigned char* p, std::size_t n,
+      unsigned long seed)
+  {
+    std::size_t h = static_cast<std::size_t>(14695981039346656037ULL) ^ seed;
+    for (std::size_t i = 0; i < n; ++i)
+      h = (h ^ p[i]) * static_cast<std::size_t>(1099511628211ULL);
+    return h;
+  }
+};
+
+template <typename Hash, typename Address>
+void run(const char* name, const std::vector<Address>& keys)
+{
+  const std::size_t iterations = 1 << 23;
+
+  std::unordered_map<Address, std::size_t, Hash> map;
+  for (std::size_t i = 0; i < keys.size(); ++i)
+    map[keys[i]] = i;
+
+  // Look up the keys in a scrambled order, so that successive lookups do not
+  // touch neighbouring buckets.
+  benchmark_run(name, iterations,
+      [&](std::size_t i)
+      {
+        const std::size_t key = (i * 2654435761u) & (keys.size() - 1);
+        benchmark_sink(map.find(keys[key])->second);
+      });
+}
+
+int main()
+{
+  const std::size_t key_count = 1 << 12;
+
+  std::mt19937 rng(42);
+  std::vector<ip::address_v4> v4_keys;
+  std::vector<ip::address_v6> v6_keys;
+  std::vector<ip::compact_address_v6> compact_keys;
+  std::vector<ip::address> keys;
+  for (std::size_t i = 0; i < key_count; ++i)
+  {
+    // Sequential host addresses within a few subnets, as in a flow table.
+    v4_keys.push_back(ip::address_v4(0x0a000000 + (rng() % 4) * 0x10000 + i));
+
+    ip::address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+    bytes[7] = static_cast<unsigned char>(rng() % 4);
+    bytes[14] = static_cast<unsigned char>(i >> 8);
+    bytes[15] = static_cast<unsigned char>(i);
+    v6_keys.push_back(ip::address_v6(bytes));
+    compact_keys.push_back(ip::compact_address_v6(bytes));
+
+    if (i % 2 == 0)
+      keys.push_back(v4_keys.back());
+    else
+      keys.push_back(v6_keys.back());
+  }
+
+  run<fnv1a_hash>("address_v4 fnv1a", v4_keys);
+  run<std::hash<ip::address_v4> >("address_v4 std::hash", v4_keys);
+  run<fnv1a_hash>("address_v6 fnv1a", v6_keys);
+  run<std::hash<ip::address_v6> >("address_v6 std::hash", v6_keys);
+  run<std::hash<ip::compact_address_v6> >(
+      "compact_address_v6 std::hash", compact_keys);
+  run<fnv1a_hash>("address fnv1a", keys);
+  run<std::hash<ip::address> >("address std::hash", keys);
+
+  return 0;
+}
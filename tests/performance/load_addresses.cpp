@@ -0,0 +1,86 @@
+//
+// load_addresses.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures load_addresses on a generated file of 4M mixed IPv4 and IPv6
+// addresses with 1, 2, 4, ... threads up to the number of hardware threads.
+// Each is reported in millions of addresses per second and as a speedup.
+
+#include "std/net/ip/load_addresses.hpp"
+#include "benchmark.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t line_count = 1 << 22;
+  const std::size_t rounds = 4;
+  const char* path = "load_addresses.tmp";
+
+  std::mt19937 rng(42);
+  std::string text;
+  for (std::size_t i = 0; i < line_count; ++i)
+  {
+    char buffer[64];
+    if (i % 4 == 0)
+      std::snprintf(buffer, sizeof(buffer), "2001:db8:%x::%x:%x\n",
+          static_cast<unsigned>(rng() & 0xFFFF),
+          static_cast<unsigned>(rng() & 0xFFFF),
+          static_cast<unsigned>(rng() & 0xFFFF));
+    else
+      std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u\n",
+          static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256));
+    text += buffer;
+  }
+
+  std::FILE* f = std::fopen(path, "wb");
+  if (!f)
+    return 1;
+  std::fwrite(text.data(), 1, text.size(), f);
+  std::fclose(f);
+
+  std::size_t max_threads = std::thread::hardware_concurrency();
+  if (max_threads == 0)
+    max_threads = 1;
+
+  double base = 0;
+  for (std::size_t threads = 1; ; threads *= 2)
+  {
+    if (threads > max_threads)
+      threads = max_threads;
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "load_addresses, %u threads",
+        static_cast<unsigned>(threads));
+    std::size_t loaded = 0;
+    double per_op = benchmark_run(name, rounds,
+        [&](std::size_t)
+        {
+          ip::load_addresses_result<ip::address> result =
+            ip::load_addresses(path, threads);
+          loaded += result.addresses.size();
+        });
+    if (base == 0)
+      base = per_op;
+    std::printf("%-40s %10.1f M/s %6.2fx\n", name,
+        1e3 * line_count / per_op, base / per_op);
+    benchmark_sink(loaded);
+
+    if (threads == max_threads)
+      break;
+  }
+
+  std::remove(path);
+  return 0;
+}
@@ -0,0 +1,74 @@
+//
+// lpm_v4.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures prefix_table_v4 lookups, one at a time and batched, on a table of
+// 900k prefixes with a length distribution similar to a full BGP table.
+
+#include "std/net/ip/prefix_table_v4.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t prefix_count = 900000;
+  const std::size_t lookup_count = 1 << 24;
+  const std::size_t batch_size = 1024;
+
+  // Roughly 60% of prefixes are /24, 30% are /16 to /23, 5% are /8 to /15 and
+  // 5% are longer than /24.
+  std::mt19937 rng(42);
+  std::vector<unsigned long> prefixes;
+  std::vector<unsigned int> lengths;
+  ip::prefix_table_v4 table;
+  while (table.size() < prefix_count)
+  {
+    const unsigned int r = rng() % 100;
+    const unsigned int length = r < 60 ? 24 : r < 90 ? 16 + rng() % 8
+      : r < 95 ? 8 + rng() % 8 : 25 + rng() % 8;
+    const unsigned long prefix = (rng() & (0xFFFFFFFFUL << (32 - length)));
+    table.insert(ip::address_v4(prefix), length, table.size() & 0xFFFF);
+    prefixes.push_back(prefix);
+    lengths.push_back(length);
+  }
+
+  // Destinations fall within the prefixes, with random host bits.
+  std::vector<ip::address_v4> addrs(lookup_count);
+  for (std::size_t i = 0; i < lookup_count; ++i)
+  {
+    const std::size_t p = rng() % prefixes.size();
+    const unsigned long host = lengths[p] == 32
+      ? 0 : rng() & (0xFFFFFFFFUL >> lengths[p]);
+    addrs[i] = ip::address_v4(prefixes[p] | host);
+  }
+
+  ip::prefix_table_v4::value_type sum = 0;
+  benchmark_run("lookup", lookup_count,
+      [&](std::size_t i)
+      {
+        sum += table.lookup(addrs[i]);
+      });
+
+  std::vector<ip::prefix_table_v4::value_type> values(lookup_count);
+  double per_op = benchmark_run("lookup, batched", lookup_count / batch_size,
+      [&](std::size_t i)
+      {
+        table.lookup(&addrs[i * batch_size], batch_size,
+            &values[i * batch_size]);
+      });
+  std::printf("%-40s %10.1f M/s\n", "lookup, batched",
+      1e3 * batch_size / per_op);
+
+  benchmark_sink(sum);
+  benchmark_sink(values.back());
+  return 0;
+}
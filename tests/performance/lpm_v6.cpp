@@ -0,0 +1,89 @@
+//
+// lpm_v6.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures prefix_table_v6 lookups, one at a time and batched, on a table of
+// 200k prefixes with a length distribution similar to a full IPv6 BGP table.
+
+#include "std/net/ip/prefix_table_v6.hpp"
+#include "benchmark.hpp"
+#include <random>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t prefix_count = 200000;
+  const std::size_t lookup_count = 1 << 24;
+  const std::size_t batch_size = 1024;
+
+  // Prefixes are within 20k allocations of /32 in 2000::/4. Roughly 10% are
+  // /20 to /32, 50% are /48, 35% are /33 to /47 and 5% are /49 to /64, like
+  // the more-specific routes announced from within an allocation.
+  std::mt19937_64 rng(42);
+  std::vector<unsigned long long> allocations(20000);
+  for (std::size_t i = 0; i < allocations.size(); ++i)
+    allocations[i] = (0x2ULL << 60) | ((rng() >> 4) & (~0ULL << 32));
+  std::vector<unsigned long long> prefixes;
+  std::vector<unsigned int> lengths;
+  ip::prefix_table_v6 table;
+  while (table.size() < prefix_count)
+  {
+    const unsigned int r = rng() % 100;
+    const unsigned int length = r < 10 ? 20 + rng() % 13 : r < 60 ? 48
+      : r < 95 ? 33 + rng() % 15 : 49 + rng() % 16;
+    const unsigned long long prefix = (allocations[rng() % allocations.size()]
+        | (rng() >> 32)) & (~0ULL << (64 - length));
+    ip::compact_address_v6::bytes_type bytes;
+    for (int i = 0; i < 8; ++i)
+      bytes[i] = static_cast<unsigned char>(prefix >> (56 - 8 * i));
+    table.insert(ip::address_v6(bytes), length, table.size() & 0xFFFF);
+    prefixes.push_back(prefix);
+    lengths.push_back(length);
+  }
+
+  // Destinations fall within the prefixes, with random interface identifiers.
+  std::vector<ip::compact_address_v6> addrs(lookup_count);
+  for (std::size_t i = 0; i < lookup_count; ++i)
+  {
+    const std::size_t p = rng() % prefixes.size();
+    const unsigned long long high = lengths[p] == 64
+      ? prefixes[p] : prefixes[p] | (rng() & (~0ULL >> lengths[p]));
+    const unsigned long long low = rng();
+    ip::compact_address_v6::bytes_type bytes;
+    for (int b = 0; b < 8; ++b)
+    {
+      bytes[b] = static_cast<unsigned char>(high >> (56 - 8 * b));
+      bytes[b + 8] = static_cast<unsigned char>(low >> (56 - 8 * b));
+    }
+    addrs[i] = ip::compact_address_v6(bytes);
+  }
+
+  ip::prefix_table_v6::value_type sum = 0;
+  benchmark_run("lookup", lookup_count,
+      [&](std::size_t i)
+      {
+        sum += table.lookup(addrs[i]);
+      });
+
+  std::vector<ip::prefix_table_v6::value_type> values(lookup_count);
+  double per_op = benchmark_run("lookup, batched", lookup_count / batch_size,
+      [&](std::size_t i)
+      {
+        table.lookup(&addrs[i * batch_size], batch_size,
+            &values[i * batch_size]);
+      });
+  std::printf("%-40s %10.1f M/s\n", "lookup, batched",
+      1e3 * batch_size / per_op);
+
+  benchmark_sink(sum);
+  benchmark_sink(values.back());
+  return 0;
+}
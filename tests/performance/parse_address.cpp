@@ -0,0 +1,67 @@
+//
+// parse_address.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares make_address with trying each family in turn, for a corpus that is
+// mostly IPv4.
+
+#include "std/net/ip/address.hpp"
+#include "benchmark.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 24;
+
+  std::mt19937 rng(42);
+  std::vector<std::string> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    char buffer[48];
+    if (rng() % 5 != 0)
+      std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u",
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256));
+    else
+      std::snprintf(buffer, sizeof(buffer), "2001:db8:%x::%x",
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536));
+    corpus.push_back(buffer);
+  }
+
+  benchmark_run("v6 then v4", iterations,
+      [&](std::size_t i)
+      {
+        const char* str = corpus[i & (corpus_size - 1)].c_str();
+        std::error_code ec;
+        ip::address a = ip::make_address_v6(str, ec);
+        if (ec)
+          a = ip::make_address_v4(str, ec);
+        benchmark_sink(a);
+      });
+
+  benchmark_run("make_address", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        ip::address a = ip::make_address(
+            corpus[i & (corpus_size - 1)].c_str(), ec);
+        benchmark_sink(a);
+      });
+
+  return 0;
+}
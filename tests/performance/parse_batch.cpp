@@ -0,0 +1,112 @@
+//
+// parse_batch.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares parsing a feed of IPv4 addresses one make_address_v4 call at a time
+// with parse_addresses, given both an array of strings and a delimited buffer.
+// Each is reported in millions of addresses per second.
+
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/ip/parse_addresses.hpp"
+#include "benchmark.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t line_count = 1 << 20;
+  const std::size_t batch_size = 1024;
+  const std::size_t rounds = 16;
+
+  std::mt19937 rng(42);
+  std::vector<std::string> lines;
+  std::string feed;
+  for (std::size_t i = 0; i < line_count; ++i)
+  {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u",
+        static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256),
+        static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256));
+    lines.push_back(buffer);
+    feed += buffer;
+    feed += '\n';
+  }
+
+  std::vector<ip::address_v4> addrs(line_count);
+  std::vector<std::uint64_t> status(line_count / 64);
+
+  double per_op = benchmark_run("make_address_v4, NUL-terminated",
+      line_count * rounds,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        const std::size_t j = i & (line_count - 1);
+        addrs[j] = ip::make_address_v4(lines[j].c_str(), ec);
+      });
+  std::printf("%-40s %10.1f M/s\n", "make_address_v4, NUL-terminated",
+      1e3 / per_op);
+
+  per_op = benchmark_run("make_address_v4, with length",
+      line_count * rounds,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        const std::size_t j = i & (line_count - 1);
+        addrs[j] = ip::make_address_v4(lines[j].data(), lines[j].size(), ec);
+      });
+  std::printf("%-40s %10.1f M/s\n", "make_address_v4, with length",
+      1e3 / per_op);
+
+  per_op = benchmark_run("make_address_v4, split with memchr", rounds,
+      [&](std::size_t)
+      {
+        const char* p = feed.data();
+        const char* last = feed.data() + feed.size();
+        for (std::size_t j = 0; p != last; ++j)
+        {
+          const char* end = static_cast<const char*>(
+              std::memchr(p, '\n', static_cast<std::size_t>(last - p)));
+          std::error_code ec;
+          addrs[j] = ip::make_address_v4(p,
+              static_cast<std::size_t>(end - p), ec);
+          p = end + 1;
+        }
+      });
+  std::printf("%-40s %10.1f M/s\n", "make_address_v4, split with memchr",
+      1e3 * line_count / per_op);
+
+  per_op = benchmark_run("parse_addresses, strings",
+      line_count / batch_size * rounds,
+      [&](std::size_t i)
+      {
+        const std::size_t j = (i * batch_size) & (line_count - 1);
+        ip::parse_addresses(&lines[j], batch_size, &addrs[j], &status[j / 64]);
+      });
+  std::printf("%-40s %10.1f M/s\n", "parse_addresses, strings",
+      1e3 * batch_size / per_op);
+
+  per_op = benchmark_run("parse_addresses, buffer", rounds,
+      [&](std::size_t)
+      {
+        ip::parse_addresses(feed.data(), feed.data() + feed.size(), '\n',
+            &addrs[0], line_count, &status[0]);
+      });
+  std::printf("%-40s %10.1f M/s\n", "parse_addresses, buffer",
+      1e3 * line_count / per_op);
+
+  benchmark_sink(addrs.back());
+  benchmark_sink(status.back());
+  return 0;
+}
@@ -0,0 +1,60 @@
+//
+// parse_v4.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares make_address_v4 with the inet_pton based parser it replaced.
+
+#include "std/net/ip/address_v4.hpp"
+#include "std/net/detail/socket_ops.hpp"
+#include "benchmark.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+namespace socket_ops = std::experimental::net::detail::socket_ops;
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 24;
+
+  std::mt19937 rng(42);
+  std::vector<std::string> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u",
+        static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256),
+        static_cast<unsigned>(rng() % 256), static_cast<unsigned>(rng() % 256));
+    corpus.push_back(buffer);
+  }
+
+  benchmark_run("inet_pton", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        unsigned char bytes[4];
+        socket_ops::inet_pton(AF_INET,
+            corpus[i & (corpus_size - 1)].c_str(), bytes, 0, ec);
+        benchmark_sink(bytes);
+      });
+
+  benchmark_run("make_address_v4", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        ip::address_v4 a = ip::make_address_v4(
+            corpus[i & (corpus_size - 1)].c_str(), ec);
+        benchmark_sink(a);
+      });
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+//
+// parse_v6.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares make_address_v6 with the inet_pton based parser it replaced.
+
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/detail/socket_ops.hpp"
+#include "benchmark.hpp"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+namespace socket_ops = std::experimental::net::detail::socket_ops;
+
+int main()
+{
+  const std::size_t corpus_size = 1 << 10;
+  const std::size_t iterations = 1 << 24;
+
+  std::mt19937 rng(42);
+  std::vector<std::string> corpus;
+  for (std::size_t i = 0; i < corpus_size; ++i)
+  {
+    // A mix of full, compressed and IPv4-mapped addresses.
+    char buffer[48];
+    switch (i % 3)
+    {
+    case 0:
+      std::snprintf(buffer, sizeof(buffer), "%x:%x:%x:%x:%x:%x:%x:%x",
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536));
+      break;
+    case 1:
+      std::snprintf(buffer, sizeof(buffer), "2001:db8:%x::%x",
+          static_cast<unsigned>(rng() % 65536),
+          static_cast<unsigned>(rng() % 65536));
+      break;
+    default:
+      std::snprintf(buffer, sizeof(buffer), "::ffff:%u.%u.%u.%u",
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256),
+          static_cast<unsigned>(rng() % 256));
+      break;
+    }
+    corpus.push_back(buffer);
+  }
+
+  benchmark_run("inet_pton", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        unsigned char bytes[16];
+        unsigned long scope_id = 0;
+        socket_ops::inet_pton(AF_INET6,
+            corpus[i & (corpus_size - 1)].c_str(), bytes, &scope_id, ec);
+        benchmark_sink(bytes);
+      });
+
+  benchmark_run("make_address_v6", iterations,
+      [&](std::size_t i)
+      {
+        std::error_code ec;
+        ip::address_v6 a = ip::make_address_v6(
+            corpus[i & (corpus_size - 1)].c_str(), ec);
+        benchmark_sink(a);
+      });
+
+  return 0;
+}
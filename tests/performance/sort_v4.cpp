@@ -0,0 +1,60 @@
+//
+// sort_v4.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Sorts 10M IPv4 addresses using operator<, and using a comparison of the
+// network-order bytes as the address previously stored them.
+
+#include "std/net/ip/address_v4.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t count = 10000000;
+
+  std::mt19937 rng(42);
+  std::vector<ip::address_v4> corpus;
+  corpus.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    corpus.push_back(ip::address_v4(rng()));
+
+  std::vector<ip::address_v4::bytes_type> b;
+  b.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+    b.push_back(corpus[i].to_bytes());
+  benchmark_run("std::sort, byte-wise compare", 1,
+      [&](std::size_t)
+      {
+        std::sort(b.begin(), b.end());
+      });
+
+  std::vector<ip::address_v4> v(corpus);
+  benchmark_run("std::sort, operator<", 1,
+      [&](std::size_t)
+      {
+        std::sort(v.begin(), v.end());
+      });
+
+  std::size_t multicast = 0;
+  benchmark_run("is_multicast", count,
+      [&](std::size_t i)
+      {
+        multicast += corpus[i].is_multicast();
+      });
+
+  benchmark_sink(v.front());
+  benchmark_sink(b.front());
+  benchmark_sink(multicast);
+  return 0;
+}
@@ -0,0 +1,82 @@
+//
+// sort_v6.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Sorts 10M IPv6 addresses using operator<, and using the byte-wise
+// comparison that operator< previously made. The same addresses are also
+// sorted as compact_address_v6, which moves 16 bytes per element rather
+// than 24.
+
+#include "std/net/ip/address_v6.hpp"
+#include "std/net/ip/compact_address_v6.hpp"
+#include "benchmark.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ip = std::experimental::net::ip;
+
+struct bytewise_less
+{
+  bool operator()(const ip::address_v6& a1, const ip::address_v6& a2) const
+  {
+    const ip::address_v6::bytes_type b1 = a1.to_bytes();
+    const ip::address_v6::bytes_type b2 = a2.to_bytes();
+    if (b1 < b2)
+      return true;
+    if (b1 > b2)
+      return false;
+    return a1.scope_id() < a2.scope_id();
+  }
+};
+
+int main()
+{
+  const std::size_t count = 10000000;
+
+  // Addresses from a handful of /48 prefixes with random interface IDs, so
+  // that comparisons look past the first few bytes.
+  std::mt19937_64 rng(42);
+  std::vector<ip::address_v6> corpus;
+  corpus.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    ip::address_v6::bytes_type bytes(0x20, 0x01, 0x0d, 0xb8);
+    bytes[5] = static_cast<unsigned char>(rng() % 4);
+    unsigned long long id = rng();
+    for (std::size_t j = 8; j < 16; ++j, id >>= 8)
+      bytes[j] = static_cast<unsigned char>(id);
+    corpus.push_back(ip::address_v6(bytes));
+  }
+
+  std::vector<ip::address_v6> v(corpus);
+  benchmark_run("std::sort, byte-wise compare", 1,
+      [&](std::size_t)
+      {
+        std::sort(v.begin(), v.end(), bytewise_less());
+      });
+
+  v = corpus;
+  benchmark_run("std::sort, operator<", 1,
+      [&](std::size_t)
+      {
+        std::sort(v.begin(), v.end());
+      });
+
+  std::vector<ip::compact_address_v6> c(corpus.begin(), corpus.end());
+  benchmark_run("std::sort, compact_address_v6", 1,
+      [&](std::size_t)
+      {
+        std::sort(c.begin(), c.end());
+      });
+
+  benchmark_sink(v.front());
+  benchmark_sink(c.front());
+  return 0;
+}
@@ -0,0 +1,70 @@
+//
+// zone_id.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compares conversion of link-local addresses whose zone ID names an interface
+// with the if_nametoindex and if_indextoname calls that conversion previously
+// made every time.
+
+#include "std/net/ip/address_v6.hpp"
+#include "benchmark.hpp"
+#include <cstdio>
+#include <net/if.h>
+#include <string>
+
+namespace ip = std::experimental::net::ip;
+
+int main()
+{
+  const std::size_t iterations = 1 << 20;
+
+  struct if_nameindex* interfaces = if_nameindex();
+  if (interfaces == 0 || interfaces[0].if_index == 0)
+  {
+    std::printf("no interfaces\n");
+    return 0;
+  }
+
+  const std::string name = interfaces[0].if_name;
+  const unsigned index = interfaces[0].if_index;
+  const std::string text = "fe80::1%" + name;
+  const ip::address_v6 addr = ip::make_address_v6(text);
+  if_freenameindex(interfaces);
+
+  benchmark_run("if_nametoindex", iterations,
+      [&](std::size_t)
+      {
+        benchmark_sink(if_nametoindex(name.c_str()));
+      });
+
+  benchmark_run("make_address_v6", iterations,
+      [&](std::size_t)
+      {
+        benchmark_sink(ip::make_address_v6(text));
+      });
+
+  benchmark_run("if_indextoname", iterations,
+      [&](std::size_t)
+      {
+        char buffer[IF_NAMESIZE];
+        benchmark_sink(if_indextoname(index, buffer));
+      });
+
+  benchmark_run("to_chars", iterations,
+      [&](std::size_t)
+      {
+        char buffer[80];
+        ip::to_chars_result r =
+          ip::to_chars(buffer, buffer + sizeof(buffer), addr);
+        benchmark_sink(buffer);
+        benchmark_sink(r);
+      });
+
+  return 0;
+}